@@ -59,6 +59,10 @@
         #undef LV_MEM_POOL_ALLOC
     #endif
 
+    /*Reserve this many bytes of `LV_MEM_SIZE` for slabs serving the small (<= 128 bytes) allocations.
+     *It makes creating and deleting objects faster and causes less fragmentation. 0: disable*/
+    #define LV_MEM_SLAB_SIZE 0
+
 #else       /*LV_MEM_CUSTOM*/
     #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
     #define LV_MEM_CUSTOM_ALLOC   malloc
@@ -70,6 +74,10 @@
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
 
+/*Shrink the arena of the intermediate buffers if this many refreshes in a row needed less of it
+ *(e.g. after closing a screen with large shadows). 0: never shrink*/
+#define LV_MEM_BUF_SHRINK_FRAMES 60
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
@@ -98,6 +106,11 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Operating system to create threads and locks with. Needed for background work, e.g. `LV_IMG_DECODE_ASYNC_MIN_PX`.
+ *With an OS `lv_mem_alloc()` & co. are protected by a mutex. Call the other LVGL functions from one thread.
+ *LV_OS_NONE, LV_OS_PTHREAD, LV_OS_FREERTOS*/
+#define LV_USE_OS LV_OS_NONE
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -139,6 +152,19 @@
 #define LV_LAYER_SIMPLE_BUF_SIZE          (24 * 1024)
 #define LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3 * 1024)
 
+/*The layer buffers are kept and reused by the next layers and refreshes instead of allocating them for every widget.
+ *LV_LAYER_POOL_CNT: the number of kept buffers. Nested layers need one each. 0: don't keep the buffers
+ *LV_LAYER_POOL_SIZE: [bytes] the most memory the kept buffers can use together.
+ *                    0: the size of the display's draw buffer in ARGB format
+ *Larger layers get a buffer allocated only for them.*/
+#define LV_LAYER_POOL_CNT  0
+#define LV_LAYER_POOL_SIZE 0
+
+/*Objects with LV_OBJ_FLAG_RETAIN_LAYER are rendered with their children into an image once and
+ *only the image is drawn until something changes on them.
+ *LV_OBJ_RETAIN_CACHE_SIZE: [bytes] the most memory the images can use together. 0: ignore the flag*/
+#define LV_OBJ_RETAIN_CACHE_SIZE 0
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -146,6 +172,16 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Limit the decoded bytes kept in the image cache. The least recently used images are closed above it.
+ *Images drawn in the current refresh are kept even above the limit.
+ *0: no limit, only the number of entries is limited*/
+#define LV_IMG_CACHE_MAX_BYTES 0
+
+/*Decode the images with at least this many pixels in a background thread. It needs `LV_USE_OS` and the image cache.
+ *A placeholder is drawn with the `img_placeholder_color/opa` style properties until the image is decoded.
+ *0: decode all images while drawing them*/
+#define LV_IMG_DECODE_ASYNC_MIN_PX 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -168,6 +204,12 @@
     #define LV_DITHER_ERROR_DIFFUSION 0
 #endif
 
+/*Dither the semi-transparent pixels (anti-aliased edges, shadows, opacity) with LV_COLOR_DEPTH 16.
+ *They are mixed with 8 bit per channel precision and rounded to RGB565 with an ordered 8x8 pattern
+ *instead of the 33 opacity levels of `lv_color_mix()`. Removes the banding of soft shadows and fades
+ *at a small CPU cost on the semi-transparent pixels only. No extra memory is used.*/
+#define LV_DITHER_BLEND 0
+
 /*Maximum buffer size to allocate for rotation.
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
@@ -193,6 +235,16 @@
     #define LV_GPU_SWM341_DMA2D_INCLUDE "SWM341.h"
 #endif
 
+/*Use the GDMA of ESP32-S3 (and other ESP chips with GDMA) to make large fills and image copies in the background.
+ *Without ESP-IDF a stand-in engine makes the copies with the CPU to test the drawing on a PC*/
+#define LV_USE_GPU_ESP_GDMA 0
+#if LV_USE_GPU_ESP_GDMA
+    /*Fill and copy only the areas with at least this many pixels in the background*/
+    #define LV_GPU_ESP_GDMA_MIN_SIZE 2048
+    /*Number of memory copies which can wait in the queue of the GDMA*/
+    #define LV_GPU_ESP_GDMA_QUEUE_LEN 16
+#endif
+
 /*Use NXP's PXP GPU iMX RTxxx platforms*/
 #define LV_USE_GPU_NXP_PXP 0
 #if LV_USE_GPU_NXP_PXP
@@ -298,6 +350,11 @@
 
 #define LV_USE_USER_DATA 1
 
+/*Number of resolved style properties to cache.
+ *Without the cache every style property read walks all the styles of the object.
+ *About 24 bytes per entry. Should be a power of 2. 0: to disable caching*/
+#define LV_STYLE_CACHE_SIZE 0
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #define LV_ENABLE_GC 0
@@ -400,6 +457,11 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of decompressed glyphs in bytes. It's shared by all compressed fonts.
+     *0: decompress the glyphs every time they are drawn*/
+    #define LV_FONT_COMPR_CACHE_DEF_SIZE (16 * 1024)
+#endif
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -483,6 +545,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 1     /*Cache the line breaks of the text to speed up redrawing (8 bytes per line)*/
 #endif
 
 #define LV_USE_LINE       1
@@ -600,6 +663,15 @@
 
 /*File system interfaces for common APIs */
 
+/*Size of a block cache shared by the files of the drivers which have a `cache_size` [bytes].
+ *It replaces the single cache window of these drivers. The files are cached in LV_FS_BLOCK_SIZE blocks per path,
+ *so the blocks are kept when seeking in the file or opening it again. 0: disable*/
+#define LV_FS_BLOCK_CACHE_SIZE 0
+#if LV_FS_BLOCK_CACHE_SIZE
+    #define LV_FS_BLOCK_SIZE 512        /*[bytes]*/
+    #define LV_FS_READ_AHEAD 4          /*Load this many blocks with one read when a file is read sequentially*/
+#endif
+
 /*API for fopen, fread, etc*/
 #define LV_USE_FS_STDIO 0
 #if LV_USE_FS_STDIO
@@ -614,6 +686,7 @@
     #define LV_FS_POSIX_LETTER '\0'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
     #define LV_FS_POSIX_PATH ""         /*Set the working directory. File/directory paths will be appended to it.*/
     #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
+    #define LV_FS_POSIX_MMAP 0          /*1: map the files opened for reading into the memory (not on Windows)*/
 #endif
 
 /*API for CreateFile, ReadFile, etc*/
@@ -633,6 +706,12 @@
 
 /*PNG decoder library*/
 #define LV_USE_PNG 0
+#if LV_USE_PNG
+    /*Decode the PNG images having at least this many pixels line by line while they are drawn.
+     *It needs about 34 kB + 2 lines of RAM instead of the whole image, but the image is decoded again in every refresh.
+     *Interlaced images are always decoded at once. 0: disable*/
+    #define LV_PNG_STREAM_MIN_PX 0
+#endif
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -640,6 +719,14 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_SJPG 0
+#if LV_USE_SJPG
+    /*Keep this many bytes of decoded frames (horizontal strips) per image to not decode them again when redrawn.
+     *The least recently used frame is replaced. At least one frame is always kept.*/
+    #define LV_SJPG_CACHE_SIZE 0
+    /*Decode the next frame in a background thread while drawing or scrolling the image.
+     *Needs `LV_USE_OS`, a thread safe file system driver and room for at least 2 frames in `LV_SJPG_CACHE_SIZE`*/
+    #define LV_SJPG_PREFETCH 0
+#endif
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
@@ -694,6 +781,9 @@
 /*1: Support using images as font in label or span widgets */
 #define LV_USE_IMGFONT 0
 
+/*1: Support pre-rendering a fixed set of glyphs (e.g. the digits of a clock) into an atlas font*/
+#define LV_USE_TXT_ATLAS 0
+
 /*1: Enable a published subscriber based messaging system */
 #define LV_USE_MSG 0
 
@@ -32,6 +32,11 @@ fout.write(
 
 #include <stdint.h>
 
+/*Possible values of LV_USE_OS. Defined here to be usable in lv_conf.h and in the `#if`s everywhere.*/
+#define LV_OS_NONE      0
+#define LV_OS_PTHREAD   1
+#define LV_OS_FREERTOS  2
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -19,6 +19,7 @@
 #include "../misc/lv_async.h"
 #include "../misc/lv_fs.h"
 #include "../misc/lv_gc.h"
+#include "../font/lv_font_fmt_txt.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
 #include "../hal/lv_hal.h"
@@ -134,6 +135,9 @@ void lv_init(void)
 
     /*Initialize the screen refresh system*/
     _lv_refr_init();
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    _lv_obj_retain_init();
+#endif
 
     _lv_img_decoder_init();
 #if LV_IMG_CACHE_DEF_SIZE
@@ -187,6 +191,10 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+    _lv_img_cache_deinit();
+    _lv_font_deinit_fmt_txt();
+    _lv_obj_style_deinit();
+    _lv_timer_core_deinit();
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -258,6 +266,10 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    if(f & LV_OBJ_FLAG_RETAIN_LAYER) _lv_obj_retain_remove(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -434,10 +446,15 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     _lv_event_mark_deleted(obj);
 
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RETAIN_LAYER)) _lv_obj_retain_remove(obj);
+#endif
+
     /*Remove all style*/
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+    _lv_obj_style_cache_drop(obj);
 
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
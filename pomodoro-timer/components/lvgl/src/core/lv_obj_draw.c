@@ -250,6 +250,13 @@ void lv_obj_init_draw_img_dsc(lv_obj_t * obj, uint32_t part, lv_draw_img_dsc_t *
     if(draw_dsc->recolor_opa > 0) {
         draw_dsc->recolor = lv_obj_get_style_img_recolor_filtered(obj, part);
     }
+
+#if _LV_IMG_DECODE_ASYNC
+    draw_dsc->placeholder_opa = lv_obj_get_style_img_placeholder_opa(obj, part);
+    if(draw_dsc->placeholder_opa > 0) {
+        draw_dsc->placeholder_color = lv_obj_get_style_img_placeholder_color(obj, part);
+    }
+#endif
 #if LV_DRAW_COMPLEX
     if(part != LV_PART_MAIN) draw_dsc->blend_mode = lv_obj_get_style_blend_mode(obj, part);
 #endif
@@ -838,6 +838,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    /*The cached images of the object and its parents are outdated even if the area is not visible now*/
+    _lv_obj_retain_invalidate(obj);
+#endif
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -0,0 +1,308 @@
+/**
+ * @file lv_obj_retain.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_retain.h"
+#if LV_OBJ_RETAIN_CACHE_SIZE
+
+#include "lv_obj.h"
+#include "lv_disp.h"
+#include "lv_refr.h"
+#include "../misc/lv_gc.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const lv_obj_t * obj;
+    uint8_t * buf;
+    uint32_t buf_size;
+    uint32_t last_used;     /**< Value of `stamp` when the image was drawn last time*/
+    lv_area_t area;         /**< Coordinates of the object with its extra draw size when it was rendered*/
+    lv_img_cf_t cf;
+    uint8_t valid : 1;
+    uint8_t rendering : 1;  /**< Being rendered now so it can't be freed by a retained child*/
+} retain_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static retain_entry_t * find_entry(const lv_obj_t * obj);
+static void free_entry(retain_entry_t * entry);
+static bool make_room(uint32_t size, const retain_entry_t * keep);
+static void render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, retain_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t cache_size;
+static uint32_t used_size;
+static uint32_t stamp;
+static lv_obj_retain_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_obj_retain_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_obj_retain_ll), sizeof(retain_entry_t));
+    cache_size = LV_OBJ_RETAIN_CACHE_SIZE;
+    used_size = 0;
+    stamp = 0;
+    lv_memset_00(&stats, sizeof(stats));
+}
+
+bool _lv_obj_retain_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*The children can be drawn out of the cached area*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, &area)) return true;
+
+    retain_entry_t * entry = find_entry(obj);
+    if(entry && entry->valid && _lv_area_is_equal(&entry->area, &area)) {
+        stats.hit_cnt++;
+    }
+    else {
+        /*If the object covers its area an image without alpha channel is enough*/
+        lv_img_cf_t cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        if(ext_draw_size == 0) {
+            lv_cover_check_info_t info;
+            info.res = LV_COVER_RES_COVER;
+            info.area = &area;
+            lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+            if(info.res == LV_COVER_RES_COVER) cf = LV_IMG_CF_TRUE_COLOR;
+        }
+
+        uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR ? sizeof(lv_color_t) : LV_IMG_PX_SIZE_ALPHA_BYTE;
+        uint32_t size = lv_area_get_size(&area) * px_size;
+        if(size > cache_size) {
+            if(entry) free_entry(entry);
+            return false;
+        }
+
+        if(entry == NULL) {
+            entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_retain_ll));
+            LV_ASSERT_MALLOC(entry);
+            if(entry == NULL) return false;
+            lv_memset_00(entry, sizeof(retain_entry_t));
+            entry->obj = obj;
+        }
+
+        if(entry->buf_size != size) {
+            /*Free the old buffer first to let its memory be used for the new one*/
+            lv_mem_free(entry->buf);
+            used_size -= entry->buf_size;
+            entry->buf = NULL;
+            entry->buf_size = 0;
+
+            if(!make_room(size, entry)) {
+                free_entry(entry);
+                return false;
+            }
+
+            entry->buf = lv_mem_alloc(size);
+            if(entry->buf == NULL) {
+                LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes to retain the object", size);
+                free_entry(entry);
+                return false;
+            }
+            entry->buf_size = size;
+            used_size += size;
+        }
+
+        entry->area = area;
+        entry->cf = cf;
+        entry->rendering = 1;
+        render(draw_ctx, obj, entry);
+        entry->rendering = 0;
+        entry->valid = 1;
+        stats.render_cnt++;
+    }
+
+    stamp++;
+    entry->last_used = stamp;
+
+    lv_img_dsc_t img;
+    lv_memset_00(&img, sizeof(img));
+    img.data = entry->buf;
+    img.data_size = entry->buf_size;
+    img.header.w = lv_area_get_width(&area);
+    img.header.h = lv_area_get_height(&area);
+    img.header.cf = entry->cf;
+
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    lv_draw_img(draw_ctx, &draw_dsc, &area, &img);
+    lv_draw_wait_for_finish(draw_ctx);
+    lv_img_cache_invalidate_src(&img);
+
+    return true;
+}
+
+void _lv_obj_retain_invalidate(const lv_obj_t * obj)
+{
+    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_obj_retain_ll))) return;
+
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RETAIN_LAYER)) {
+            retain_entry_t * entry = find_entry(obj);
+            if(entry && entry->valid) {
+                entry->valid = 0;
+                stats.inv_cnt++;
+            }
+        }
+        obj = obj->parent;
+    }
+}
+
+void _lv_obj_retain_remove(const lv_obj_t * obj)
+{
+    retain_entry_t * entry = find_entry(obj);
+    if(entry) free_entry(entry);
+}
+
+void lv_obj_retain_set_cache_size(uint32_t size)
+{
+    cache_size = size;
+    make_room(0, NULL);
+}
+
+void lv_obj_retain_invalidate_all(void)
+{
+    retain_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_obj_retain_ll), entry) {
+        entry->valid = 0;
+    }
+}
+
+void lv_obj_retain_get_stats(lv_obj_retain_stats_t * stats_p)
+{
+    *stats_p = stats;
+    stats_p->size = cache_size;
+    stats_p->used = used_size;
+    stats_p->entry_cnt = _lv_ll_get_len(&LV_GC_ROOT(_lv_obj_retain_ll));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static retain_entry_t * find_entry(const lv_obj_t * obj)
+{
+    retain_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_obj_retain_ll), entry) {
+        if(entry->obj == obj) return entry;
+    }
+    return NULL;
+}
+
+static void free_entry(retain_entry_t * entry)
+{
+    used_size -= entry->buf_size;
+    lv_mem_free(entry->buf);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_obj_retain_ll), entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Free the least recently drawn images until `size` bytes fit into the cache
+ * @param size      the needed size in bytes
+ * @param keep      don't free this entry
+ * @return          true: there is enough room
+ */
+static bool make_room(uint32_t size, const retain_entry_t * keep)
+{
+    if(size > cache_size) return false;
+
+    while(used_size + size > cache_size) {
+        retain_entry_t * lru = NULL;
+        retain_entry_t * entry;
+        _LV_LL_READ(&LV_GC_ROOT(_lv_obj_retain_ll), entry) {
+            if(entry == keep || entry->buf == NULL || entry->rendering) continue;
+            if(lru == NULL || entry->last_used < lru->last_used) lru = entry;
+        }
+        if(lru == NULL) return false;
+
+        free_entry(lru);
+        stats.evict_cnt++;
+    }
+
+    return true;
+}
+
+/**
+ * Render an object with its children into the buffer of its entry like `lv_snapshot` does
+ */
+static void render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, retain_entry_t * entry)
+{
+    if(entry->cf == LV_IMG_CF_TRUE_COLOR_ALPHA) lv_memset_00(entry->buf, entry->buf_size);
+
+    /*Use a display with the buffer of the entry*/
+    lv_disp_t * disp_ori = _lv_refr_get_disp_refreshing();
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = disp_ori->driver->hor_res;
+    driver.ver_res = disp_ori->driver->ver_res;
+    driver.antialiasing = disp_ori->driver->antialiasing;
+    driver.draw_ctx = draw_ctx;
+    if(entry->cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+#if LV_COLOR_SCREEN_TRANSP
+        driver.screen_transp = 1;
+#else
+        lv_disp_drv_use_generic_set_px_cb(&driver, LV_IMG_CF_TRUE_COLOR_ALPHA);
+#endif
+    }
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    /*The masks of the parents are applied when the image is drawn*/
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_saved_arr_t masks;
+    _lv_draw_mask_save_all(masks);
+#endif
+
+    void * buf_ori = draw_ctx->buf;
+    lv_area_t * buf_area_ori = draw_ctx->buf_area;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->buf = entry->buf;
+    draw_ctx->buf_area = &entry->area;
+    draw_ctx->clip_area = &entry->area;
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    lv_obj_redraw(draw_ctx, obj);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    _lv_refr_set_disp_refreshing(disp_ori);
+    draw_ctx->buf = buf_ori;
+    draw_ctx->buf_area = buf_area_ori;
+    draw_ctx->clip_area = clip_area_ori;
+
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_restore_all(masks);
+#endif
+}
+
+#endif /*LV_OBJ_RETAIN_CACHE_SIZE*/
@@ -0,0 +1,103 @@
+/**
+ * @file lv_obj_retain.h
+ *
+ */
+
+#ifndef LV_OBJ_RETAIN_H
+#define LV_OBJ_RETAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../draw/lv_draw.h"
+
+#if LV_OBJ_RETAIN_CACHE_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+/**
+ * Information about the cached images of the objects with `LV_OBJ_FLAG_RETAIN_LAYER`
+ */
+typedef struct {
+    uint32_t size;          /**< The most memory the cached images can use*/
+    uint32_t used;          /**< Memory used by the cached images now*/
+    uint32_t entry_cnt;     /**< Number of cached objects*/
+    uint32_t hit_cnt;       /**< Number of times a cached image was drawn without rendering the object*/
+    uint32_t render_cnt;    /**< Number of times an object was rendered into its cached image*/
+    uint32_t inv_cnt;       /**< Number of times a cached image was dropped because the object changed*/
+    uint32_t evict_cnt;     /**< Number of times a cached image was freed to make room for an other one*/
+} lv_obj_retain_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the cache of the retained objects
+ */
+void _lv_obj_retain_init(void);
+
+/**
+ * Draw an object with `LV_OBJ_FLAG_RETAIN_LAYER` from its cached image.
+ * Render the object with its children into the cache first if it's not cached yet or changed since then.
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object
+ * @return          true: the object was drawn; false: it can't be cached, draw it as usual
+ */
+bool _lv_obj_retain_draw(lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+/**
+ * Drop the cached image of the object and its retained parents because something changed on it.
+ * The buffers are kept to render the objects again.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_retain_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Free the cached image of an object. Called when the object is deleted or the flag is removed.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_retain_remove(const struct _lv_obj_t * obj);
+
+/**
+ * Set the most memory the cached images of the retained objects can use.
+ * The least recently drawn images are freed if they don't fit.
+ * @param size      the size in bytes
+ */
+void lv_obj_retain_set_cache_size(uint32_t size);
+
+/**
+ * Drop all the cached images. E.g. if something was changed that the objects can't detect.
+ */
+void lv_obj_retain_invalidate_all(void);
+
+/**
+ * Give information about the cached images
+ * @param stats     the result will be stored here
+ */
+void lv_obj_retain_get_stats(lv_obj_retain_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_OBJ_RETAIN_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_RETAIN_H*/
@@ -35,6 +35,16 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_STYLE_CACHE_SIZE
+typedef struct {
+    const lv_obj_t * obj;           /*NULL if the entry is empty*/
+    lv_style_selector_t selector;   /*Part and state of the object*/
+    lv_style_prop_t prop;
+    lv_style_res_t res;
+    lv_style_value_t value;
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +55,8 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop,
+                                      lv_style_value_t * v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -54,11 +66,18 @@ static void trans_anim_ready_cb(lv_anim_t * a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
+#if LV_STYLE_CACHE_SIZE
+    static void cache_drop_style(const lv_style_t * style);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_STYLE_CACHE_SIZE
+    static style_cache_entry_t style_cache[LV_STYLE_CACHE_SIZE];
+    static lv_obj_style_cache_stats_t style_cache_stats;
+#endif
 
 /**********************
  *      MACROS
@@ -71,6 +90,31 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+#if LV_STYLE_CACHE_SIZE
+    lv_memset_00(style_cache, sizeof(style_cache));
+    _lv_style_set_change_cb(cache_drop_style);
+#endif
+}
+
+void _lv_obj_style_deinit(void)
+{
+#if LV_STYLE_CACHE_SIZE
+    /*The objects are not deleted, so make the styles changed later not look for them*/
+    lv_memset_00(style_cache, sizeof(style_cache));
+    _lv_style_set_change_cb(NULL);
+#endif
+}
+
+void _lv_obj_style_cache_drop(const lv_obj_t * obj)
+{
+#if LV_STYLE_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_STYLE_CACHE_SIZE; i++) {
+        if(style_cache[i].obj == obj) style_cache[i].obj = NULL;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -99,6 +143,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
+    _lv_obj_style_cache_drop(obj);
 
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
 }
@@ -142,6 +187,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
 
         deleted = true;
+        _lv_obj_style_cache_drop(obj);
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
@@ -226,7 +272,7 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
+        found = get_prop_cached(obj, part, prop, &value_act);
         if(found == LV_STYLE_RES_FOUND) break;
         if(!inheritable) break;
 
@@ -488,6 +534,22 @@ lv_part_t lv_obj_style_get_selector_part(lv_style_selector_t selector)
 }
 
 
+void lv_obj_style_get_cache_stats(lv_obj_style_cache_stats_t * stats)
+{
+#if LV_STYLE_CACHE_SIZE
+    *stats = style_cache_stats;
+#else
+    lv_memset_00(stats, sizeof(lv_obj_style_cache_stats_t));
+#endif
+}
+
+void lv_obj_style_reset_cache_stats(void)
+{
+#if LV_STYLE_CACHE_SIZE
+    lv_memset_00(&style_cache_stats, sizeof(style_cache_stats));
+#endif
+}
+
 lv_text_align_t lv_obj_calculate_style_text_align(const struct _lv_obj_t * obj, lv_part_t part, const char * txt)
 {
     lv_text_align_t align = lv_obj_get_style_text_align(obj, part);
@@ -533,6 +595,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     lv_style_init(obj->styles[i].style);
     obj->styles[i].is_local = 1;
     obj->styles[i].selector = selector;
+    _lv_obj_style_cache_drop(obj);
     return obj->styles[i].style;
 }
 
@@ -565,6 +628,7 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     lv_style_init(obj->styles[0].style);
     obj->styles[0].is_trans = 1;
     obj->styles[0].selector = selector;
+    _lv_obj_style_cache_drop(obj);
     return &obj->styles[0];
 }
 
@@ -636,6 +700,71 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+/**
+ * Get a style property of an object through the style cache.
+ * The entries are keyed by the object, its part and state and the property. They store only what the
+ * object's own styles resolve to, so they are dropped when a style is added to or removed from the object
+ * or a property of one of its styles changes.
+ * @param obj       pointer to an object
+ * @param part      the part of the object
+ * @param prop      the property to get
+ * @param v         store the value here if found
+ * @return          same as `get_prop_core()`
+ */
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop,
+                                      lv_style_value_t * v)
+{
+#if LV_STYLE_CACHE_SIZE
+    /*The transition styles are skipped only temporarily so don't cache this case*/
+    if(obj->skip_trans) return get_prop_core(obj, part, prop, v);
+
+    lv_style_selector_t selector = part | obj->state;
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 3) + prop * 31 + (selector >> 16) * 7 + (selector & 0xFFFF) * 13;
+    h *= 2654435761U;
+    style_cache_entry_t * e = &style_cache[(h ^ (h >> 16)) % LV_STYLE_CACHE_SIZE];
+
+    if(e->obj == obj && e->prop == prop && e->selector == selector) {
+        style_cache_stats.hits++;
+        if(e->res == LV_STYLE_RES_FOUND) *v = e->value;
+        return e->res;
+    }
+
+    style_cache_stats.misses++;
+    lv_style_res_t res = get_prop_core(obj, part, prop, v);
+    e->obj = obj;
+    e->selector = selector;
+    e->prop = prop;
+    e->res = res;
+    if(res == LV_STYLE_RES_FOUND) e->value = *v;
+    return res;
+#else
+    return get_prop_core(obj, part, prop, v);
+#endif
+}
+
+#if LV_STYLE_CACHE_SIZE
+/**
+ * Drop the cached style properties of the objects which use a style. Called when the style changes.
+ * @param style     pointer to the changed style
+ */
+static void cache_drop_style(const lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < LV_STYLE_CACHE_SIZE; i++) {
+        const lv_obj_t * obj = style_cache[i].obj;
+        if(obj == NULL) continue;
+
+        uint32_t j;
+        for(j = 0; j < obj->style_cnt; j++) {
+            if(obj->styles[j].style == style) {
+                style_cache[i].obj = NULL;
+                break;
+            }
+        }
+    }
+}
+#endif
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
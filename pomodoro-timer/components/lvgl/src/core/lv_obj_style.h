@@ -54,6 +54,11 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+typedef struct {
+    uint32_t hits;      /*Style property reads served from the cache*/
+    uint32_t misses;    /*Style property reads which had to walk the styles of the object*/
+} lv_obj_style_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -64,6 +69,17 @@ typedef struct {
  */
 void _lv_obj_style_init(void);
 
+/**
+ * Drop the cached style properties. Called by `lv_deinit()`.
+ */
+void _lv_obj_style_deinit(void);
+
+/**
+ * Drop the cached style properties of an object. Called when its styles change or it's deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_cache_drop(const struct _lv_obj_t * obj);
+
 /**
  * Add a style to an object.
  * @param obj       pointer to an object
@@ -200,6 +216,17 @@ lv_state_t lv_obj_style_get_selector_state(lv_style_selector_t selector);
 
 lv_part_t lv_obj_style_get_selector_part(lv_style_selector_t selector);
 
+/**
+ * Get the statistics of the style property cache. (See `LV_STYLE_CACHE_SIZE`)
+ * @param stats     pointer to a variable to store the statistics
+ */
+void lv_obj_style_get_cache_stats(lv_obj_style_cache_stats_t * stats);
+
+/**
+ * Reset the statistics of the style property cache.
+ */
+void lv_obj_style_reset_cache_stats(void);
+
 #include "lv_obj_style_gen.h"
 
 static inline void lv_obj_set_style_pad_all(struct _lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
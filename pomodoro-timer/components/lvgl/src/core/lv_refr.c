@@ -26,6 +26,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*The software rotation goes through the buffers in tiles of this many pixels in both directions*/
+#define DRAW_BUF_ROT_TILE   8
 
 /**********************
  *      TYPEDEFS
@@ -58,6 +60,7 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+static void obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
@@ -339,7 +342,8 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         }
     }
 
-    lv_mem_buf_free_all();
+    _lv_mem_buf_frame_end();
+    _lv_img_cache_frame_end();
     _lv_font_clean_up_fmt_txt();
 
 #if LV_DRAW_COMPLEX
@@ -735,6 +739,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_cnt(obj);
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    /*Start the drawing from the retained object to draw it from its cached image*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RETAIN_LAYER)) child_cnt = 0;
+#endif
     for(i = child_cnt - 1; i >= 0; i--) {
         lv_obj_t * child = obj->spec_attr->children[i];
         found_p = lv_refr_get_top_obj(area_p, child);
@@ -879,13 +887,21 @@ static void layer_alpha_test(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_l
 }
 
 
+static void obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RETAIN_LAYER) && _lv_obj_retain_draw(draw_ctx, obj)) return;
+#endif
+    lv_obj_redraw(draw_ctx, obj);
+}
+
 void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
-        lv_obj_redraw(draw_ctx, obj);
+        obj_redraw(draw_ctx, obj);
     }
     else {
         lv_opa_t opa = lv_obj_get_style_opa(obj, 0);
@@ -946,7 +962,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
                 layer_alpha_test(obj, draw_ctx, layer_ctx, flags);
             }
 
-            lv_obj_redraw(draw_ctx, obj);
+            obj_redraw(draw_ctx, obj);
 
             draw_dsc.pivot.x = obj->coords.x1 + pivot.x - draw_ctx->buf_area->x1;
             draw_dsc.pivot.y = obj->coords.y1 + pivot.y - draw_ctx->buf_area->y1;
@@ -1008,15 +1024,24 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     lv_coord_t area_w = lv_area_get_width(area);
     lv_coord_t area_h = lv_area_get_height(area);
     uint32_t total = area_w * area_h;
-    /*Swap the beginning and end values*/
-    lv_color_t tmp;
-    uint32_t i = total - 1, j = 0;
-    while(i > j) {
-        tmp = color_p[i];
-        color_p[i] = color_p[j];
-        color_p[j] = tmp;
-        i--;
-        j++;
+    /*Swap the beginning and end values. Reverse whole tiles while they don't meet in the middle.*/
+    lv_color_t * head = color_p;
+    lv_color_t * tail = color_p + total;
+    lv_color_t tmp[DRAW_BUF_ROT_TILE];
+    uint32_t k;
+    while(tail - head >= 2 * DRAW_BUF_ROT_TILE) {
+        tail -= DRAW_BUF_ROT_TILE;
+        for(k = 0; k < DRAW_BUF_ROT_TILE; k++) tmp[k] = head[k];
+        for(k = 0; k < DRAW_BUF_ROT_TILE; k++) head[k] = tail[DRAW_BUF_ROT_TILE - 1 - k];
+        for(k = 0; k < DRAW_BUF_ROT_TILE; k++) tail[DRAW_BUF_ROT_TILE - 1 - k] = tmp[k];
+        head += DRAW_BUF_ROT_TILE;
+    }
+    while(tail - head > 1) {
+        tail--;
+        tmp[0] = *tail;
+        *tail = *head;
+        *head = tmp[0];
+        head++;
     }
     lv_coord_t tmp_coord;
     tmp_coord = area->y2;
@@ -1027,22 +1052,59 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     area->x1 = drv->hor_res - tmp_coord - 1;
 }
 
+/**
+ * Helper function for draw_buf_rotate_90. Copy a tile of `w` x `h` pixels rotated:
+ * pixel (x;y) of `src` goes to `dest[x * dest_x_step + y * dest_y_step]`.
+ */
+static inline void draw_buf_rotate_tile(lv_color_t * dest, int32_t dest_x_step, int32_t dest_y_step,
+                                        const lv_color_t * src, lv_coord_t src_stride, lv_coord_t w, lv_coord_t h)
+{
+    int32_t x;
+    int32_t y;
+    if(w == DRAW_BUF_ROT_TILE && h == DRAW_BUF_ROT_TILE) {
+        /*Constant loop counts to let the compiler unroll and vectorize the full tiles*/
+        for(x = 0; x < DRAW_BUF_ROT_TILE; x++) {
+            lv_color_t * d = dest + x * dest_x_step;
+            for(y = 0; y < DRAW_BUF_ROT_TILE; y++) {
+                d[y * dest_y_step] = src[y * src_stride + x];
+            }
+        }
+    }
+    else {
+        for(y = 0; y < h; y++) {
+            lv_color_t * d = dest + y * dest_y_step;
+            const lv_color_t * s = src + y * src_stride;
+            for(x = 0; x < w; x++) {
+                d[x * dest_x_step] = s[x];
+            }
+        }
+    }
+}
+
+/**
+ * Rotate `area_w` x `area_h` pixels by 90 (or 270 if `invert_i` is set) degrees from `orig_color_p` to `rot_buf`.
+ * The pixels are copied in tiles to read and write only a few rows of the buffers at a time.
+ */
 static LV_ATTRIBUTE_FAST_MEM void draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
                                                      lv_color_t * orig_color_p, lv_color_t * rot_buf)
 {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
+    for(lv_coord_t ty = 0; ty < area_h; ty += DRAW_BUF_ROT_TILE) {
+        lv_coord_t th = LV_MIN(DRAW_BUF_ROT_TILE, area_h - ty);
+        /*The last few rows (or all rows of a small chunk) fit into the cache anyway, copy them row by row*/
+        lv_coord_t tile_w = th == DRAW_BUF_ROT_TILE ? DRAW_BUF_ROT_TILE : area_w;
+        for(lv_coord_t tx = 0; tx < area_w; tx += tile_w) {
+            lv_coord_t tw = LV_MIN(tile_w, area_w - tx);
+            const lv_color_t * src = orig_color_p + ty * area_w + tx;
+            if(invert_i) {
+                /*(x;y) goes to column `area_h - 1 - y` of row `x`*/
+                lv_color_t * dest = rot_buf + tx * area_h + (area_h - 1 - ty);
+                draw_buf_rotate_tile(dest, area_h, -1, src, area_w, tw, th);
+            }
+            else {
+                /*(x;y) goes to column `y` of row `area_w - 1 - x`*/
+                lv_color_t * dest = rot_buf + (area_w - 1 - tx) * area_h + ty;
+                draw_buf_rotate_tile(dest, -area_h, 1, src, area_w, tw, th);
+            }
         }
     }
 }
@@ -1062,31 +1124,38 @@ static inline void draw_buf_rotate4(lv_color_t * a, lv_color_t * b, lv_color_t *
 
 /**
  * Rotate a square image 90/270 degrees in place.
+ * The top left quarter is processed in tiles so the four pixels of the next rotation are
+ * in the same few rows and columns as the previous ones.
  * @note inspired by https://stackoverflow.com/a/43694906
  */
 static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color_p)
 {
-    for(lv_coord_t i = 0; i < w / 2; i++) {
-        for(lv_coord_t j = 0; j < (w + 1) / 2; j++) {
-            lv_coord_t inv_i = (w - 1) - i;
-            lv_coord_t inv_j = (w - 1) - j;
-            if(is_270) {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[inv_j * w + i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[j * w + inv_i]
-                );
-            }
-            else {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[j * w + inv_i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[inv_j * w + i]
-                );
+    for(lv_coord_t ti = 0; ti < w / 2; ti += DRAW_BUF_ROT_TILE) {
+        lv_coord_t i_end = LV_MIN(ti + DRAW_BUF_ROT_TILE, w / 2);
+        for(lv_coord_t tj = 0; tj < (w + 1) / 2; tj += DRAW_BUF_ROT_TILE) {
+            lv_coord_t j_end = LV_MIN(tj + DRAW_BUF_ROT_TILE, (w + 1) / 2);
+            for(lv_coord_t i = ti; i < i_end; i++) {
+                for(lv_coord_t j = tj; j < j_end; j++) {
+                    lv_coord_t inv_i = (w - 1) - i;
+                    lv_coord_t inv_j = (w - 1) - j;
+                    if(is_270) {
+                        draw_buf_rotate4(
+                            &color_p[i * w + j],
+                            &color_p[inv_j * w + i],
+                            &color_p[inv_i * w + inv_j],
+                            &color_p[j * w + inv_i]
+                        );
+                    }
+                    else {
+                        draw_buf_rotate4(
+                            &color_p[i * w + j],
+                            &color_p[j * w + inv_i],
+                            &color_p[inv_i * w + inv_j],
+                            &color_p[inv_j * w + i]
+                        );
+                    }
+                }
             }
-
         }
     }
 }
@@ -0,0 +1,7 @@
+CSRCS += lv_gpu_esp_gdma.c
+CSRCS += lv_gpu_esp_gdma_dev.c
+
+DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp
+
+CFLAGS += "-I$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp"
@@ -0,0 +1,451 @@
+/**
+ * @file lv_gpu_esp_gdma.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_gpu_esp_gdma.h"
+#include "../../core/lv_refr.h"
+
+#if LV_USE_GPU_ESP_GDMA
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Rows of areas not covering whole rows of the buffer are copied one by one.
+ *Starting a copy takes time so it's worth only for long enough rows.*/
+#define MIN_ROW_BYTES   256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool can_offload(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc, lv_area_t * blend_area);
+static bool src_in_img_map(lv_draw_esp_gdma_ctx_t * ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static void get_dest_block(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, lv_gpu_esp_gdma_block_t * block);
+static void get_src_block(const lv_draw_sw_blend_dsc_t * dsc, const lv_area_t * area,
+                          lv_gpu_esp_gdma_block_t * block);
+static bool blocks_overlap(const lv_gpu_esp_gdma_block_t * a, const lv_gpu_esp_gdma_block_t * b);
+static void sync_blocks(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * write,
+                        const lv_gpu_esp_gdma_block_t * read);
+static void wait_copy(lv_draw_esp_gdma_ctx_t * ctx, uint32_t copy_cnt);
+static void retire_ops(lv_draw_esp_gdma_ctx_t * ctx);
+static lv_gpu_esp_gdma_op_t * op_add(lv_draw_esp_gdma_ctx_t * ctx);
+static void copy_start(lv_draw_esp_gdma_ctx_t * ctx, uint8_t * dest, const uint8_t * src, uint32_t size);
+static void fill_start(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * dest, lv_color_t color);
+static void map_start(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * dest,
+                      const lv_gpu_esp_gdma_block_t * src);
+static void blend_sync(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static bool font_has_subpx(const lv_font_t * font);
+static void sync_clip_area(lv_draw_ctx_t * draw_ctx);
+static void draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                        uint32_t letter);
+static void draw_letter_line(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                             const lv_draw_label_letter_t * letters, uint32_t letter_cnt);
+static void draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                             const uint8_t * map_p, lv_img_cf_t color_format);
+static void buffer_copy(lv_draw_ctx_t * draw_ctx, void * dest_buf, lv_coord_t dest_stride, const lv_area_t * dest_area,
+                        void * src_buf, lv_coord_t src_stride, const lv_area_t * src_area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_esp_gdma_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_memset_00(draw_ctx, sizeof(lv_draw_esp_gdma_ctx_t));
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+    if(lv_gpu_esp_gdma_dev_init(&ctx->dev) != LV_RES_OK) {
+        LV_LOG_WARN("Couldn't set up the DMA engine, drawing with the CPU");
+        return;
+    }
+
+    ctx->base_sw_ctx.blend = lv_draw_esp_gdma_blend;
+    ctx->base_sw_ctx.blend_sync = blend_sync;
+    ctx->base_sw_ctx.base_draw.wait_for_finish = lv_draw_esp_gdma_wait_for_finish;
+    ctx->base_sw_ctx.base_draw.draw_letter = draw_letter;
+    ctx->base_sw_ctx.base_draw.draw_letter_line = draw_letter_line;
+    ctx->base_sw_ctx.base_draw.draw_img_decoded = draw_img_decoded;
+    ctx->base_sw_ctx.base_draw.buffer_copy = buffer_copy;
+}
+
+void lv_draw_esp_gdma_ctx_deinit(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+    if(ctx->dev.copy_cb) {
+        lv_draw_esp_gdma_wait_for_finish(draw_ctx);
+        lv_gpu_esp_gdma_dev_deinit(&ctx->dev);
+    }
+
+    lv_draw_sw_deinit_ctx(drv, draw_ctx);
+    lv_memset_00(draw_ctx, sizeof(lv_draw_esp_gdma_ctx_t));
+}
+
+/**
+ * Start large opaque fills and copies in the background and blend everything else with the CPU.
+ * The pending operations which conflict with this blend are already finished by `blend_sync()`.
+ */
+void lv_draw_esp_gdma_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+
+    lv_area_t blend_area;
+    if(!can_offload(draw_ctx, dsc, &blend_area)) {
+        ctx->stats.sw_cnt++;
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    lv_gpu_esp_gdma_block_t dest;
+    get_dest_block(draw_ctx, &blend_area, &dest);
+
+    if(dsc->src_buf) {
+        lv_gpu_esp_gdma_block_t src;
+        get_src_block(dsc, &blend_area, &src);
+        map_start(ctx, &dest, &src);
+        ctx->stats.copy_cnt++;
+    }
+    else {
+        fill_start(ctx, &dest, dsc->color);
+        ctx->stats.fill_cnt++;
+    }
+}
+
+void lv_draw_esp_gdma_wait_for_finish(lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+    wait_copy(ctx, ctx->dev.start_cnt);
+    ctx->op_cnt = 0;
+
+    lv_draw_sw_wait_for_finish(draw_ctx);
+}
+
+void lv_draw_esp_gdma_get_stats(lv_draw_ctx_t * draw_ctx, lv_gpu_esp_gdma_stats_t * stats)
+{
+    *stats = ((lv_draw_esp_gdma_ctx_t *)draw_ctx)->stats;
+}
+
+void lv_draw_esp_gdma_reset_stats(lv_draw_ctx_t * draw_ctx)
+{
+    lv_memset_00(&((lv_draw_esp_gdma_ctx_t *)draw_ctx)->stats, sizeof(lv_gpu_esp_gdma_stats_t));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Only the fills and copies which simply overwrite the pixels of a normal buffer are made by the DMA*/
+static bool can_offload(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc, lv_area_t * blend_area)
+{
+    if(!_lv_area_intersect(blend_area, dsc->blend_area, draw_ctx->clip_area)) return false;
+    if(dsc->mask_buf && dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER) return false;
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL || dsc->opa < LV_OPA_MAX) return false;
+    if(lv_area_get_size(blend_area) < LV_GPU_ESP_GDMA_MIN_SIZE) return false;
+    if(dsc->src_buf && !src_in_img_map((lv_draw_esp_gdma_ctx_t *)draw_ctx, dsc)) return false;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || disp->driver->screen_transp) return false;
+
+    /*Short rows are worth copying only if the DMA can copy more of them at once*/
+    lv_coord_t w = lv_area_get_width(blend_area);
+    if(w * sizeof(lv_color_t) >= MIN_ROW_BYTES) return true;
+    if(w != lv_area_get_width(draw_ctx->buf_area)) return false;
+    if(dsc->src_buf && w != lv_area_get_width(dsc->blend_area)) return false;
+    return true;
+}
+
+/*The temporary buffers (e.g. of recolored images) are refilled and released right after the blend
+ *so only the pixels of the image being drawn can be copied in the background*/
+static bool src_in_img_map(lv_draw_esp_gdma_ctx_t * ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    if(ctx->img_map.h == 0) return false;
+
+    const uint8_t * start = (const uint8_t *)dsc->src_buf;
+    const uint8_t * end = start + lv_area_get_size(dsc->blend_area) * sizeof(lv_color_t);
+    return start >= ctx->img_map.start && end <= ctx->img_map.start + ctx->img_map.w;
+}
+
+static void get_dest_block(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, lv_gpu_esp_gdma_block_t * block)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    uint32_t px_size = disp->driver->screen_transp ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    block->stride = lv_area_get_width(draw_ctx->buf_area) * px_size;
+    block->w = lv_area_get_width(area) * px_size;
+    block->h = lv_area_get_height(area);
+    block->start = (const uint8_t *)draw_ctx->buf + block->stride * (area->y1 - draw_ctx->buf_area->y1) +
+                   (area->x1 - draw_ctx->buf_area->x1) * px_size;
+}
+
+static void get_src_block(const lv_draw_sw_blend_dsc_t * dsc, const lv_area_t * area, lv_gpu_esp_gdma_block_t * block)
+{
+    block->stride = lv_area_get_width(dsc->blend_area) * sizeof(lv_color_t);
+    block->w = lv_area_get_width(area) * sizeof(lv_color_t);
+    block->h = lv_area_get_height(area);
+    block->start = (const uint8_t *)dsc->src_buf + block->stride * (area->y1 - dsc->blend_area->y1) +
+                   (area->x1 - dsc->blend_area->x1) * sizeof(lv_color_t);
+}
+
+/*Check if two blocks have common bytes. Blocks in different buffers never overlap.*/
+static bool blocks_overlap(const lv_gpu_esp_gdma_block_t * a, const lv_gpu_esp_gdma_block_t * b)
+{
+    if(a->h == 0 || b->h == 0) return false;
+
+    /*Let `b` start later*/
+    if(b->start < a->start) {
+        const lv_gpu_esp_gdma_block_t * t = a;
+        a = b;
+        b = t;
+    }
+
+    uintptr_t a_start = (uintptr_t)a->start;
+    uintptr_t b_start = (uintptr_t)b->start;
+    uintptr_t a_end = a_start + (a->h - 1) * a->stride + a->w;
+    if(b_start >= a_end) return false;
+
+    /*A single row can be treated as a row of a buffer with any stride which is not shorter*/
+    uint32_t stride = a->stride;
+    if(b->stride != stride) {
+        if(a->h == 1 && a->w <= b->stride) stride = b->stride;
+        else if(b->h != 1 || b->w > stride) return true;   /*Can't tell, assume the worst*/
+    }
+
+    /*Find where `b` starts on the grid of `a`'s rows.
+     *The rows of `b` might continue at the beginning of the next row of the grid.*/
+    uint32_t y = (b_start - a_start) / stride;
+    uint32_t x = (b_start - a_start) % stride;
+    if(y >= a->h) return false;
+    if(x < a->w) return true;
+    return x + b->w > stride && y + 1 < a->h;
+}
+
+/*Wait until the background operations which write `write` or `read` or read `write` are finished*/
+static void sync_blocks(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * write,
+                        const lv_gpu_esp_gdma_block_t * read)
+{
+    retire_ops(ctx);
+
+    /*The operations finish in order so it's enough to wait for the last conflicting*/
+    uint32_t i;
+    for(i = ctx->op_cnt; i > 0; i--) {
+        lv_gpu_esp_gdma_op_t * op = &ctx->ops[(ctx->op_first + i - 1) % LV_GPU_ESP_GDMA_QUEUE_LEN];
+        if(blocks_overlap(&op->dest, write) || blocks_overlap(&op->src, write) ||
+           (read && blocks_overlap(&op->dest, read))) {
+            wait_copy(ctx, op->last_copy);
+            retire_ops(ctx);
+            return;
+        }
+    }
+}
+
+static void wait_copy(lv_draw_esp_gdma_ctx_t * ctx, uint32_t copy_cnt)
+{
+    lv_gpu_esp_gdma_dev_t * dev = &ctx->dev;
+    if((int32_t)(copy_cnt - dev->ready_cnt) <= 0) return;
+
+    ctx->stats.wait_cnt++;
+    while((int32_t)(copy_cnt - dev->ready_cnt) > 0) {
+        if(dev->wait_cb) dev->wait_cb(dev);
+    }
+}
+
+/*Remove the finished operations*/
+static void retire_ops(lv_draw_esp_gdma_ctx_t * ctx)
+{
+    while(ctx->op_cnt) {
+        lv_gpu_esp_gdma_op_t * op = &ctx->ops[ctx->op_first];
+        if((int32_t)(op->last_copy - ctx->dev.ready_cnt) > 0) break;
+        ctx->op_first = (ctx->op_first + 1) % LV_GPU_ESP_GDMA_QUEUE_LEN;
+        ctx->op_cnt--;
+    }
+}
+
+static lv_gpu_esp_gdma_op_t * op_add(lv_draw_esp_gdma_ctx_t * ctx)
+{
+    retire_ops(ctx);
+    if(ctx->op_cnt == LV_GPU_ESP_GDMA_QUEUE_LEN) {
+        wait_copy(ctx, ctx->ops[ctx->op_first].last_copy);
+        retire_ops(ctx);
+    }
+
+    lv_gpu_esp_gdma_op_t * op = &ctx->ops[(ctx->op_first + ctx->op_cnt) % LV_GPU_ESP_GDMA_QUEUE_LEN];
+    ctx->op_cnt++;
+    return op;
+}
+
+static void copy_start(lv_draw_esp_gdma_ctx_t * ctx, uint8_t * dest, const uint8_t * src, uint32_t size)
+{
+    lv_gpu_esp_gdma_dev_t * dev = &ctx->dev;
+
+    /*Make room in the queue of the engine*/
+    wait_copy(ctx, dev->start_cnt - LV_GPU_ESP_GDMA_QUEUE_LEN + 1);
+
+    if(dev->copy_cb(dev, dest, src, size)) {
+        dev->start_cnt++;
+        ctx->stats.dma_copy_cnt++;
+    }
+    else {
+        /*The CPU can copy only when the previous copies are ready, else they could overwrite it*/
+        wait_copy(ctx, dev->start_cnt);
+        lv_memcpy(dest, src, size);
+    }
+}
+
+/*The DMA can only copy so fill the first row with the CPU and copy it to the others*/
+static void fill_start(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * dest, lv_color_t color)
+{
+    lv_gpu_esp_gdma_op_t * op = op_add(ctx);
+    op->dest = *dest;
+    op->src.h = 0;
+
+    uint8_t * buf = (uint8_t *)dest->start;
+    lv_color_fill((lv_color_t *)buf, color, dest->w / sizeof(lv_color_t));
+
+    if(dest->w == dest->stride) {
+        /*The rows are continuous so double the filled part with each copy*/
+        uint32_t size = dest->w * dest->h;
+        uint32_t done = dest->w;
+        while(done < size) {
+            uint32_t n = LV_MIN(done, size - done);
+            copy_start(ctx, buf + done, buf, n);
+            done += n;
+        }
+    }
+    else {
+        uint32_t y;
+        for(y = 1; y < dest->h; y++) {
+            copy_start(ctx, buf + y * dest->stride, buf, dest->w);
+        }
+    }
+
+    op->last_copy = ctx->dev.start_cnt;
+}
+
+static void map_start(lv_draw_esp_gdma_ctx_t * ctx, const lv_gpu_esp_gdma_block_t * dest,
+                      const lv_gpu_esp_gdma_block_t * src)
+{
+    lv_gpu_esp_gdma_op_t * op = op_add(ctx);
+    op->dest = *dest;
+    op->src = *src;
+
+    uint8_t * dest_buf = (uint8_t *)dest->start;
+    if(dest->w == dest->stride && src->w == src->stride) {
+        copy_start(ctx, dest_buf, src->start, dest->w * dest->h);
+    }
+    else {
+        uint32_t y;
+        for(y = 0; y < dest->h; y++) {
+            copy_start(ctx, dest_buf + y * dest->stride, src->start + y * src->stride, dest->w);
+        }
+    }
+
+    op->last_copy = ctx->dev.start_cnt;
+}
+
+/*Called before each blend to finish the background operations which would conflict with it*/
+static void blend_sync(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+
+    lv_area_t blend_area;
+    lv_gpu_esp_gdma_block_t dest;
+    if(can_offload(draw_ctx, dsc, &blend_area)) {
+        /*The copies of the DMA are made in order, only the first row of fills are written by the CPU*/
+        if(dsc->src_buf == NULL) {
+            blend_area.y2 = blend_area.y1;
+            get_dest_block(draw_ctx, &blend_area, &dest);
+            sync_blocks(ctx, &dest, NULL);
+        }
+        return;
+    }
+
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    get_dest_block(draw_ctx, &blend_area, &dest);
+    if(dsc->src_buf) {
+        lv_gpu_esp_gdma_block_t src;
+        get_src_block(dsc, &blend_area, &src);
+        sync_blocks(ctx, &dest, &src);
+    }
+    else {
+        sync_blocks(ctx, &dest, NULL);
+    }
+
+    if(ctx->op_cnt) ctx->stats.overlap_cnt++;
+}
+
+static bool font_has_subpx(const lv_font_t * font)
+{
+    while(font) {
+        if(font->subpx != LV_FONT_SUBPX_NONE) return true;
+        font = font->fallback;
+    }
+    return false;
+}
+
+/*Sub-pixel rendered letters are written to the buffer directly, not by blending*/
+static void sync_clip_area(lv_draw_ctx_t * draw_ctx)
+{
+    lv_area_t area;
+    if(!_lv_area_intersect(&area, draw_ctx->clip_area, draw_ctx->buf_area)) return;
+
+    lv_gpu_esp_gdma_block_t dest;
+    get_dest_block(draw_ctx, &area, &dest);
+    sync_blocks((lv_draw_esp_gdma_ctx_t *)draw_ctx, &dest, NULL);
+}
+
+static void draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                        uint32_t letter)
+{
+    if(font_has_subpx(dsc->font)) sync_clip_area(draw_ctx);
+    lv_draw_sw_letter(draw_ctx, dsc, pos_p, letter);
+}
+
+static void draw_letter_line(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                             const lv_draw_label_letter_t * letters, uint32_t letter_cnt)
+{
+    if(font_has_subpx(dsc->font)) sync_clip_area(draw_ctx);
+    lv_draw_sw_letter_line(draw_ctx, dsc, letters, letter_cnt);
+}
+
+/*Transformations and color format conversions read the image directly.
+ *Only the blends from the image itself can be offloaded while it's drawn.*/
+static void draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                             const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    lv_gpu_esp_gdma_block_t map;
+    map.start = map_p;
+    map.w = lv_img_buf_get_img_size(lv_area_get_width(coords), lv_area_get_height(coords), color_format);
+    map.stride = map.w;
+    map.h = 1;
+    lv_draw_esp_gdma_ctx_t * ctx = (lv_draw_esp_gdma_ctx_t *)draw_ctx;
+    sync_blocks(ctx, &map, NULL);
+
+    ctx->img_map = map;
+    lv_draw_sw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+    ctx->img_map.h = 0;
+}
+
+static void buffer_copy(lv_draw_ctx_t * draw_ctx, void * dest_buf, lv_coord_t dest_stride, const lv_area_t * dest_area,
+                        void * src_buf, lv_coord_t src_stride, const lv_area_t * src_area)
+{
+    lv_draw_esp_gdma_wait_for_finish(draw_ctx);
+    lv_draw_sw_buffer_copy(draw_ctx, dest_buf, dest_stride, dest_area, src_buf, src_stride, src_area);
+}
+
+#endif /*LV_USE_GPU_ESP_GDMA*/
@@ -0,0 +1,140 @@
+/**
+ * @file lv_gpu_esp_gdma.h
+ *
+ */
+
+#ifndef LV_GPU_ESP_GDMA_H
+#define LV_GPU_ESP_GDMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../hal/lv_hal_disp.h"
+#include "../sw/lv_draw_sw.h"
+
+#if LV_USE_GPU_ESP_GDMA
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A DMA engine which copies memory in the background.
+ * With ESP-IDF it's a GDMA channel used by `esp_async_memcpy`,
+ * on other platforms a stand-in which makes the copies only when they are waited for.
+ */
+typedef struct _lv_gpu_esp_gdma_dev_t {
+    /**
+     * Start copying `size` bytes from `src` to `dest` after the previously started copies.
+     * Increment `ready_cnt` when it's finished (e.g. in the interrupt).
+     * Return `false` if the engine can't copy these buffers. At most `LV_GPU_ESP_GDMA_QUEUE_LEN` copies are started
+     * at the same time.
+     */
+    bool (*copy_cb)(struct _lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size);
+
+    /** Called repeatedly while waiting for a copy to finish. E.g. yield to the other tasks. (Optional)*/
+    void (*wait_cb)(struct _lv_gpu_esp_gdma_dev_t * dev);
+
+    uint32_t start_cnt;             /**< Number of started copies*/
+    volatile uint32_t ready_cnt;    /**< Number of finished copies*/
+    void * user_data;
+} lv_gpu_esp_gdma_dev_t;
+
+/**
+ * Describes a part of a buffer with rows
+ */
+typedef struct {
+    const uint8_t * start;  /**< Address of the first byte*/
+    uint32_t stride;        /**< Bytes from the start of a row to the start of the next*/
+    uint32_t w;             /**< Bytes in a row*/
+    uint32_t h;             /**< Number of rows*/
+} lv_gpu_esp_gdma_block_t;
+
+/**
+ * A fill or copy running in the background
+ */
+typedef struct {
+    lv_gpu_esp_gdma_block_t dest;
+    lv_gpu_esp_gdma_block_t src;    /**< `h == 0` for fills*/
+    uint32_t last_copy;             /**< It's ready when `ready_cnt` reaches this value*/
+} lv_gpu_esp_gdma_op_t;
+
+typedef struct {
+    uint32_t fill_cnt;      /**< Number of fills started in the background*/
+    uint32_t copy_cnt;      /**< Number of image copies started in the background*/
+    uint32_t sw_cnt;        /**< Number of blends made by the CPU*/
+    uint32_t dma_copy_cnt;  /**< Number of memory copies of the DMA engine*/
+    uint32_t overlap_cnt;   /**< Number of blends made by the CPU while there were copies in the background*/
+    uint32_t wait_cnt;      /**< Number of times the CPU waited for the background copies*/
+} lv_gpu_esp_gdma_stats_t;
+
+typedef struct {
+    lv_draw_sw_ctx_t base_sw_ctx;
+    lv_gpu_esp_gdma_dev_t dev;
+    lv_gpu_esp_gdma_op_t ops[LV_GPU_ESP_GDMA_QUEUE_LEN];
+    uint32_t op_first;      /**< Index of the oldest op in `ops`*/
+    uint32_t op_cnt;
+    lv_gpu_esp_gdma_block_t img_map;    /**< The image being drawn, `h == 0` if none*/
+    lv_gpu_esp_gdma_stats_t stats;
+} lv_draw_esp_gdma_ctx_t;
+
+struct _lv_disp_drv_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void lv_draw_esp_gdma_ctx_init(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+void lv_draw_esp_gdma_ctx_deinit(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+void lv_draw_esp_gdma_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+void lv_draw_esp_gdma_wait_for_finish(lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Get the counters of a draw context
+ * @param draw_ctx  pointer to a draw context initialized by `lv_draw_esp_gdma_ctx_init()`
+ * @param stats     the result will be stored here
+ */
+void lv_draw_esp_gdma_get_stats(lv_draw_ctx_t * draw_ctx, lv_gpu_esp_gdma_stats_t * stats);
+
+/**
+ * Clear the counters of a draw context
+ * @param draw_ctx  pointer to a draw context initialized by `lv_draw_esp_gdma_ctx_init()`
+ */
+void lv_draw_esp_gdma_reset_stats(lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Set up a DMA engine: a GDMA channel with ESP-IDF or the stand-in on other platforms
+ * @param dev       pointer to a device to initialize
+ * @return          LV_RES_OK: success; LV_RES_INV: the engine couldn't be set up
+ */
+lv_res_t lv_gpu_esp_gdma_dev_init(lv_gpu_esp_gdma_dev_t * dev);
+
+/**
+ * Free the resources of a DMA engine. There shouldn't be copies in progress.
+ * @param dev       pointer to a device initialized by `lv_gpu_esp_gdma_dev_init()`
+ */
+void lv_gpu_esp_gdma_dev_deinit(lv_gpu_esp_gdma_dev_t * dev);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_USE_GPU_ESP_GDMA*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_GPU_ESP_GDMA_H*/
@@ -0,0 +1,179 @@
+/**
+ * @file lv_gpu_esp_gdma_dev.c
+ * The DMA engines of the ESP GDMA draw context
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_gpu_esp_gdma.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_assert.h"
+
+#if LV_USE_GPU_ESP_GDMA
+
+#ifdef ESP_PLATFORM
+    #include "esp_async_memcpy.h"
+    #include "esp_idf_version.h"
+    #include "esp_attr.h"
+    #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        #include "esp_memory_utils.h"
+    #else
+        #include "soc/soc_memory_layout.h"
+    #endif
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#ifdef ESP_PLATFORM
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+    typedef async_memcpy_handle_t memcpy_handle_t;
+#else
+    typedef async_memcpy_t memcpy_handle_t;
+#endif
+#else
+typedef struct {
+    void * dest;
+    const void * src;
+    size_t size;
+} host_copy_t;
+
+typedef struct {
+    host_copy_t copies[LV_GPU_ESP_GDMA_QUEUE_LEN];
+    uint32_t first;
+    uint32_t cnt;
+} host_queue_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#ifdef ESP_PLATFORM
+    static bool gdma_copy(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size);
+    static bool IRAM_ATTR gdma_ready_isr(memcpy_handle_t handle, async_memcpy_event_t * event, void * user_data);
+#else
+    static bool host_copy(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size);
+    static void host_wait(lv_gpu_esp_gdma_dev_t * dev);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#ifdef ESP_PLATFORM
+
+lv_res_t lv_gpu_esp_gdma_dev_init(lv_gpu_esp_gdma_dev_t * dev)
+{
+    lv_memset_00(dev, sizeof(lv_gpu_esp_gdma_dev_t));
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = LV_GPU_ESP_GDMA_QUEUE_LEN;
+    memcpy_handle_t handle;
+    if(esp_async_memcpy_install(&config, &handle) != ESP_OK) return LV_RES_INV;
+
+    dev->copy_cb = gdma_copy;
+    dev->user_data = handle;
+    return LV_RES_OK;
+}
+
+void lv_gpu_esp_gdma_dev_deinit(lv_gpu_esp_gdma_dev_t * dev)
+{
+    esp_async_memcpy_uninstall(dev->user_data);
+    lv_memset_00(dev, sizeof(lv_gpu_esp_gdma_dev_t));
+}
+
+#else
+
+/*Without ESP-IDF the copies are queued and made by the CPU only when they are waited for.
+ *It's the slowest possible DMA so drawing with a missing wait results in wrong pixels.*/
+lv_res_t lv_gpu_esp_gdma_dev_init(lv_gpu_esp_gdma_dev_t * dev)
+{
+    lv_memset_00(dev, sizeof(lv_gpu_esp_gdma_dev_t));
+
+    host_queue_t * queue = lv_mem_alloc(sizeof(host_queue_t));
+    LV_ASSERT_MALLOC(queue);
+    if(queue == NULL) return LV_RES_INV;
+    lv_memset_00(queue, sizeof(host_queue_t));
+
+    dev->copy_cb = host_copy;
+    dev->wait_cb = host_wait;
+    dev->user_data = queue;
+    return LV_RES_OK;
+}
+
+void lv_gpu_esp_gdma_dev_deinit(lv_gpu_esp_gdma_dev_t * dev)
+{
+    lv_mem_free(dev->user_data);
+    lv_memset_00(dev, sizeof(lv_gpu_esp_gdma_dev_t));
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#ifdef ESP_PLATFORM
+
+static bool gdma_copy(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size)
+{
+    /*The data would go around the cache of the PSRAM. Let the CPU copy there.*/
+    if(!esp_ptr_dma_capable(dest) || !esp_ptr_dma_capable(src)) return false;
+
+    return esp_async_memcpy(dev->user_data, dest, (void *)src, size, gdma_ready_isr, dev) == ESP_OK;
+}
+
+static bool IRAM_ATTR gdma_ready_isr(memcpy_handle_t handle, async_memcpy_event_t * event, void * user_data)
+{
+    LV_UNUSED(handle);
+    LV_UNUSED(event);
+
+    lv_gpu_esp_gdma_dev_t * dev = user_data;
+    dev->ready_cnt++;
+    return false;
+}
+
+#else
+
+static bool host_copy(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size)
+{
+    host_queue_t * queue = dev->user_data;
+    if(queue->cnt == LV_GPU_ESP_GDMA_QUEUE_LEN) host_wait(dev);
+
+    host_copy_t * copy = &queue->copies[(queue->first + queue->cnt) % LV_GPU_ESP_GDMA_QUEUE_LEN];
+    copy->dest = dest;
+    copy->src = src;
+    copy->size = size;
+    queue->cnt++;
+    return true;
+}
+
+/*Make the oldest copy*/
+static void host_wait(lv_gpu_esp_gdma_dev_t * dev)
+{
+    host_queue_t * queue = dev->user_data;
+    if(queue->cnt == 0) return;
+
+    host_copy_t * copy = &queue->copies[queue->first];
+    lv_memcpy(copy->dest, copy->src, copy->size);
+    queue->first = (queue->first + 1) % LV_GPU_ESP_GDMA_QUEUE_LEN;
+    queue->cnt--;
+    dev->ready_cnt++;
+}
+
+#endif
+
+#endif /*LV_USE_GPU_ESP_GDMA*/
@@ -88,6 +88,16 @@ typedef struct _lv_draw_ctx_t  {
     void (*draw_letter)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                         uint32_t letter);
 
+    /**
+     * Draw some letters of a line at once. Optional, if `NULL` `draw_letter` is called for each letter.
+     * @param draw_ctx      pointer to a draw context
+     * @param dsc           the draw descriptor of the text. Its `color` is not used, each letter has its own.
+     * @param letters       the letters to draw in the order of drawing
+     * @param letter_cnt    number of letters in `letters`
+     */
+    void (*draw_letter_line)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                             const lv_draw_label_letter_t * letters, uint32_t letter_cnt);
+
 
     void (*draw_line)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
                       const lv_point_t * point2);
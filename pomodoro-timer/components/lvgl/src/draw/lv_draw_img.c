@@ -29,7 +29,9 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
                                                       const lv_area_t * coords, const void * src);
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
-static void draw_cleanup(_lv_img_cache_entry_t * cache);
+static void show_placeholder(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords,
+                             _lv_img_cache_entry_t * cdsc);
+static void draw_cleanup(lv_draw_ctx_t * draw_ctx, _lv_img_cache_entry_t * cache);
 
 /**********************
  *  STATIC VARIABLES
@@ -237,6 +239,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
 
     if(cdsc == NULL) return LV_RES_INV;
 
+    if(cdsc->decoding) {
+        show_placeholder(draw_ctx, draw_dsc, coords, cdsc);
+        return LV_RES_OK;
+    }
+
     lv_img_cf_t cf;
     if(lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf)) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
     else if(LV_IMG_CF_ALPHA_8BIT == cdsc->dec_dsc.header.cf) cf = LV_IMG_CF_ALPHA_8BIT;
@@ -279,7 +286,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
         union_ok = _lv_area_intersect(&clip_com, draw_ctx->clip_area, &map_area_rot);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            draw_cleanup(draw_ctx, cdsc);
             return LV_RES_OK;
         }
 
@@ -295,7 +302,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
         union_ok = _lv_area_intersect(&mask_com, draw_ctx->clip_area, coords);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            draw_cleanup(draw_ctx, cdsc);
             return LV_RES_OK;
         }
 
@@ -317,12 +324,14 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
             union_ok = _lv_area_intersect(&mask_line, clip_area_ori, &line);
             if(union_ok == false) continue;
 
+            /*The previous line might be still read in the background*/
+            lv_draw_wait_for_finish(draw_ctx);
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
             if(read_res != LV_RES_OK) {
                 lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 lv_mem_buf_release(buf);
-                draw_cleanup(cdsc);
+                draw_cleanup(draw_ctx, cdsc);
                 draw_ctx->clip_area = clip_area_ori;
                 return LV_RES_INV;
             }
@@ -334,10 +343,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
             y++;
         }
         draw_ctx->clip_area = clip_area_ori;
+        lv_draw_wait_for_finish(draw_ctx);
         lv_mem_buf_release(buf);
     }
 
-    draw_cleanup(cdsc);
+    draw_cleanup(draw_ctx, cdsc);
     return LV_RES_OK;
 }
 
@@ -354,12 +364,39 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
-static void draw_cleanup(_lv_img_cache_entry_t * cache)
+static void show_placeholder(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords,
+                             _lv_img_cache_entry_t * cdsc)
+{
+    lv_area_t area;
+    _lv_img_buf_get_transformed_area(&area, lv_area_get_width(coords), lv_area_get_height(coords), draw_dsc->angle,
+                                     draw_dsc->zoom, &draw_dsc->pivot);
+    lv_area_move(&area, coords->x1, coords->y1);
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, &area, draw_ctx->clip_area)) return;
+
+    if(draw_dsc->placeholder_opa > LV_OPA_MIN) {
+        lv_draw_rect_dsc_t rect_dsc;
+        lv_draw_rect_dsc_init(&rect_dsc);
+        rect_dsc.bg_color = draw_dsc->placeholder_color;
+        rect_dsc.bg_opa = (draw_dsc->placeholder_opa * draw_dsc->opa) >> 8;
+        rect_dsc.blend_mode = draw_dsc->blend_mode;
+        lv_draw_rect(draw_ctx, &rect_dsc, &area);
+    }
+
+    /*Redraw the image when it's decoded*/
+    _lv_img_cache_add_redraw_area(cdsc, &clip_area);
+}
+
+static void draw_cleanup(lv_draw_ctx_t * draw_ctx, _lv_img_cache_entry_t * cache)
 {
     /*Automatically close images with no caching*/
 #if LV_IMG_CACHE_DEF_SIZE == 0
+    /*The image might be still read in the background*/
+    lv_draw_wait_for_finish(draw_ctx);
     lv_img_decoder_close(&cache->dec_dsc);
 #else
+    LV_UNUSED(draw_ctx);
     LV_UNUSED(cache);
 #endif
 }
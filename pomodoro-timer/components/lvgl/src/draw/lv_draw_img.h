@@ -43,6 +43,10 @@ typedef struct {
 
     int32_t frame_id;
     uint8_t antialias       : 1;
+
+    /*Drawn while the image is decoded in the background*/
+    lv_color_t placeholder_color;
+    lv_opa_t placeholder_opa;
 } lv_draw_img_dsc_t;
 
 struct _lv_draw_ctx_t;
@@ -19,6 +19,7 @@
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LETTER_BATCH_SIZE 32 /*Pass this many letters of a line at once to the draw context*/
 
 /**********************
  *      TYPEDEFS
@@ -88,8 +89,6 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         return;
     }
 
-    lv_draw_label_dsc_t dsc_mod = *dsc;
-
     const lv_font_t * font = dsc->font;
     int32_t w;
 
@@ -113,11 +112,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     else {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
-        lv_txt_get_size(&p, txt, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
-                        dsc->flag);
+        if(dsc->lines && _lv_txt_lines_match(dsc->lines, font, dsc->letter_space, LV_COORD_MAX, dsc->flag)) {
+            _lv_txt_lines_get_size(dsc->lines, txt, dsc->line_space, &p);
+        }
+        else {
+            lv_txt_get_size(&p, txt, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
+                            dsc->flag);
+        }
         w = p.x;
     }
 
+    /*Use the pre-calculated lines only if they were made for this width*/
+    const lv_txt_lines_t * lines = dsc->lines;
+    if(lines && !_lv_txt_lines_match(lines, font, dsc->letter_space, w, dsc->flag)) lines = NULL;
+    uint32_t line_idx = 0;
+
     int32_t line_height_font = lv_font_get_line_height(font);
     int32_t line_height = line_height_font + dsc->line_space;
 
@@ -137,6 +146,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     int32_t last_line_start = -1;
 
     /*Check the hint to use the cached info*/
+    if(lines) hint = NULL;  /*The lines can be skipped quickly without the hint*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
@@ -151,13 +161,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_end;
+    if(lines) line_end = lines->lines[0].end;
+    else line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(lines) line_end = ++line_idx < lines->line_cnt ? lines->lines[line_idx].end : line_start;
+        else line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +185,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_idx].w;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_idx].w;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -205,6 +220,8 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     lv_color_t recolor  = lv_color_black();
     lv_color_t color = lv_color_black();
     int32_t letter_w;
+    lv_draw_label_letter_t letters[LETTER_BATCH_SIZE];
+    uint32_t letter_cnt = 0;
 
     lv_draw_rect_dsc_t draw_dsc_sel;
     lv_draw_rect_dsc_init(&draw_dsc_sel);
@@ -293,19 +310,31 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
                     sel_coords.y1 = pos.y;
                     sel_coords.x2 = pos.x + letter_w + dsc->letter_space - 1;
                     sel_coords.y2 = pos.y + line_height - 1;
+                    /*Draw the previous letters first as the selection can cover them*/
+                    lv_draw_letter_line(draw_ctx, dsc, letters, letter_cnt);
+                    letter_cnt = 0;
                     lv_draw_rect(draw_ctx, &draw_dsc_sel, &sel_coords);
                     color = dsc->sel_color;
                 }
             }
 
-            dsc_mod.color = color;
-            lv_draw_letter(draw_ctx, &dsc_mod, &pos, letter);
+            letters[letter_cnt].pos = pos;
+            letters[letter_cnt].letter = letter;
+            letters[letter_cnt].color = color;
+            letter_cnt++;
+            if(letter_cnt == LETTER_BATCH_SIZE) {
+                lv_draw_letter_line(draw_ctx, dsc, letters, letter_cnt);
+                letter_cnt = 0;
+            }
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
             }
         }
 
+        lv_draw_letter_line(draw_ctx, dsc, letters, letter_cnt);
+        letter_cnt = 0;
+
         if(dsc->decor & LV_TEXT_DECOR_STRIKETHROUGH) {
             lv_point_t p1;
             lv_point_t p2;
@@ -334,21 +363,29 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(lines) {
+            if(++line_idx >= lines->line_cnt) break;
+            line_end = lines->lines[line_idx].end;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_idx].w;
+            else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                   dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_idx].w;
+            else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                   dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -367,6 +404,24 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
     draw_ctx->draw_letter(draw_ctx, dsc, pos_p, letter);
 }
 
+void lv_draw_letter_line(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                         const lv_draw_label_letter_t * letters, uint32_t letter_cnt)
+{
+    if(letter_cnt == 0) return;
+
+    if(draw_ctx->draw_letter_line) {
+        draw_ctx->draw_letter_line(draw_ctx, dsc, letters, letter_cnt);
+        return;
+    }
+
+    lv_draw_label_dsc_t dsc_mod = *dsc;
+    uint32_t i;
+    for(i = 0; i < letter_cnt; i++) {
+        dsc_mod.color = letters[i].color;
+        draw_ctx->draw_letter(draw_ctx, &dsc_mod, &letters[i].pos, letters[i].letter);
+    }
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
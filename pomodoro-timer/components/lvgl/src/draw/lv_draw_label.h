@@ -44,8 +44,16 @@ typedef struct {
     lv_text_flag_t flag;
     lv_text_decor_t decor : 3;
     lv_blend_mode_t blend_mode: 3;
+    const lv_txt_lines_t * lines;   /*Optional line breaks of the text to not calculate them while drawing*/
 } lv_draw_label_dsc_t;
 
+/** A letter to draw with `lv_draw_letter_line`*/
+typedef struct {
+    lv_point_t pos;         /**< Top left corner of the letter on its line*/
+    uint32_t letter;        /**< The Unicode code point of the letter*/
+    lv_color_t color;       /**< Color of the letter, e.g. changed by re-coloring or selection*/
+} lv_draw_label_letter_t;
+
 /** Store some info to speed up drawing of very large texts
  * It takes a lot of time to get the first visible character because
  * all the previous characters needs to be checked to calculate the positions.
@@ -85,6 +93,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(struct _lv_draw_ctx_t * draw_ctx, const
 void lv_draw_letter(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                     uint32_t letter);
 
+/**
+ * Draw some letters of a line with one call of the draw context if it supports it.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           the draw descriptor of the text. Its `color` is not used, each letter has its own.
+ * @param letters       the letters to draw in the order of drawing
+ * @param letter_cnt    number of letters in `letters`
+ */
+void lv_draw_letter_line(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                         const lv_draw_label_letter_t * letters, uint32_t letter_cnt);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
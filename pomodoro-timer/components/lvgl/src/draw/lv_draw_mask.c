@@ -18,11 +18,33 @@
  *********************/
 #define CIRCLE_CACHE_LIFE_MAX   1000
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define MASK_RUN_MAX    16
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*In increasing order as merging the runs of masks keeps the smaller*/
+enum {
+    MASK_RUN_TRANSP,    /*The mask clears the pixels*/
+    MASK_RUN_EDGE,      /*The mask needs to be calculated pixel by pixel*/
+    MASK_RUN_COVER,     /*The mask doesn't change the pixels*/
+};
+
+/*A run ends on `x2` and starts after the previous run*/
+typedef struct {
+    int32_t x2;
+    uint8_t kind;
+} mask_run_t;
+
+typedef uint32_t (*mask_runs_cb_t)(void * param, int32_t x1, int32_t x2, int32_t y, mask_run_t * runs);
+
+typedef struct {
+    _lv_draw_mask_common_dsc_t * param;
+    lv_draw_mask_xcb_t cb;      /*The callback of the mask when it was compiled*/
+    mask_runs_cb_t runs_cb;     /*NULL if the mask can be calculated only on the whole line*/
+} compiled_mask_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -60,9 +82,23 @@ static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_
                                 lv_coord_t * x_start);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
+static void compile_masks(void);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t apply_masks(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                            lv_coord_t len);
+static uint32_t runs_push(mask_run_t * runs, uint32_t cnt, int32_t x1, int32_t x2, int32_t end, uint8_t kind);
+static uint32_t runs_merge(mask_run_t * runs, uint32_t cnt, const mask_run_t * runs2, uint32_t cnt2, int32_t x1,
+                           int32_t x2);
+static uint32_t radius_runs(void * param, int32_t x1, int32_t x2, int32_t y, mask_run_t * runs);
+static uint32_t fade_runs(void * param, int32_t x1, int32_t x2, int32_t y, mask_run_t * runs);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*The added masks up to the first free entry with the function which describes them line by line*/
+static compiled_mask_t compiled[_LV_MASK_MAX_NUM];
+static uint32_t compiled_cnt;
+static bool compiled_valid;
+static bool compiled_runs_only;    /*All the masks can be calculated run by run*/
 
 /**********************
  *      MACROS
@@ -93,6 +129,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
 
     LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
     LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    compiled_valid = false;
 
     return i;
 }
@@ -111,22 +148,105 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len)
 {
-    bool changed = false;
-    _lv_draw_mask_common_dsc_t * dsc;
+    return lv_draw_mask_apply_span(mask_buf, abs_x, abs_y, len, NULL);
+}
+
+/**
+ * Apply the added buffers on a line and tell which part of the line is visible and which part is not changed.
+ * The radius and fade masks are evaluated run by run: only the anti-aliased runs of the line are calculated
+ * pixel by pixel, the transparent runs are cleared and the fully covered runs are skipped.
+ * If there are other masks too, all the masks are calculated on the whole line as in `lv_draw_mask_apply`.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param span store the visible and the not changed part of the line here. Can be `NULL`.
+ * @return One of these values:
+ * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent.
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged
+ * - `LV_DRAW_MASK_RES_CHANGED`: `mask_buf` has changed, it shows the desired opacity of each pixel in the given line
+ */
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_span(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len,
+                                                                 lv_draw_mask_span_t * span)
+{
+    if(!compiled_valid) compile_masks();
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    int32_t x1 = abs_x;
+    int32_t x2 = abs_x + len - 1;
 
-    while(m->param) {
-        dsc = m->param;
-        lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
-        res = dsc->cb(mask_buf, abs_x, abs_y, len, (void *)m->param);
-        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
-        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+    /*Intersect the runs of the masks*/
+    mask_run_t runs[MASK_RUN_MAX];
+    mask_run_t mask_runs[MASK_RUN_MAX];
+    uint32_t cnt = runs_push(runs, 0, x1, x2, x2, MASK_RUN_COVER);
+    bool runs_only = compiled_runs_only;
+    uint32_t i;
+    for(i = 0; i < compiled_cnt; i++) {
+        compiled_mask_t * m = &compiled[i];
+        /*The parameter might be initialized again to an other type of mask since it was added*/
+        if(m->runs_cb == NULL || m->param->cb != m->cb) {
+            runs_only = false;
+            continue;
+        }
+        uint32_t mask_cnt = m->runs_cb(m->param, x1, x2, abs_y, mask_runs);
+        cnt = runs_merge(runs, cnt, mask_runs, mask_cnt, x1, x2);
+        if(cnt == 1 && runs[0].kind == MASK_RUN_TRANSP) break;
+    }
 
-        m++;
+    /*The line based masks (line, angle, polygon) round differently on a part of a line,
+     *so calculate all the masks on the whole line. Only the transparent ends are known.*/
+    if(!runs_only && !(cnt == 1 && runs[0].kind == MASK_RUN_TRANSP)) {
+        lv_draw_mask_res_t res = apply_masks(mask_buf, abs_x, abs_y, len);
+        if(span) {
+            span->x1 = runs[0].kind == MASK_RUN_TRANSP ? runs[0].x2 + 1 : x1;
+            span->x2 = runs[cnt - 1].kind == MASK_RUN_TRANSP ? runs[cnt - 2].x2 : x2;
+            span->cover_x1 = res == LV_DRAW_MASK_RES_FULL_COVER ? x1 : x2 + 1;
+            span->cover_x2 = res == LV_DRAW_MASK_RES_FULL_COVER ? x2 : x1 - 1;
+        }
+        return res;
     }
 
-    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    bool visible = false;
+    bool changed = false;
+    int32_t vis_x1 = x2 + 1;
+    int32_t vis_x2 = x1 - 1;
+    int32_t cover_x1 = x2 + 1;
+    int32_t cover_x2 = x1 - 1;
+    int32_t x = x1;
+    for(i = 0; i < cnt; i++) {
+        int32_t run_len = runs[i].x2 - x + 1;
+        lv_opa_t * buf = &mask_buf[x - x1];
+        lv_draw_mask_res_t res;
+        if(runs[i].kind == MASK_RUN_TRANSP) res = LV_DRAW_MASK_RES_TRANSP;
+        else if(runs[i].kind == MASK_RUN_COVER) res = LV_DRAW_MASK_RES_FULL_COVER;
+        else res = apply_masks(buf, x, abs_y, run_len);
+
+        if(res == LV_DRAW_MASK_RES_TRANSP) {
+            lv_memset_00(buf, run_len);
+            changed = true;
+        }
+        else {
+            if(!visible) vis_x1 = x;
+            vis_x2 = runs[i].x2;
+            visible = true;
+            if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+            else if(runs[i].x2 - x > cover_x2 - cover_x1) {
+                cover_x1 = x;
+                cover_x2 = runs[i].x2;
+            }
+        }
+        x = runs[i].x2 + 1;
+    }
+
+    if(span) {
+        span->x1 = vis_x1;
+        span->x2 = vis_x2;
+        span->cover_x1 = cover_x1;
+        span->cover_x2 = cover_x2;
+    }
+
+    if(!visible) return LV_DRAW_MASK_RES_TRANSP;
+    else return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
 /**
@@ -176,6 +296,7 @@ void * lv_draw_mask_remove_id(int16_t id)
         p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
         LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
         LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        compiled_valid = false;
     }
 
     return p;
@@ -237,6 +358,20 @@ void _lv_draw_mask_cleanup(void)
         }
         lv_memset_00(&LV_GC_ROOT(_lv_circle_cache[i]), sizeof(LV_GC_ROOT(_lv_circle_cache[i])));
     }
+    compiled_valid = false;
+}
+
+void _lv_draw_mask_save_all(_lv_draw_mask_saved_arr_t saved)
+{
+    lv_memcpy(saved, LV_GC_ROOT(_lv_draw_mask_list), sizeof(_lv_draw_mask_saved_arr_t));
+    lv_memset_00(LV_GC_ROOT(_lv_draw_mask_list), sizeof(_lv_draw_mask_saved_arr_t));
+    compiled_valid = false;
+}
+
+void _lv_draw_mask_restore_all(const _lv_draw_mask_saved_arr_t saved)
+{
+    lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), saved, sizeof(_lv_draw_mask_saved_arr_t));
+    compiled_valid = false;
 }
 
 /**
@@ -1526,5 +1661,159 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);// >> 8);
 }
 
+/**
+ * Collect the added masks in the order of `lv_draw_mask_apply` and select the functions
+ * which tell on which runs of a line the masks need to be calculated.
+ */
+static void compile_masks(void)
+{
+    compiled_cnt = 0;
+    compiled_runs_only = true;
+    while(compiled_cnt < _LV_MASK_MAX_NUM && LV_GC_ROOT(_lv_draw_mask_list[compiled_cnt]).param) {
+        compiled_mask_t * m = &compiled[compiled_cnt];
+        m->param = LV_GC_ROOT(_lv_draw_mask_list[compiled_cnt]).param;
+        m->cb = m->param->cb;
+        if(m->cb == (lv_draw_mask_xcb_t)lv_draw_mask_radius) m->runs_cb = radius_runs;
+        else if(m->cb == (lv_draw_mask_xcb_t)lv_draw_mask_fade) m->runs_cb = fade_runs;
+        else m->runs_cb = NULL;
+        if(m->runs_cb == NULL) compiled_runs_only = false;
+        compiled_cnt++;
+    }
+    compiled_valid = true;
+}
+
+/**
+ * Calculate all the masks on a part of a line like `lv_draw_mask_apply` did on the whole line.
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t apply_masks(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                            lv_coord_t len)
+{
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < compiled_cnt; i++) {
+        lv_draw_mask_res_t res = compiled[i].param->cb(mask_buf, abs_x, abs_y, len, compiled[i].param);
+        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+    }
+
+    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+/**
+ * Add a run to the runs of a `x1..x2` line.
+ * Runs ending before the end of the previous run are ignored and the runs are clipped to the line.
+ * @return the new number of runs
+ */
+static uint32_t runs_push(mask_run_t * runs, uint32_t cnt, int32_t x1, int32_t x2, int32_t end, uint8_t kind)
+{
+    if(end > x2) end = x2;
+    if(end < x1) return cnt;
+
+    if(cnt > 0) {
+        mask_run_t * last = &runs[cnt - 1];
+        if(end <= last->x2) return cnt;
+        if(last->kind == kind) {
+            last->x2 = end;
+            return cnt;
+        }
+
+        /*No more space: calculate the rest pixel by pixel*/
+        if(cnt == MASK_RUN_MAX) {
+            last->x2 = end;
+            last->kind = MASK_RUN_EDGE;
+            return cnt;
+        }
+    }
+
+    runs[cnt].x2 = end;
+    runs[cnt].kind = kind;
+    return cnt + 1;
+}
+
+/**
+ * Intersect the runs of two masks: a run is covered only if both masks cover it
+ * and transparent if any of the masks is transparent.
+ * @return the new number of runs in `runs`
+ */
+static uint32_t runs_merge(mask_run_t * runs, uint32_t cnt, const mask_run_t * runs2, uint32_t cnt2, int32_t x1,
+                           int32_t x2)
+{
+    mask_run_t res[MASK_RUN_MAX];
+    uint32_t res_cnt = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while(i < cnt && j < cnt2) {
+        int32_t end = LV_MIN(runs[i].x2, runs2[j].x2);
+        res_cnt = runs_push(res, res_cnt, x1, x2, end, LV_MIN(runs[i].kind, runs2[j].kind));
+        if(runs[i].x2 == end) i++;
+        if(runs2[j].x2 == end) j++;
+    }
+
+    lv_memcpy_small(runs, res, res_cnt * sizeof(mask_run_t));
+    return res_cnt;
+}
+
+/*Follows `lv_draw_mask_radius`*/
+static uint32_t radius_runs(void * param, int32_t x1, int32_t x2, int32_t y, mask_run_t * runs)
+{
+    lv_draw_mask_radius_param_t * p = param;
+    const lv_area_t * rect = &p->cfg.rect;
+    int32_t radius = p->cfg.radius;
+    uint8_t in = p->cfg.outer ? MASK_RUN_TRANSP : MASK_RUN_COVER;
+    uint8_t out = p->cfg.outer ? MASK_RUN_COVER : MASK_RUN_TRANSP;
+
+    if(y < rect->y1 || y > rect->y2) return runs_push(runs, 0, x1, x2, x2, out);
+
+    uint32_t cnt = 0;
+    if(y >= rect->y1 + radius && y <= rect->y2 - radius) {
+        cnt = runs_push(runs, cnt, x1, x2, rect->x1 - 1, out);
+        cnt = runs_push(runs, cnt, x1, x2, rect->x2, in);
+        return runs_push(runs, cnt, x1, x2, x2, out);
+    }
+
+    int32_t w = lv_area_get_width(rect);
+    int32_t h = lv_area_get_height(rect);
+    int32_t rel_y = y - rect->y1;
+    lv_coord_t cir_y = rel_y < radius ? radius - rel_y - 1 : rel_y - (h - radius);
+    lv_coord_t aa_len;
+    lv_coord_t x_start;
+    get_next_line(p->circle, cir_y, &aa_len, &x_start);
+
+    /*The last anti-aliased pixel on the left and the first on the right*/
+    int32_t aa_left = rect->x1 + radius - x_start - 1;
+    int32_t aa_right = rect->x1 + w - radius + x_start;
+    cnt = runs_push(runs, cnt, x1, x2, aa_left - aa_len, out);
+    if(aa_right > aa_left + 1) {
+        cnt = runs_push(runs, cnt, x1, x2, aa_left, MASK_RUN_EDGE);
+        cnt = runs_push(runs, cnt, x1, x2, aa_right - 1, in);
+    }
+    cnt = runs_push(runs, cnt, x1, x2, LV_MAX(aa_left, aa_right + aa_len - 1), MASK_RUN_EDGE);
+    return runs_push(runs, cnt, x1, x2, x2, out);
+}
+
+/*Follows `lv_draw_mask_fade`*/
+static uint32_t fade_runs(void * param, int32_t x1, int32_t x2, int32_t y, mask_run_t * runs)
+{
+    lv_draw_mask_fade_param_t * p = param;
+    if(y < p->cfg.coords.y1 || y > p->cfg.coords.y2) return runs_push(runs, 0, x1, x2, x2, MASK_RUN_COVER);
+
+    lv_opa_t opa;
+    if(y <= p->cfg.y_top) opa = p->cfg.opa_top;
+    else if(y >= p->cfg.y_bottom) opa = p->cfg.opa_bottom;
+    else {
+        int16_t opa_diff = p->cfg.opa_bottom - p->cfg.opa_top;
+        int32_t y_diff = p->cfg.y_bottom - p->cfg.y_top + 1;
+        opa = (int32_t)((int32_t)(y - p->cfg.y_top) * opa_diff) / y_diff;
+        opa += p->cfg.opa_top;
+    }
+
+    uint8_t kind = MASK_RUN_EDGE;
+    if(opa >= LV_OPA_MAX) kind = MASK_RUN_COVER;
+    else if(opa <= LV_OPA_MIN) kind = MASK_RUN_TRANSP;
+
+    uint32_t cnt = runs_push(runs, 0, x1, x2, p->cfg.coords.x1 - 1, MASK_RUN_COVER);
+    cnt = runs_push(runs, cnt, x1, x2, p->cfg.coords.x2, kind);
+    return runs_push(runs, cnt, x1, x2, x2, MASK_RUN_COVER);
+}
 
 #endif /*LV_DRAW_COMPLEX*/
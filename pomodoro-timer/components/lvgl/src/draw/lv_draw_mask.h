@@ -49,6 +49,17 @@ typedef struct {
 
 typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[_LV_MASK_MAX_NUM];
 
+/**
+ * Describes a line calculated by `lv_draw_mask_apply_span`.
+ * The pixels out of `x1..x2` are transparent and the pixels on `cover_x1..cover_x2` are not changed by the masks.
+ */
+typedef struct {
+    lv_coord_t x1;          /*The first not transparent pixel (absolute coordinate)*/
+    lv_coord_t x2;          /*The last not transparent pixel (absolute coordinate)*/
+    lv_coord_t cover_x1;    /*The longest not changed run. `cover_x1 > cover_x2` if there is no such run*/
+    lv_coord_t cover_x2;
+} lv_draw_mask_span_t;
+
 
 
 #if LV_DRAW_COMPLEX == 0
@@ -244,6 +255,20 @@ int16_t lv_draw_mask_add(void * param, void * custom_id);
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len);
 
+/**
+ * Apply the added buffers on a line and tell which part of the line is visible and which part is not changed.
+ * Used internally by the library's drawing routines.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param span store the visible and the not changed part of the line here. Can be `NULL`.
+ * @return the same as `lv_draw_mask_apply`
+ */
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_span(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len,
+                                                                 lv_draw_mask_span_t * span);
+
 /**
  * Apply the specified buffers on a line. Used internally by the library's drawing routines.
  * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`.
@@ -293,6 +318,18 @@ void lv_draw_mask_free_param(void * p);
  */
 void _lv_draw_mask_cleanup(void);
 
+/**
+ * Remove all the masks temporarily to draw something independently of them
+ * @param saved the masks are saved here
+ */
+void _lv_draw_mask_save_all(_lv_draw_mask_saved_arr_t saved);
+
+/**
+ * Add the masks again which were removed by `_lv_draw_mask_save_all()`
+ * @param saved the saved masks
+ */
+void _lv_draw_mask_restore_all(const _lv_draw_mask_saved_arr_t saved);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -12,29 +12,57 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "../core/lv_refr.h"
+#include "../core/lv_disp.h"
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
+#define ENTRY_NONE  0xFFFF
 
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+/*Stack of the background decoder thread*/
+#define DECODE_STACK_SIZE   (16 * 1024)
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if _LV_IMG_DECODE_ASYNC
+typedef struct _decode_job_t {
+    struct _decode_job_t * next;
+    lv_img_decoder_dsc_t dsc;   /*Opened by the decoder thread*/
+    const void * src;           /*Source to open. Copy of the path for files because the caller's might be freed*/
+    lv_color_t color;
+    int32_t frame_id;
+    lv_res_t res;
+    uint16_t entry_id;          /*Entry to store the image in. ENTRY_NONE if the entry was closed meanwhile.*/
+} decode_job_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t get_hash(const void * src, lv_color_t color, int32_t frame_id);
+    static void entry_close(uint16_t id);
+    static void lru_unlink(uint16_t id);
+    static void lru_push_front(uint16_t id);
+    static void lru_push_back(uint16_t id);
+    static void limit_size(uint16_t keep_id);
+    static uint32_t get_refr_mark(void);
+    static void entry_add(uint16_t id, uint32_t hash);
+    static uint32_t get_decoded_size(const lv_img_decoder_dsc_t * dsc);
+#endif
+
+#if _LV_IMG_DECODE_ASYNC
+    static bool decode_async_needed(const void * src);
+    static lv_res_t decode_async_start(uint16_t id, const void * src, lv_color_t color, int32_t frame_id);
+    static void decode_thread(void * user_data);
+    static void decode_timer_cb(lv_timer_t * timer);
+    static void decode_done(decode_job_t * job);
+    static void job_drop(decode_job_t * job);
+    static void job_list_free(decode_job_t * job);
+    static bool disp_is_valid(const lv_disp_t * disp);
 #endif
 
 /**********************
@@ -42,11 +70,30 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * buckets;      /*Stored after the entries in `_lv_img_cache_array`*/
+    static uint32_t bucket_mask;
+    static uint16_t lru_head;       /*The most recently used entry*/
+    static uint16_t lru_tail;       /*The least recently used or a free entry*/
+    static uint32_t refr_cnt = 1;
+    static lv_img_cache_stats_t stats = {.max_size = LV_IMG_CACHE_MAX_BYTES};
+#endif
+
+#if _LV_IMG_DECODE_ASYNC
+    static bool decode_thread_started;
+    static lv_thread_t decode_thread_handle;
+    static bool decode_stop;                /*Ask the decoder thread to return. Protected by `decode_lock`.*/
+    static lv_mutex_t decode_lock;          /*Protects the job lists*/
+    static lv_thread_sync_t decode_sync;    /*Wakes up the decoder thread*/
+    static decode_job_t * jobs_todo;        /*Jobs in the order of creation*/
+    static decode_job_t * jobs_done;        /*Finished jobs in any order*/
+    static uint32_t jobs_running;           /*Jobs created but not processed by `decode_timer_cb` yet*/
+    static lv_timer_t * decode_timer;
 #endif
 
 /**********************
  *      MACROS
  **********************/
+#define CACHE   LV_GC_ROOT(_lv_img_cache_array)
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -62,7 +109,6 @@
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
 {
-    /*Is the image cached?*/
     _lv_img_cache_entry_t * cached_src = NULL;
 
 #if LV_IMG_CACHE_DEF_SIZE
@@ -71,50 +117,63 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         return NULL;
     }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+    /*Is the image cached?*/
+    uint32_t hash = get_hash(src, color, frame_id);
+    uint16_t id;
+    for(id = buckets[hash & bucket_mask]; id != ENTRY_NONE; id = CACHE[id].hash_next) {
+        cached_src = &CACHE[id];
+        if(cached_src->hash == hash &&
+           color.full == cached_src->dec_dsc.color.full &&
+           frame_id == cached_src->dec_dsc.frame_id &&
+           lv_img_cache_match(src, cached_src->dec_dsc.src)) {
+            lru_unlink(id);
+            lru_push_front(id);
+            cached_src->refr_cnt = get_refr_mark();
+            stats.hit_cnt++;
             LV_LOG_TRACE("image source found in the cache");
-            break;
+            return cached_src;
         }
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    /*The image is not cached then cache it now.
+     *Reuse the least recently used entry which was not drawn in this refresh. Free entries are at the end.*/
+    stats.miss_cnt++;
+    uint16_t oldest_id = ENTRY_NONE;
+    for(id = lru_tail; id != ENTRY_NONE; id = CACHE[id].lru_prev) {
+        /*The images being decoded can't be closed*/
+        if(CACHE[id].decoding) continue;
+        if(CACHE[id].dec_dsc.src == NULL || CACHE[id].refr_cnt != refr_cnt) break;
+        if(oldest_id == ENTRY_NONE) oldest_id = id;
+    }
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+    /*All images are drawn in this refresh, there is no better choice than the oldest*/
+    if(id == ENTRY_NONE) id = oldest_id;
+    if(id == ENTRY_NONE) {
+        LV_LOG_WARN("lv_img_cache_open: all entries are being decoded");
+        return NULL;
     }
+    cached_src = &CACHE[id];
 
     /*Close the decoder to reuse if it was opened (has a valid source)*/
     if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
+        /*The image might be still read in the background*/
+        lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+        if(disp) lv_draw_wait_for_finish(disp->driver->draw_ctx);
+        entry_close(id);
+        stats.evict_cnt++;
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
     else {
         LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
+
+#if _LV_IMG_DECODE_ASYNC
+    if(decode_async_needed(src)) {
+        if(decode_async_start(id, src, color, frame_id) != LV_RES_OK) return NULL;
+        entry_add(id, hash);
+        return cached_src;
+    }
+#endif
 #else
     cached_src = &LV_GC_ROOT(_lv_img_cache_single);
 #endif
@@ -123,13 +182,14 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
-        lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
+        lv_memset_00(&cached_src->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+#if LV_IMG_CACHE_DEF_SIZE
+        lru_unlink(id);
+        lru_push_back(id);
+#endif
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -137,6 +197,11 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    stats.decode_time += cached_src->dec_dsc.time_to_open;
+    entry_add(id, hash);
+#endif
+
     return cached_src;
 }
 
@@ -152,23 +217,36 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
-    if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
+    if(CACHE != NULL) {
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
-        lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        lv_mem_free(CACHE);
     }
 
+    /*Use at least twice as many hash buckets as entries to keep the chains short*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < 2 * (uint32_t)new_entry_cnt) bucket_cnt <<= 1;
+
     /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
+    CACHE = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt + sizeof(uint16_t) * bucket_cnt);
+    LV_ASSERT_MALLOC(CACHE);
+    if(CACHE == NULL) {
         entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
+    buckets = (uint16_t *)&CACHE[entry_cnt];
+    bucket_mask = bucket_cnt - 1;
 
     /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_00(CACHE, entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_ff(buckets, bucket_cnt * sizeof(uint16_t));
+    lru_head = ENTRY_NONE;
+    lru_tail = ENTRY_NONE;
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) lru_push_back(i);
+    stats.used_size = 0;
+    stats.entry_cnt = 0;
 #endif
 }
 
@@ -181,21 +259,136 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+        if(CACHE[i].dec_dsc.src == NULL) continue;
+        if(src == NULL || lv_img_cache_match(src, CACHE[i].dec_dsc.src)) {
+            entry_close(i);
 
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+            /*Reuse it first*/
+            lru_unlink(i);
+            lru_push_back(i);
         }
     }
 #endif
 }
 
+/**
+ * Limit the decoded bytes kept in the cache.
+ * The least recently used images are closed above the limit, except the ones drawn in the current refresh.
+ * @param max_size the limit in bytes, 0: no limit
+ */
+void lv_img_cache_set_max_size(uint32_t max_size)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    stats.max_size = max_size;
+    limit_size(ENTRY_NONE);
+#else
+    LV_UNUSED(max_size);
+#endif
+}
+
+/**
+ * Get the statistics of the image cache.
+ * @param stats_p pointer to a `lv_img_cache_stats_t` variable, the result will be stored here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_p)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    *stats_p = stats;
+#if _LV_IMG_DECODE_ASYNC
+    stats_p->decoding_cnt = jobs_running;
+#endif
+#else
+    lv_memset_00(stats_p, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+/**
+ * Called at the end of a refresh. The images used in the next refresh will be protected.
+ */
+void _lv_img_cache_frame_end(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    refr_cnt++;
+    /*The images drawn in the last refresh might be closed now*/
+    limit_size(ENTRY_NONE);
+#endif
+}
+
+/**
+ * Stop the decoder thread, close the cached images and free the cache.
+ * Called from `lv_deinit()`.
+ */
+void _lv_img_cache_deinit(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+#if _LV_IMG_DECODE_ASYNC
+    if(decode_thread_started) {
+        lv_mutex_lock(&decode_lock);
+        decode_stop = true;
+        lv_mutex_unlock(&decode_lock);
+        lv_thread_sync_signal(&decode_sync);
+        lv_thread_join(&decode_thread_handle);
+
+        lv_thread_sync_delete(&decode_sync);
+        lv_mutex_delete(&decode_lock);
+        decode_thread_started = false;
+        decode_stop = false;
+    }
+#endif
+
+    /*Let the jobs of the closed entries know that their results are not needed*/
+    if(CACHE != NULL) {
+        lv_img_cache_invalidate_src(NULL);
+        lv_mem_free(CACHE);
+        CACHE = NULL;
+    }
+    entry_cnt = 0;
+    refr_cnt = 1;
+    lv_memset_00(&stats, sizeof(stats));
+    stats.max_size = LV_IMG_CACHE_MAX_BYTES;
+
+#if _LV_IMG_DECODE_ASYNC
+    job_list_free(jobs_todo);
+    job_list_free(jobs_done);
+    jobs_todo = NULL;
+    jobs_done = NULL;
+    jobs_running = 0;
+    if(decode_timer) {
+        lv_timer_del(decode_timer);
+        decode_timer = NULL;
+    }
+#endif
+#endif
+}
+
+/**
+ * Remember that a placeholder was drawn for an image being decoded in the background
+ * to redraw the area when the image is ready.
+ * @param entry     pointer to a cache entry with `decoding == 1`
+ * @param area      the area of the placeholder on the display being refreshed
+ */
+void _lv_img_cache_add_redraw_area(_lv_img_cache_entry_t * entry, const lv_area_t * area)
+{
+#if _LV_IMG_DECODE_ASYNC
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(entry->redraw_disp == NULL) {
+        entry->redraw_disp = disp;
+        entry->redraw_area = *area;
+    }
+    else if(entry->redraw_disp == disp) {
+        _lv_area_join(&entry->redraw_area, &entry->redraw_area, area);
+    }
+    else {
+        entry->redraw_all_disp = 1;
+    }
+#else
+    LV_UNUSED(entry);
+    LV_UNUSED(area);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,4 +405,342 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/*FNV-1a of the path or the address of the variable, mixed with the color and frame*/
+static uint32_t get_hash(const void * src, lv_color_t color, int32_t frame_id)
+{
+    uint32_t h = 2166136261u;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        h ^= (uint32_t)((lv_uintptr_t)src >> 2);
+        h *= 16777619u;
+    }
+    else {
+        const uint8_t * txt = src;
+        while(*txt) {
+            h ^= *txt;
+            h *= 16777619u;
+            txt++;
+        }
+    }
+
+    h ^= (uint32_t)color.full;
+    h *= 16777619u;
+    h ^= (uint32_t)frame_id;
+    h *= 16777619u;
+    return h ^ (h >> 16);
+}
+
+/*Close the image and remove it from the hash table. It stays in the LRU list.*/
+static void entry_close(uint16_t id)
+{
+    _lv_img_cache_entry_t * entry = &CACHE[id];
+    uint16_t * link = &buckets[entry->hash & bucket_mask];
+    while(*link != id) link = &CACHE[*link].hash_next;
+    *link = entry->hash_next;
+
+#if _LV_IMG_DECODE_ASYNC
+    if(entry->decoding) {
+        /*The job owns the source, just let it know that its result is not needed*/
+        ((decode_job_t *)entry->job)->entry_id = ENTRY_NONE;
+        entry->decoding = 0;
+        entry->job = NULL;
+    }
+    else if(entry->dec_dsc.decoder == NULL && entry->dec_dsc.src_type == LV_IMG_SRC_FILE) {
+        /*Couldn't be decoded in the background, only the path is stored*/
+        lv_mem_free((void *)entry->dec_dsc.src);
+    }
+    else
+#endif
+    {
+        lv_img_decoder_close(&entry->dec_dsc);
+    }
+    stats.used_size -= entry->size;
+    stats.entry_cnt--;
+
+    lv_memset_00(&entry->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+    entry->size = 0;
+    entry->hash_next = ENTRY_NONE;
+#if _LV_IMG_DECODE_ASYNC
+    entry->redraw_disp = NULL;
+    entry->redraw_all_disp = 0;
+#endif
+}
+
+/*Add an opened (or being opened) image to the hash table and make it the most recently used*/
+static void entry_add(uint16_t id, uint32_t hash)
+{
+    _lv_img_cache_entry_t * entry = &CACHE[id];
+
+    entry->size = get_decoded_size(&entry->dec_dsc);
+    entry->hash = hash;
+    entry->hash_next = buckets[hash & bucket_mask];
+    buckets[hash & bucket_mask] = id;
+    entry->refr_cnt = get_refr_mark();
+    lru_unlink(id);
+    lru_push_front(id);
+    stats.used_size += entry->size;
+    stats.entry_cnt++;
+
+    limit_size(id);
+}
+
+static void lru_unlink(uint16_t id)
+{
+    _lv_img_cache_entry_t * entry = &CACHE[id];
+    if(entry->lru_prev != ENTRY_NONE) CACHE[entry->lru_prev].lru_next = entry->lru_next;
+    else lru_head = entry->lru_next;
+    if(entry->lru_next != ENTRY_NONE) CACHE[entry->lru_next].lru_prev = entry->lru_prev;
+    else lru_tail = entry->lru_prev;
+}
+
+static void lru_push_front(uint16_t id)
+{
+    CACHE[id].lru_prev = ENTRY_NONE;
+    CACHE[id].lru_next = lru_head;
+    if(lru_head != ENTRY_NONE) CACHE[lru_head].lru_prev = id;
+    else lru_tail = id;
+    lru_head = id;
+}
+
+static void lru_push_back(uint16_t id)
+{
+    CACHE[id].lru_next = ENTRY_NONE;
+    CACHE[id].lru_prev = lru_tail;
+    if(lru_tail != ENTRY_NONE) CACHE[lru_tail].lru_next = id;
+    else lru_head = id;
+    lru_tail = id;
+}
+
+/*Close the least recently used images until the decoded size fits into the limit*/
+static void limit_size(uint16_t keep_id)
+{
+    if(stats.max_size == 0) return;
+
+    uint16_t id = lru_tail;
+    while(stats.used_size > stats.max_size && id != ENTRY_NONE) {
+        uint16_t prev = CACHE[id].lru_prev;
+        _lv_img_cache_entry_t * entry = &CACHE[id];
+        if(entry->dec_dsc.src && entry->size && id != keep_id && entry->refr_cnt != refr_cnt) {
+            entry_close(id);
+            stats.evict_cnt++;
+            lru_unlink(id);
+            lru_push_back(id);
+        }
+        id = prev;
+    }
+}
+
+/*Count only the decoded images, not the ones drawn directly from their source*/
+static uint32_t get_decoded_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->img_data == NULL) return 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    /*The decoders of the RAW formats (e.g. PNG in a C array) give true color images*/
+    lv_img_cf_t cf = dsc->header.cf;
+    if(cf == LV_IMG_CF_RAW_ALPHA) cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    else if(cf == LV_IMG_CF_RAW || cf == LV_IMG_CF_RAW_CHROMA_KEYED) cf = LV_IMG_CF_TRUE_COLOR;
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, cf);
+}
+
+/*Only the images drawn in the ongoing refresh are protected*/
+static uint32_t get_refr_mark(void)
+{
+    return _lv_refr_get_disp_refreshing() ? refr_cnt : 0;
+}
+#endif
+
+#if _LV_IMG_DECODE_ASYNC
+/*Decode only the large images which are not drawn directly from a C array*/
+static bool decode_async_needed(const void * src)
+{
+    lv_img_header_t header;
+    if(lv_img_decoder_get_info(src, &header) != LV_RES_OK) return false;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE &&
+       header.cf != LV_IMG_CF_RAW && header.cf != LV_IMG_CF_RAW_ALPHA && header.cf != LV_IMG_CF_RAW_CHROMA_KEYED) {
+        return false;
+    }
+
+    return (uint32_t)header.w * header.h >= LV_IMG_DECODE_ASYNC_MIN_PX;
+}
+
+/*Give the image to the decoder thread. The entry stores only the key of the image until it's decoded.*/
+static lv_res_t decode_async_start(uint16_t id, const void * src, lv_color_t color, int32_t frame_id)
+{
+    if(!decode_thread_started) {
+        if(lv_mutex_init(&decode_lock) != LV_RES_OK) return LV_RES_INV;
+        if(lv_thread_sync_init(&decode_sync) != LV_RES_OK) return LV_RES_INV;
+        if(lv_thread_init(&decode_thread_handle, decode_thread, DECODE_STACK_SIZE, NULL) != LV_RES_OK) {
+            return LV_RES_INV;
+        }
+        decode_thread_started = true;
+    }
+
+    if(decode_timer == NULL) {
+        decode_timer = lv_timer_create(decode_timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+        LV_ASSERT_MALLOC(decode_timer);
+        if(decode_timer == NULL) return LV_RES_INV;
+    }
+
+    decode_job_t * job = lv_mem_alloc(sizeof(decode_job_t));
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return LV_RES_INV;
+    lv_memset_00(job, sizeof(decode_job_t));
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) {
+        size_t len = strlen(src) + 1;
+        job->src = lv_mem_alloc(len);
+        LV_ASSERT_MALLOC(job->src);
+        if(job->src == NULL) {
+            lv_mem_free(job);
+            return LV_RES_INV;
+        }
+        lv_memcpy((void *)job->src, src, len);
+    }
+    else {
+        job->src = src;
+    }
+    job->color = color;
+    job->frame_id = frame_id;
+    job->entry_id = id;
+
+    /*Store the key to find the entry*/
+    _lv_img_cache_entry_t * entry = &CACHE[id];
+    entry->dec_dsc.src = job->src;
+    entry->dec_dsc.src_type = src_type;
+    entry->dec_dsc.color = color;
+    entry->dec_dsc.frame_id = frame_id;
+    entry->decoding = 1;
+    entry->job = job;
+
+    lv_mutex_lock(&decode_lock);
+    decode_job_t ** tail = &jobs_todo;
+    while(*tail) tail = &(*tail)->next;
+    *tail = job;
+    lv_mutex_unlock(&decode_lock);
+    lv_thread_sync_signal(&decode_sync);
+
+    jobs_running++;
+    lv_timer_resume(decode_timer);
+    return LV_RES_OK;
+}
+
+/*Runs in its own thread until `_lv_img_cache_deinit()`.
+ *Only the decoders and the thread safe `lv_mem_alloc()` & co. are used here.*/
+static void decode_thread(void * user_data)
+{
+    LV_UNUSED(user_data);
+    while(1) {
+        lv_thread_sync_wait(&decode_sync);
+        while(1) {
+            lv_mutex_lock(&decode_lock);
+            bool stop = decode_stop;
+            decode_job_t * job = stop ? NULL : jobs_todo;
+            if(job) jobs_todo = job->next;
+            lv_mutex_unlock(&decode_lock);
+            if(stop) return;
+            if(job == NULL) break;
+
+            uint32_t t_start = lv_tick_get();
+            job->res = lv_img_decoder_open(&job->dsc, job->src, job->color, job->frame_id);
+            if(job->res == LV_RES_OK && job->dsc.time_to_open == 0) job->dsc.time_to_open = lv_tick_elaps(t_start);
+
+            lv_mutex_lock(&decode_lock);
+            job->next = jobs_done;
+            jobs_done = job;
+            lv_mutex_unlock(&decode_lock);
+        }
+    }
+}
+
+/*Store the decoded images in the cache and redraw them*/
+static void decode_timer_cb(lv_timer_t * timer)
+{
+    lv_mutex_lock(&decode_lock);
+    decode_job_t * job = jobs_done;
+    jobs_done = NULL;
+    lv_mutex_unlock(&decode_lock);
+
+    while(job) {
+        decode_job_t * next = job->next;
+        decode_done(job);
+        lv_mem_free(job);
+        jobs_running--;
+        job = next;
+    }
+
+    if(jobs_running == 0) lv_timer_pause(timer);
+}
+
+static void decode_done(decode_job_t * job)
+{
+    /*The entry was closed meanwhile*/
+    if(job->entry_id == ENTRY_NONE) {
+        job_drop(job);
+        return;
+    }
+
+    _lv_img_cache_entry_t * entry = &CACHE[job->entry_id];
+    entry->decoding = 0;
+    entry->job = NULL;
+
+    if(job->res == LV_RES_OK) {
+        /*`lv_img_decoder_open` stored its own copy of the path*/
+        if(job->dsc.src_type == LV_IMG_SRC_FILE) lv_mem_free((void *)job->src);
+        entry->dec_dsc = job->dsc;
+        if(entry->dec_dsc.time_to_open == 0) entry->dec_dsc.time_to_open = 1;
+        stats.decode_time += entry->dec_dsc.time_to_open;
+        entry->size = get_decoded_size(&entry->dec_dsc);
+        stats.used_size += entry->size;
+    }
+    else {
+        /*Keep the entry with the error to not try again and again. The path remains owned by the entry.*/
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        entry->dec_dsc.error_msg = "No\ndata";
+    }
+
+    /*Draw the image instead of the placeholder*/
+    if(entry->redraw_all_disp) {
+        lv_disp_t * disp = lv_disp_get_next(NULL);
+        while(disp) {
+            lv_obj_invalidate(lv_disp_get_scr_act(disp));
+            disp = lv_disp_get_next(disp);
+        }
+    }
+    else if(entry->redraw_disp && disp_is_valid(entry->redraw_disp)) {
+        _lv_inv_area(entry->redraw_disp, &entry->redraw_area);
+    }
+    entry->redraw_disp = NULL;
+    entry->redraw_all_disp = 0;
+
+    limit_size(ENTRY_NONE);
+}
+
+/*Free the result and the source of a job whose entry was closed*/
+static void job_drop(decode_job_t * job)
+{
+    if(job->res == LV_RES_OK) lv_img_decoder_close(&job->dsc);
+    if(lv_img_src_get_type(job->src) == LV_IMG_SRC_FILE) lv_mem_free((void *)job->src);
+}
+
+static void job_list_free(decode_job_t * job)
+{
+    while(job) {
+        decode_job_t * next = job->next;
+        job_drop(job);
+        lv_mem_free(job);
+        job = next;
+    }
+}
+
+/*The display of a placeholder might be removed while the image is decoded*/
+static bool disp_is_valid(const lv_disp_t * disp)
+{
+    lv_disp_t * d;
+    for(d = lv_disp_get_next(NULL); d; d = lv_disp_get_next(d)) {
+        if(d == disp) return true;
+    }
+    return false;
+}
 #endif
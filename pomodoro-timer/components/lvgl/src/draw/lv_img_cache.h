@@ -14,10 +14,16 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_img_decoder.h"
+#include "../misc/lv_os.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_IMG_DECODE_ASYNC_MIN_PX && LV_IMG_CACHE_DEF_SIZE && LV_USE_OS != LV_OS_NONE
+#  define _LV_IMG_DECODE_ASYNC  1
+#else
+#  define _LV_IMG_DECODE_ASYNC  0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -31,12 +37,35 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    uint32_t hash;          /**< Hash of the source, color and frame*/
+    uint32_t size;          /**< Decoded bytes kept by the image*/
+    uint32_t refr_cnt;      /**< The refresh the entry was last used in. Not closed for the size limit in it.*/
+    uint16_t hash_next;     /**< Next entry in the same hash bucket*/
+    uint16_t lru_prev;      /**< The more recently used entry*/
+    uint16_t lru_next;      /**< The less recently used entry*/
+    uint8_t decoding : 1;   /**< Being decoded in the background. Draw a placeholder instead.*/
+#if _LV_IMG_DECODE_ASYNC
+    void * job;                         /**< The background decoding job*/
+    struct _lv_disp_t * redraw_disp;    /**< Display on which the placeholder was drawn*/
+    lv_area_t redraw_area;              /**< Area of the placeholder to redraw when the image is decoded*/
+    uint8_t redraw_all_disp : 1;        /**< The placeholder was drawn on more displays*/
+#endif
 } _lv_img_cache_entry_t;
 
+/**
+ * Statistics of the image cache.
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of opens which needed to open the image*/
+    uint32_t evict_cnt;     /**< Number of images closed to make place for others*/
+    uint32_t decode_time;   /**< Sum of the time spent opening images [ms]*/
+    uint32_t used_size;     /**< Decoded bytes kept in the cache*/
+    uint32_t max_size;      /**< Limit of the decoded bytes. 0: no limit*/
+    uint16_t entry_cnt;     /**< Number of cached images*/
+    uint16_t decoding_cnt;  /**< Number of images being decoded in the background*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -67,6 +96,38 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Limit the decoded bytes kept in the cache.
+ * The least recently used images are closed above the limit, except the ones drawn in the current refresh.
+ * @param max_size the limit in bytes, 0: no limit
+ */
+void lv_img_cache_set_max_size(uint32_t max_size);
+
+/**
+ * Get the statistics of the image cache.
+ * @param stats pointer to a `lv_img_cache_stats_t` variable, the result will be stored here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Called at the end of a refresh. The images used in the next refresh will be protected.
+ */
+void _lv_img_cache_frame_end(void);
+
+/**
+ * Stop the decoder thread, close the cached images and free the cache.
+ * Called from `lv_deinit()`.
+ */
+void _lv_img_cache_deinit(void);
+
+/**
+ * Remember that a placeholder was drawn for an image being decoded in the background
+ * to redraw the area when the image is ready.
+ * @param entry     pointer to a cache entry with `decoding == 1`
+ * @param area      the area of the placeholder on the display being refreshed
+ */
+void _lv_img_cache_add_redraw_area(_lv_img_cache_entry_t * entry, const lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
@@ -188,6 +188,8 @@ bool lv_draw_sdl_img_load_texture(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_cache_key
                                   lv_draw_sdl_img_header_t ** header)
 {
     _lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, lv_color_white(), frame_id);
+    /*Not decoded yet: don't cache the missing texture, `lv_draw_img` draws a placeholder*/
+    if(cdsc && cdsc->decoding) return false;
     lv_draw_sdl_cache_flag_t tex_flags = 0;
     SDL_Rect rect;
     SDL_memset(&rect, 0, sizeof(SDL_Rect));
@@ -23,17 +23,53 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_LAYER_POOL_CNT > INT8_MAX
+#error "LV_LAYER_POOL_CNT is too large. `pool_id` of the layers can index at most INT8_MAX buffers"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 struct _lv_disp_drv_t;
 
+/**
+ * A layer buffer kept between the layers and the refreshes
+ */
+typedef struct {
+    void * buf;
+    uint32_t size: 31;
+    uint32_t used : 1;
+} lv_draw_sw_layer_buf_t;
+
+/**
+ * Information about the layer buffers
+ */
+typedef struct {
+    uint32_t budget;        /**< The most memory the kept buffers can use together*/
+    uint32_t kept_size;     /**< Memory used by the kept buffers now*/
+    uint32_t layer_cnt;     /**< Number of layers drawn*/
+    uint32_t strip_cnt;     /**< Number of strips blended. Simple layers can be drawn in more strips.*/
+    uint32_t max_strip_cnt; /**< The most strips a layer was drawn in*/
+    uint32_t hit_cnt;       /**< Number of layers which used a kept buffer without allocation*/
+    uint32_t alloc_cnt;     /**< Number of `lv_mem_alloc()` calls for layer buffers*/
+} lv_draw_sw_layer_pool_stats_t;
+
 typedef struct {
     lv_draw_ctx_t base_draw;
 
     /** Fill an area of the destination buffer with a color*/
     void (*blend)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+    /** Wait only for the background operations which conflict with blending `dsc`.
+     *  If NULL `base_draw.wait_for_finish` is called before each blend.*/
+    void (*blend_sync)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+#if LV_LAYER_POOL_CNT
+    lv_draw_sw_layer_buf_t layer_bufs[LV_LAYER_POOL_CNT];
+    uint32_t layer_pool_budget;     /**< 0: not set, use the size of the display's draw buffer*/
+#endif
+    lv_draw_sw_layer_pool_stats_t layer_stats;
 } lv_draw_sw_ctx_t;
 
 typedef struct {
@@ -41,6 +77,8 @@ typedef struct {
 
     uint32_t buf_size_bytes: 31;
     uint32_t has_alpha : 1;
+    int8_t pool_id;         /**< Index of the kept buffer or -1 if the buffer is allocated only for this layer*/
+    uint16_t strip_cnt;
 } lv_draw_sw_layer_ctx_t;
 
 /**********************
@@ -61,6 +99,9 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
+void lv_draw_sw_letter_line(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                            const lv_draw_label_letter_t * letters, uint32_t letter_cnt);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
                                                   const lv_area_t * coords, const uint8_t * src_buf, lv_img_cf_t cf);
 
@@ -89,6 +130,27 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx);
 
+/**
+ * Set the most memory the kept layer buffers can use together.
+ * Larger layers get a buffer only for themselves.
+ * @param draw_ctx  pointer to a software draw context
+ * @param budget    the budget in bytes. 0: the size of the display's draw buffer in ARGB format (`LV_LAYER_POOL_SIZE`)
+ */
+void lv_draw_sw_layer_pool_set_budget(lv_draw_ctx_t * draw_ctx, uint32_t budget);
+
+/**
+ * Free the kept layer buffers which are not used now
+ * @param draw_ctx  pointer to a software draw context
+ */
+void lv_draw_sw_layer_pool_free(lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Give information about the layer buffers
+ * @param draw_ctx  pointer to a software draw context
+ * @param stats     the result will be stored here
+ */
+void lv_draw_sw_layer_pool_get_stats(lv_draw_ctx_t * draw_ctx, lv_draw_sw_layer_pool_stats_t * stats);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
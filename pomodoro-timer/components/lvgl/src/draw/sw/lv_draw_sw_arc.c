@@ -17,6 +17,9 @@
  *********************/
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater than this the arc will drawn in quarters. A quarter is drawn only if there is arc in it*/
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define ANALYTIC_RADIUS_LIMIT 2000 /*`lv_sqrt` can't handle larger circles, draw them with masks*/
+#define COVER_RUN_MIN 128 /*Fill the fully covered parts of the rows without mask if they are at least this long*/
+#define COVER_RUN_MAX 4   /*Max. number of fully covered parts to fill without mask in a row*/
 
 /**********************
  *      TYPEDEFS
@@ -34,6 +37,53 @@ typedef struct {
     lv_draw_ctx_t * draw_ctx;
 } quarter_draw_dsc_t;
 
+typedef struct {
+    int32_t x;          /*Center relative to the center of the ring [1/16 px]*/
+    int32_t y;
+    lv_area_t area;     /*Bounding box with absolute coordinates*/
+} cap_t;
+
+typedef struct {
+    int32_t r_sq;
+    int32_t b;          /*The half chord in the previous row or -1*/
+} chord_t;
+
+typedef struct {
+    lv_coord_t cx;
+    lv_coord_t cy;
+    bool full;
+    bool wide;          /*The arc is larger than 180 degrees*/
+
+    /*Squared distances of the edges and the factors to get the coverage from them*/
+    int32_t out_full;
+    int32_t out_zero;
+    int32_t out_sq;
+    int32_t out_k;
+    int32_t in_full;
+    int32_t in_sq;
+    int32_t in_k;
+
+    /*The start and end angles in the same units as `lv_trigo_sin`*/
+    int32_t sin_s;
+    int32_t cos_s;
+    int32_t sin_e;
+    int32_t cos_e;
+
+    cap_t caps[2];
+    uint32_t cap_cnt;
+    int32_t cap_sq;
+    int32_t cap_full;
+    int32_t cap_zero;
+    int32_t cap_k;
+
+    /*The current row*/
+    int32_t dy2;
+    int32_t dy_sq;
+    bool cap_on_row[2];
+    lv_coord_t cover_runs[COVER_RUN_MAX][2];    /*The fully covered parts of the current span*/
+    uint32_t cover_run_cnt;
+} arc_cov_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -43,6 +93,17 @@ typedef struct {
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
+    static void draw_arc_analytic(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                                  lv_coord_t radius, lv_coord_t width, uint16_t start_angle, uint16_t end_angle);
+    static void chord_init(chord_t * chord, int32_t r_sq);
+    static int32_t get_half_chord(chord_t * chord, int32_t dy_sq);
+    static void fill_edge(const arc_cov_dsc_t * c, lv_opa_t * mask, lv_coord_t x1, lv_coord_t x2);
+    static void fill_solid(arc_cov_dsc_t * c, lv_opa_t * mask, lv_coord_t x1, lv_coord_t x2);
+    static void add_cover_run(arc_cov_dsc_t * c, lv_coord_t x1, lv_coord_t x2);
+    static void blend_masked(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, lv_opa_t * mask,
+                             lv_coord_t x1, lv_coord_t x2, lv_coord_t y, bool mask_any);
+    static void blend_cover(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                            lv_coord_t x1, lv_coord_t x2, lv_coord_t y);
 #endif /*LV_DRAW_COMPLEX*/
 
 /**********************
@@ -67,6 +128,14 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 
     lv_coord_t width = dsc->width;
     if(width > radius) width = radius;
+    if(width == 0) return;
+
+    /*Calculate the coverage of the pixels directly instead of applying masks on the whole bounding box.
+     *Full discs have no inner edge to skip so the masks are faster for them.*/
+    if(dsc->img_src == NULL && radius <= ANALYTIC_RADIUS_LIMIT && width < radius) {
+        draw_arc_analytic(draw_ctx, dsc, center, radius, width, start_angle, end_angle);
+        return;
+    }
 
     lv_draw_rect_dsc_t cir_dsc;
     lv_draw_rect_dsc_init(&cir_dsc);
@@ -534,4 +603,392 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
     }
 }
 
+/**
+ * Draw an arc by calculating the coverage of each pixel from its signed distance to the edges of the ring and
+ * to the start and end angles. Only the pixels of the ring are visited and the other masks are applied only on them.
+ * Unlike the masks based drawing the rounded ends are merged with the ring, so they are not blended twice.
+ */
+static void draw_arc_analytic(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                              lv_coord_t radius, lv_coord_t width, uint16_t start_angle, uint16_t end_angle)
+{
+    arc_cov_dsc_t c;
+    c.full = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+    while(start_angle >= 360) start_angle -= 360;
+    while(end_angle >= 360) end_angle -= 360;
+
+    c.cx = center->x;
+    c.cy = center->y;
+
+    lv_area_t area;
+    area.x1 = c.cx - radius - 1;
+    area.y1 = c.cy - radius - 1;
+    area.x2 = c.cx + radius;
+    area.y2 = c.cy + radius;
+    if(!c.full) {
+        lv_area_t arc_area;
+        lv_draw_arc_get_area(c.cx, c.cy, radius, start_angle, end_angle, width, dsc->rounded, &arc_area);
+        lv_area_increase(&arc_area, 1, 1);
+        if(!_lv_area_intersect(&area, &area, &arc_area)) return;
+    }
+
+    lv_area_t clip;
+    if(!_lv_area_intersect(&clip, &area, draw_ctx->clip_area)) return;
+
+    /*The distances are measured in 1/2 px from the center of the ring which is between 4 pixels*/
+    int32_t r2 = radius * 2;
+    c.out_full = (r2 - 1) * (r2 - 1);
+    c.out_zero = (r2 + 1) * (r2 + 1);
+    c.out_sq = r2 * r2;
+    c.out_k = (32 << 16) / radius;
+
+    int32_t rin2 = (radius - width) * 2;
+    c.in_full = (rin2 + 1) * (rin2 + 1);
+    c.in_sq = rin2 * rin2;
+    c.in_k = rin2 ? (64 << 16) / rin2 : 0;
+    int32_t hole_sq = rin2 > 2 ? (rin2 - 2) * (rin2 - 2) : 0;
+
+    c.sin_s = lv_trigo_sin(start_angle);
+    c.cos_s = lv_trigo_sin(start_angle + 90);
+    c.sin_e = lv_trigo_sin(end_angle);
+    c.cos_e = lv_trigo_sin(end_angle + 90);
+    int32_t angle_span = end_angle - start_angle;
+    if(angle_span < 0) angle_span += 360;
+    c.wide = angle_span > 180;
+
+    /*The rounded ends are measured in 1/16 px*/
+    c.cap_cnt = 0;
+    int32_t cap_r = width * 8;
+    c.cap_sq = cap_r * cap_r;
+    c.cap_full = cap_r > 8 ? (cap_r - 8) * (cap_r - 8) : -1;
+    c.cap_zero = (cap_r + 8) * (cap_r + 8);
+    c.cap_k = (8 << 16) / cap_r;
+    if(dsc->rounded && !c.full) {
+        uint16_t angles[2] = {start_angle, end_angle};
+        for(c.cap_cnt = 0; c.cap_cnt < 2; c.cap_cnt++) {
+            cap_t * cap = &c.caps[c.cap_cnt];
+            cap->x = ((r2 - width) * lv_trigo_sin(angles[c.cap_cnt] + 90)) >> (LV_TRIGO_SHIFT - 3);
+            cap->y = ((r2 - width) * lv_trigo_sin(angles[c.cap_cnt])) >> (LV_TRIGO_SHIFT - 3);
+            cap->area.x1 = c.cx + ((cap->x - cap_r) >> 4) - 1;
+            cap->area.y1 = c.cy + ((cap->y - cap_r) >> 4) - 1;
+            cap->area.x2 = c.cx + ((cap->x + cap_r) >> 4) + 1;
+            cap->area.y2 = c.cy + ((cap->y + cap_r) >> 4) + 1;
+        }
+    }
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = dsc->opa >= LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+
+    bool mask_any = lv_draw_mask_is_any(&clip);
+    lv_opa_t * mask_buf = lv_mem_buf_get(lv_area_get_width(&clip));
+
+    /*The rows are processed one after the other so the chords can be updated instead of calculated again*/
+    chord_t chord_out;
+    chord_t chord_hole;
+    chord_t chord_out_full;
+    chord_t chord_in_full;
+    chord_init(&chord_out, c.out_zero);
+    chord_init(&chord_hole, hole_sq);
+    chord_init(&chord_out_full, c.out_full);
+    chord_init(&chord_in_full, c.in_full);
+
+    lv_coord_t y;
+    for(y = clip.y1; y <= clip.y2; y++) {
+        c.dy2 = 2 * (y - c.cy) + 1;
+        c.dy_sq = c.dy2 * c.dy2;
+        int32_t b = get_half_chord(&chord_out, c.dy_sq);
+        if(b < 1) continue;
+
+        /*Two spans if the row crosses the hole of the ring*/
+        lv_coord_t spans[2][2];
+        spans[0][0] = c.cx - (b + 1) / 2;
+        spans[0][1] = c.cx + (b - 1) / 2;
+        uint32_t span_cnt = 1;
+        b = get_half_chord(&chord_hole, c.dy_sq);
+        if(b >= 1) {
+            spans[1][0] = c.cx + (b - 1) / 2 + 1;
+            spans[1][1] = spans[0][1];
+            spans[0][1] = c.cx - (b + 1) / 2 - 1;
+            span_cnt = 2;
+        }
+
+        /*The pixels which are not on the edges of the ring. They are on the left and right side of the hole.*/
+        lv_coord_t solid[2][2];
+        int32_t b_out = get_half_chord(&chord_out_full, c.dy_sq);
+        int32_t b_in = get_half_chord(&chord_in_full, c.dy_sq);
+        solid[0][0] = c.cx - (b_out + 1) / 2;
+        solid[0][1] = c.cx - (b_in + 3) / 2;
+        solid[1][0] = c.cx + (b_in + 1) / 2;
+        solid[1][1] = c.cx + (b_out - 1) / 2;
+        if(b_out < 1 || b_in + 1 > b_out) {
+            solid[0][1] = solid[0][0] - 1;
+            solid[1][1] = solid[1][0] - 1;
+        }
+
+        uint32_t i;
+        for(i = 0; i < c.cap_cnt; i++) c.cap_on_row[i] = y >= c.caps[i].area.y1 && y <= c.caps[i].area.y2;
+
+        uint32_t s;
+        for(s = 0; s < span_cnt; s++) {
+            lv_coord_t x1 = LV_MAX(spans[s][0], clip.x1);
+            lv_coord_t x2 = LV_MIN(spans[s][1], clip.x2);
+            if(x1 > x2) continue;
+
+            lv_coord_t x = x1;
+            c.cover_run_cnt = 0;
+            for(i = 0; i < 2; i++) {
+                lv_coord_t sx1 = LV_MAX(solid[i][0], x);
+                lv_coord_t sx2 = LV_MIN(solid[i][1], x2);
+                if(sx1 > sx2) continue;
+                if(sx1 > x) fill_edge(&c, &mask_buf[x - x1], x, sx1 - 1);
+                fill_solid(&c, &mask_buf[sx1 - x1], sx1, sx2);
+                x = sx2 + 1;
+            }
+            if(x <= x2) fill_edge(&c, &mask_buf[x - x1], x, x2);
+
+            /*Long fully covered parts are filled without mask, the rest is blended with mask*/
+            lv_coord_t masked_x1 = x1;
+            for(i = 0; i < c.cover_run_cnt && !mask_any; i++) {
+                lv_coord_t cx1 = c.cover_runs[i][0];
+                lv_coord_t cx2 = c.cover_runs[i][1];
+                if(cx2 - cx1 + 1 < COVER_RUN_MIN) continue;
+                blend_masked(draw_ctx, &blend_dsc, &mask_buf[masked_x1 - x1], masked_x1, cx1 - 1, y, false);
+                blend_cover(draw_ctx, &blend_dsc, cx1, cx2, y);
+                masked_x1 = cx2 + 1;
+            }
+            blend_masked(draw_ctx, &blend_dsc, &mask_buf[masked_x1 - x1], masked_x1, x2, y, mask_any);
+        }
+    }
+
+    lv_mem_buf_release(mask_buf);
+}
+
+static void chord_init(chord_t * chord, int32_t r_sq)
+{
+    chord->r_sq = r_sq;
+    chord->b = -1;
+}
+
+/**
+ * Get the largest `dx` for which `dx^2 + dy_sq <= r_sq`. As the rows are next to each other, the previous result
+ * needs to be adjusted only a little.
+ * @return the half chord or -1 if the row doesn't cross the circle
+ */
+static int32_t get_half_chord(chord_t * chord, int32_t dy_sq)
+{
+    int32_t v = chord->r_sq - dy_sq;
+    if(v < 0) {
+        chord->b = -1;
+        return -1;
+    }
+
+    int32_t b = chord->b;
+    if(b < 0) {
+        lv_sqrt_res_t res;
+        lv_sqrt(v, &res, v < (1 << 16) ? 0x800 : 0x8000);
+        b = res.i;
+    }
+    while(b * b > v) b--;
+    while((b + 1) * (b + 1) <= v) b++;
+
+    chord->b = b;
+    return b;
+}
+
+/**
+ * Calculate the coverage of each pixel in a part of a row.
+ * The coverages are 256 * distance + 128, where the distance from the edge is in px.
+ */
+static void fill_edge(const arc_cov_dsc_t * c, lv_opa_t * mask, lv_coord_t x1, lv_coord_t x2)
+{
+    /*Use local variables as writing the mask could change anything for the compiler*/
+    int32_t out_full = c->out_full;
+    int32_t out_sq = c->out_sq;
+    int32_t out_k = c->out_k;
+    int32_t in_full = c->in_full;
+    int32_t in_sq = c->in_sq;
+    int32_t in_k = c->in_k;
+    int32_t step_s = -2 * c->sin_s;
+    int32_t step_e = 2 * c->sin_e;
+    bool angle = !c->full;
+    bool wide = c->wide;
+
+    int32_t dx2 = 2 * (x1 - c->cx) + 1;
+    int32_t d_sq = dx2 * dx2 + c->dy_sq;
+    int32_t dist_s = c->cos_s * c->dy2 - c->sin_s * dx2;
+    int32_t dist_e = c->sin_e * dx2 - c->cos_e * c->dy2;
+    lv_coord_t x;
+    for(x = x1; x <= x2; x++) {
+        int32_t cov;
+        if(d_sq <= out_full) cov = LV_OPA_COVER;
+        else cov = LV_CLAMP(0, (((out_sq - d_sq) * out_k) >> 16) + 128, LV_OPA_COVER);
+
+        if(cov && d_sq < in_full) {
+            int32_t cov_in = LV_CLAMP(0, (((d_sq - in_sq) * in_k) >> 16) + 128, LV_OPA_COVER);
+            cov = LV_UDIV255(cov * cov_in);
+        }
+
+        if(cov && angle) {
+            int32_t cov_s = LV_CLAMP(0, (dist_s >> 8) + 128, LV_OPA_COVER);
+            int32_t cov_e = LV_CLAMP(0, (dist_e >> 8) + 128, LV_OPA_COVER);
+            int32_t cov_a = wide ? LV_MAX(cov_s, cov_e) : (int32_t)LV_UDIV255(cov_s * cov_e);
+            cov = LV_UDIV255(cov * cov_a);
+        }
+
+        mask[x - x1] = (lv_opa_t)cov;
+
+        d_sq += 4 * dx2 + 4;
+        dx2 += 2;
+        dist_s += step_s;
+        dist_e += step_e;
+    }
+
+    /*Add the rounded ends*/
+    uint32_t i;
+    for(i = 0; i < c->cap_cnt; i++) {
+        const cap_t * cap = &c->caps[i];
+        if(!c->cap_on_row[i]) continue;
+        lv_coord_t cap_x1 = LV_MAX(x1, cap->area.x1);
+        lv_coord_t cap_x2 = LV_MIN(x2, cap->area.x2);
+        int32_t cap_sq = c->cap_sq;
+        int32_t cap_full = c->cap_full;
+        int32_t cap_zero = c->cap_zero;
+        int32_t cap_k = c->cap_k;
+        int32_t px = (2 * (cap_x1 - c->cx) + 1) * 8 - cap->x;
+        int32_t py = c->dy2 * 8 - cap->y;
+        int32_t py_sq = py * py;
+        for(x = cap_x1; x <= cap_x2; x++) {
+            int32_t cap_d_sq = px * px + py_sq;
+            px += 16;
+            if(cap_d_sq >= cap_zero) continue;
+            int32_t cov_cap = LV_OPA_COVER;
+            if(cap_d_sq > cap_full) cov_cap = LV_CLAMP(0, (((cap_sq - cap_d_sq) * cap_k) >> 16) + 128, LV_OPA_COVER);
+            if(cov_cap > mask[x - x1]) mask[x - x1] = (lv_opa_t)cov_cap;
+        }
+    }
+}
+
+/**
+ * Fill a part of a row which is fully covered by the ring. As the coverage of the start and end angles changes
+ * monotonously along the row, the part is fully covered or transparent if it's so on both ends.
+ * Else it's halved until it gets short.
+ */
+static void fill_solid(arc_cov_dsc_t * c, lv_opa_t * mask, lv_coord_t x1, lv_coord_t x2)
+{
+    if(c->full) {
+        lv_memset_ff(mask, x2 - x1 + 1);
+        add_cover_run(c, x1, x2);
+        return;
+    }
+
+    int32_t dx2_1 = 2 * (x1 - c->cx) + 1;
+    int32_t dx2_2 = 2 * (x2 - c->cx) + 1;
+    int32_t s1 = c->cos_s * c->dy2 - c->sin_s * dx2_1;
+    int32_t s2 = c->cos_s * c->dy2 - c->sin_s * dx2_2;
+    int32_t e1 = c->sin_e * dx2_1 - c->cos_e * c->dy2;
+    int32_t e2 = c->sin_e * dx2_2 - c->cos_e * c->dy2;
+
+    /*The coverage is 0 or 255 beyond these distances*/
+    const int32_t lim = 127 << 8;
+    bool s_cover = s1 >= lim && s2 >= lim;
+    bool e_cover = e1 >= lim && e2 >= lim;
+    bool s_transp = s1 < -lim && s2 < -lim;
+    bool e_transp = e1 < -lim && e2 < -lim;
+
+    bool cover = c->wide ? s_cover || e_cover : s_cover && e_cover;
+    bool transp = c->wide ? s_transp && e_transp : s_transp || e_transp;
+    if(cover) {
+        lv_memset_ff(mask, x2 - x1 + 1);
+        add_cover_run(c, x1, x2);
+        return;
+    }
+
+    if(transp) {
+        /*The rounded ends can be still there*/
+        bool cap = false;
+        uint32_t i;
+        for(i = 0; i < c->cap_cnt; i++) {
+            if(c->cap_on_row[i] && x1 <= c->caps[i].area.x2 && x2 >= c->caps[i].area.x1) cap = true;
+        }
+        if(!cap) {
+            lv_memset_00(mask, x2 - x1 + 1);
+            return;
+        }
+    }
+
+    if(x2 - x1 < 16) {
+        fill_edge(c, mask, x1, x2);
+        return;
+    }
+
+    lv_coord_t xm = x1 + (x2 - x1) / 2;
+    fill_solid(c, mask, x1, xm);
+    fill_solid(c, &mask[xm + 1 - x1], xm + 1, x2);
+}
+
+/**
+ * Save a fully covered part of the span. It's merged with the previous part if they are next to each other.
+ */
+static void add_cover_run(arc_cov_dsc_t * c, lv_coord_t x1, lv_coord_t x2)
+{
+    if(c->cover_run_cnt > 0 && c->cover_runs[c->cover_run_cnt - 1][1] + 1 == x1) {
+        c->cover_runs[c->cover_run_cnt - 1][1] = x2;
+    }
+    else if(c->cover_run_cnt < COVER_RUN_MAX) {
+        c->cover_runs[c->cover_run_cnt][0] = x1;
+        c->cover_runs[c->cover_run_cnt][1] = x2;
+        c->cover_run_cnt++;
+    }
+}
+
+/**
+ * Blend a part of a row of the analytic arc with its mask
+ */
+static void blend_masked(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, lv_opa_t * mask,
+                         lv_coord_t x1, lv_coord_t x2, lv_coord_t y, bool mask_any)
+{
+    /*Skip the transparent pixels on the ends*/
+    while(x1 <= x2 && mask[0] == LV_OPA_TRANSP) {
+        mask++;
+        x1++;
+    }
+    while(x2 >= x1 && mask[x2 - x1] == LV_OPA_TRANSP) x2--;
+    if(x1 > x2) return;
+
+    if(mask_any) {
+        lv_draw_mask_res_t res = lv_draw_mask_apply(mask, x1, y, x2 - x1 + 1);
+        if(res == LV_DRAW_MASK_RES_TRANSP) return;
+    }
+
+    lv_area_t blend_area;
+    blend_area.x1 = x1;
+    blend_area.x2 = x2;
+    blend_area.y1 = y;
+    blend_area.y2 = y;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_area = &blend_area;
+    blend_dsc->mask_buf = mask;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+    lv_draw_sw_blend(draw_ctx, blend_dsc);
+}
+
+/**
+ * Fill a fully covered part of a row of the analytic arc
+ */
+static void blend_cover(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                        lv_coord_t x1, lv_coord_t x2, lv_coord_t y)
+{
+    lv_area_t blend_area;
+    blend_area.x1 = x1;
+    blend_area.x2 = x2;
+    blend_area.y1 = y;
+    blend_area.y2 = y;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_buf = NULL;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+    lv_draw_sw_blend(draw_ctx, blend_dsc);
+}
+
 #endif /*LV_DRAW_COMPLEX*/
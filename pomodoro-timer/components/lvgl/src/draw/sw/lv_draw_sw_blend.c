@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
+#include "lv_draw_sw_dither.h"
 
 /*********************
  *      DEFINES
@@ -46,6 +47,13 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
 LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
 
+#if LV_DITHER_BLEND && LV_COLOR_DEPTH == 16
+LV_ATTRIBUTE_FAST_MEM static void blend_dither(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               lv_coord_t dest_stride, const lv_area_t * buf_area, lv_color_t color,
+                                               const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                                               const lv_opa_t * mask, lv_coord_t mask_stride);
+#endif
+
 #if LV_COLOR_SCREEN_TRANSP
 LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                            const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -96,9 +104,11 @@ void lv_draw_sw_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * d
     lv_area_t blend_area;
     if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
 
-    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    if(draw_sw_ctx->blend_sync) draw_sw_ctx->blend_sync(draw_ctx, dsc);
+    else if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
-    ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    draw_sw_ctx->blend(draw_ctx, dsc);
 }
 
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
@@ -178,6 +188,12 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
             map_argb(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride, dsc->blend_mode);
         }
     }
+#endif
+#if LV_DITHER_BLEND && LV_COLOR_DEPTH == 16
+    else if(dsc->blend_mode == LV_BLEND_MODE_NORMAL && (mask || dsc->opa < LV_OPA_MAX)) {
+        blend_dither(dest_buf, &blend_area, dest_stride, draw_ctx->buf_area, dsc->color, src_buf, src_stride, dsc->opa,
+                     mask, mask_stride);
+    }
 #endif
     else if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(dsc->src_buf == NULL) {
@@ -728,6 +744,28 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
 
 
 
+#if LV_DITHER_BLEND && LV_COLOR_DEPTH == 16
+/*The pattern is aligned to the screen (not to the buffer) to keep it in place when only a part is redrawn*/
+LV_ATTRIBUTE_FAST_MEM static void blend_dither(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               lv_coord_t dest_stride, const lv_area_t * buf_area, lv_color_t color,
+                                               const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                                               const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+    int32_t x = dest_area->x1 + buf_area->x1;
+    int32_t y;
+
+    for(y = 0; y < h; y++) {
+        lv_dither_blend_565(&dest_buf->full, src_buf ? &src_buf->full : NULL, color.full, mask, opa,
+                            x, dest_area->y1 + buf_area->y1 + y, w);
+        dest_buf += dest_stride;
+        if(src_buf) src_buf += src_stride;
+        if(mask) mask += mask_stride;
+    }
+}
+#endif
+
 #if LV_COLOR_SCREEN_TRANSP
 LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                            const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -9,11 +9,34 @@
 #include "lv_draw_sw_dither.h"
 #include "lv_draw_sw_gradient.h"
 #include "../../misc/lv_color.h"
+#include "../../misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_COLOR_16_SWAP
+    #define DITHER_SWAP16(c) ((uint16_t)(((c) >> 8) | ((c) << 8)))
+#else
+    #define DITHER_SWAP16(c) (c)
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if _DITHER_GRADIENT || LV_DITHER_BLEND
+static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
+    0,  48, 12, 60,  3, 51, 15, 63,
+    32, 16, 44, 28, 35, 19, 47, 31,
+    8,  56,  4, 52, 11, 59,  7, 55,
+    40, 24, 36, 20, 43, 27, 39, 23,
+    2,  50, 14, 62,  1, 49, 13, 61,
+    34, 18, 46, 30, 33, 17, 45, 29,
+    10, 58,  6, 54,  9, 57,  5, 53,
+    42, 26, 38, 22, 41, 25, 37, 21
+}; /* Shift by 6 to normalize */
+#endif
+
 
 #if _DITHER_GRADIENT
 
@@ -28,17 +51,6 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_none(lv_grad_t * grad, lv_coord_t x, lv_coo
     grad->filled = 1;
 }
 
-static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
-    0,  48, 12, 60,  3, 51, 15, 63,
-    32, 16, 44, 28, 35, 19, 47, 31,
-    8,  56,  4, 52, 11, 59,  7, 55,
-    40, 24, 36, 20, 43, 27, 39, 23,
-    2,  50, 14, 62,  1, 49, 13, 61,
-    34, 18, 46, 30, 33, 17, 45, 29,
-    10, 58,  6, 54,  9, 57,  5, 53,
-    42, 26, 38, 22, 41, 25, 37, 21
-}; /* Shift by 6 to normalize */
-
 
 LV_ATTRIBUTE_FAST_MEM void lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
 {
@@ -211,3 +223,71 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_err_diff_ver(lv_grad_t * grad, lv_coord_t x
 }
 #endif
 #endif
+
+#if LV_DITHER_BLEND
+
+/*Mix two RGB565 colors with 8 bit precision and round the channels up if their fraction is above `t` (2..254)*/
+static inline uint32_t dither_mix_565(uint32_t fg, uint32_t bg, uint32_t a, uint32_t t)
+{
+    uint32_t na = 255 - a;
+    uint32_t r = (fg >> 11) * a + (bg >> 11) * na + t;
+    uint32_t g = ((fg >> 5) & 0x3F) * a + ((bg >> 5) & 0x3F) * na + t;
+    uint32_t b = (fg & 0x1F) * a + (bg & 0x1F) * na + t;
+    return (LV_UDIV255(r) << 11) | (LV_UDIV255(g) << 5) | LV_UDIV255(b);
+}
+
+/*Blend the pixels in groups of 8 with constant thresholds to let the compiler vectorize the inner loop.
+ *`k` is the index of the pixel in the expressions of the foreground color and the opacity.*/
+#define DITHER_BLEND_ROW(fg_px, a_px)                                                                       \
+    do {                                                                                                    \
+        uint32_t j;                                                                                         \
+        int32_t k;                                                                                          \
+        for(; i + 8 <= w; i += 8) {                                                                         \
+            for(j = 0; j < 8; j++) {                                                                        \
+                k = i + j;                                                                                  \
+                dest[k] = DITHER_SWAP16(dither_mix_565(fg_px, DITHER_SWAP16(dest[k]), a_px, thr[j]));       \
+            }                                                                                               \
+        }                                                                                                   \
+        for(j = 0; i < w; i++, j++) {                                                                       \
+            k = i;                                                                                          \
+            dest[k] = DITHER_SWAP16(dither_mix_565(fg_px, DITHER_SWAP16(dest[k]), a_px, thr[j & 7]));       \
+        }                                                                                                   \
+    } while(0)
+
+LV_ATTRIBUTE_FAST_MEM void lv_dither_blend_565(uint16_t * dest, const uint16_t * src, uint16_t color,
+                                               const lv_opa_t * mask, lv_opa_t opa, lv_coord_t x, lv_coord_t y,
+                                               lv_coord_t w)
+{
+    /*The thresholds of the pixels `x..x+7` scaled to 2..254.
+     *A fraction of 254/255 still rounds down so fully opaque pixels keep their exact color.*/
+    uint32_t thr[8];
+    const uint8_t * thr_row = &dither_ordered_threshold_matrix[(y & 7) * 8];
+    int32_t i;
+    for(i = 0; i < 8; i++) {
+        thr[i] = thr_row[(x + i) & 7] * 4 + 2;
+    }
+
+    /*`(mask * opa) >> 8` like in the other blenders, but `opa_mul = 256` keeps the mask as it is*/
+    uint32_t opa_mul = opa >= LV_OPA_MAX ? 256 : opa;
+    uint32_t fg = DITHER_SWAP16(color);
+    i = 0;
+
+    if(src == NULL) {
+        if(mask == NULL) {
+            DITHER_BLEND_ROW(fg, opa);
+        }
+        else {
+            DITHER_BLEND_ROW(fg, (mask[k] * opa_mul) >> 8);
+        }
+    }
+    else {
+        if(mask == NULL) {
+            DITHER_BLEND_ROW(DITHER_SWAP16(src[k]), opa);
+        }
+        else {
+            DITHER_BLEND_ROW(DITHER_SWAP16(src[k]), (mask[k] * opa_mul) >> 8);
+        }
+    }
+}
+
+#endif /*LV_DITHER_BLEND*/
@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "../../core/lv_obj_pos.h"
+#include "../../misc/lv_color.h"
 
 
 /*********************
@@ -62,6 +63,26 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_err_diff_ver(struct _lv_gradient_cache_t *
 #endif /* _DITHER_GRADIENT */
 #endif
 
+#if LV_DITHER_BLEND
+/**
+ * Mix a color or a row of pixels to a row of RGB565 pixels with 8 bit precision per channel
+ * and round the result to RGB565 with an ordered 8x8 dither pattern.
+ * The pixels are in the format of the buffers, i.e. their bytes are swapped if `LV_COLOR_16_SWAP` is enabled.
+ * Pixels with full opacity get exactly the foreground color.
+ * @param dest      the pixels to blend to
+ * @param src       the pixels to blend or NULL to blend `color`
+ * @param color     the color to blend if `src` is NULL
+ * @param mask      opacity of the pixels or NULL to use only `opa`
+ * @param opa       opacity of every pixel
+ * @param x         the screen coordinate of the first pixel to align the pattern to the screen
+ * @param y         the screen coordinate of the row
+ * @param w         number of pixels
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_dither_blend_565(uint16_t * dest, const uint16_t * src, uint16_t color,
+                                               const lv_opa_t * mask, lv_opa_t opa, lv_coord_t x, lv_coord_t y,
+                                               lv_coord_t w);
+#endif
+
 
 #ifdef __cplusplus
 } /*extern "C"*/
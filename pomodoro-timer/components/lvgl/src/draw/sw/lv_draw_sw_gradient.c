@@ -32,19 +32,21 @@
     #error "LV_GRAD_CACHE_DEF_SIZE is too small"
 #endif
 
+#define GRAD_LIFE_MAX   ((1UL << 30) - 1)
+#define GRAD_HASH_MUL   2654435761UL    /*Knuth's multiplicative hash constant*/
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static lv_grad_t * next_in_cache(lv_grad_t * item);
-
-typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
 static size_t get_cache_item_size(lv_grad_t * c);
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
-static lv_res_t find_item(lv_grad_t * c, void * ctx);
-static void free_item(lv_grad_t * c);
+static lv_grad_t * find_item(uint32_t key);
+static void index_insert(lv_grad_t * c);
+static void lru_unlink(lv_grad_t * c);
+static void lru_push_front(lv_grad_t * c);
+static void evict_oldest_item(void);
+static void compact_cache(void);
+static void move_bytes_down(uint8_t * dst, const uint8_t * src, size_t size);
 static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
 
 
@@ -52,7 +54,15 @@ static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h
  *   STATIC VARIABLE
  **********************/
 static size_t    grad_cache_size = 0;
-static uint8_t * grad_cache_end = 0;
+static uint8_t * grad_cache_start = NULL;  /*Start of the item arena, right after the hash index*/
+static uint8_t * grad_cache_end = NULL;    /*End of the last item in the arena*/
+static size_t    grad_cache_used = 0;      /*Bytes used by living items (the rest of the arena is garbage)*/
+static uint32_t  grad_cache_cnt = 0;       /*Number of living items*/
+static lv_grad_t ** grad_index = NULL;     /*Open addressing hash table of the living items*/
+static uint32_t  grad_index_bits = 0;      /*The hash table has (1 << grad_index_bits) slots*/
+static lv_grad_t * grad_lru_head = NULL;   /*Most recently used item*/
+static lv_grad_t * grad_lru_tail = NULL;   /*Least recently used item, evicted first*/
+static lv_grad_cache_stats_t grad_stats;
 
 /**********************
  *   STATIC FUNCTIONS
@@ -81,78 +91,130 @@ static size_t get_cache_item_size(lv_grad_t * c)
     return s;
 }
 
-static lv_grad_t * next_in_cache(lv_grad_t * item)
+static inline uint32_t get_index_mask(void)
 {
-    if(grad_cache_size == 0) return NULL;
-
-    if(item == NULL)
-        return (lv_grad_t *)LV_GC_ROOT(_lv_grad_cache_mem);
+    return ((uint32_t)1 << grad_index_bits) - 1;
+}
 
-    size_t s = get_cache_item_size(item);
-    /*Compute the size for this cache item*/
-    if((uint8_t *)item + s >= grad_cache_end) return NULL;
-    else return (lv_grad_t *)((uint8_t *)item + s);
+static inline uint32_t get_index_slot(uint32_t key)
+{
+    /*The key is mostly a pointer so its low bits are poor. Use the high bits of the product instead.*/
+    return (uint32_t)((key * GRAD_HASH_MUL) & 0xFFFFFFFFUL) >> (32 - grad_index_bits);
 }
 
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out)
+static lv_grad_t * find_item(uint32_t key)
 {
-    lv_grad_t * first = next_in_cache(NULL);
-    while(first != NULL && first->life) {
-        if((*func)(first, ctx) == LV_RES_OK) {
-            if(out != NULL) *out = first;
-            return LV_RES_OK;
-        }
-        first = next_in_cache(first);
+    if(grad_index == NULL) return NULL;
+
+    uint32_t mask = get_index_mask();
+    uint32_t i = get_index_slot(key);
+    while(grad_index[i]) {
+        if(grad_index[i]->key == key) return grad_index[i];
+        i = (i + 1) & mask;
     }
-    return LV_RES_INV;
+    return NULL;
 }
 
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx)
+static void index_insert(lv_grad_t * c)
 {
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life < *min_life) *min_life = c->life;
-    return LV_RES_INV;
+    uint32_t mask = get_index_mask();
+    uint32_t i = get_index_slot(c->key);
+    while(grad_index[i]) i = (i + 1) & mask;
+    grad_index[i] = c;
 }
 
-static void free_item(lv_grad_t * c)
+static void lru_unlink(lv_grad_t * c)
 {
-    size_t size = get_cache_item_size(c);
-    size_t next_items_size = (size_t)(grad_cache_end - (uint8_t *)c) - size;
-    grad_cache_end -= size;
-    if(next_items_size) {
-        uint8_t * old = (uint8_t *)c;
-        lv_memcpy(c, ((uint8_t *)c) + size, next_items_size);
-        /* Then need to fix all internal pointers too */
-        while((uint8_t *)c != grad_cache_end) {
-            c->map = (lv_color_t *)(((uint8_t *)c->map) - size);
-#if _DITHER_GRADIENT
-            c->hmap = (lv_color32_t *)(((uint8_t *)c->hmap) - size);
-#if LV_DITHER_ERROR_DIFFUSION == 1
-            c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - size);
-#endif
-#endif
-            c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
-        }
-        lv_memset_00(old + next_items_size, size);
-    }
+    if(c->lru_prev) c->lru_prev->lru_next = c->lru_next;
+    else grad_lru_head = c->lru_next;
+
+    if(c->lru_next) c->lru_next->lru_prev = c->lru_prev;
+    else grad_lru_tail = c->lru_prev;
+
+    c->lru_prev = NULL;
+    c->lru_next = NULL;
 }
 
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
+static void lru_push_front(lv_grad_t * c)
 {
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life == *min_life) {
-        /*Found, let's kill it*/
-        free_item(c);
-        return LV_RES_OK;
+    c->lru_prev = NULL;
+    c->lru_next = grad_lru_head;
+    if(grad_lru_head) grad_lru_head->lru_prev = c;
+    else grad_lru_tail = c;
+    grad_lru_head = c;
+}
+
+/**
+ * Kill the least recently used item. Its bytes stay in the arena (marked with `life == 0`)
+ * until the next `compact_cache()`, which also rebuilds the hash index.
+ */
+static void evict_oldest_item(void)
+{
+    lv_grad_t * c = grad_lru_tail;
+    if(c == NULL) return;
+
+    size_t s = get_cache_item_size(c);
+    lru_unlink(c);
+    c->life = 0;
+    grad_cache_used -= s;
+    grad_cache_cnt--;
+    grad_stats.evicted_bytes += s;
+    grad_stats.evicted_items++;
+}
+
+/*Move a block towards the start of the arena. Copy in chunks not larger than the gap, so no chunk overlaps itself.*/
+static void move_bytes_down(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    size_t gap = (size_t)(src - dst);
+    while(size) {
+        size_t n = LV_MIN(gap, size);
+        lv_memcpy(dst, src, n);
+        dst += n;
+        src += n;
+        size -= n;
     }
-    return LV_RES_INV;
 }
 
-static lv_res_t find_item(lv_grad_t * c, void * ctx)
+/**
+ * Squeeze out the killed items with a single pass over the arena.
+ * The living items keep their relative order, their internal and LRU pointers are patched as they move
+ * and the hash index is rebuilt on the fly.
+ */
+static void compact_cache(void)
 {
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
-    return LV_RES_INV;
+    lv_memset_00(grad_index, sizeof(lv_grad_t *) << grad_index_bits);
+
+    uint8_t * dst = grad_cache_start;
+    uint8_t * src = grad_cache_start;
+    while(src < grad_cache_end) {
+        lv_grad_t * c = (lv_grad_t *)src;
+        size_t s = get_cache_item_size(c);
+        if(c->life) {
+            if(dst != src) {
+                size_t delta = (size_t)(src - dst);
+                move_bytes_down(dst, src, s);
+                c = (lv_grad_t *)dst;
+                c->map = (lv_color_t *)(((uint8_t *)c->map) - delta);
+#if _DITHER_GRADIENT
+                c->hmap = (lv_color32_t *)(((uint8_t *)c->hmap) - delta);
+#if LV_DITHER_ERROR_DIFFUSION == 1
+                c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - delta);
+#endif
+#endif
+                /*The neighbors either moved already (and patched our links) or are still at their place*/
+                if(c->lru_prev) c->lru_prev->lru_next = c;
+                else grad_lru_head = c;
+                if(c->lru_next) c->lru_next->lru_prev = c;
+                else grad_lru_tail = c;
+            }
+            index_insert(c);
+            dst += s;
+        }
+        src += s;
+    }
+
+    lv_memset_00(dst, (size_t)(grad_cache_end - dst));
+    grad_cache_end = dst;
 }
 
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
@@ -169,31 +231,27 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 #endif
 #endif
 
-    size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
     lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
+    if(req_size <= grad_cache_size) {
+        /*Keep the hash table at most half full*/
+        uint32_t max_cnt = (uint32_t)1 << (grad_index_bits - 1);
+        size_t act_size = (size_t)(grad_cache_end - grad_cache_start);
+        if(act_size + req_size > grad_cache_size || grad_cache_cnt >= max_cnt) {
+            /*Need to evict items from cache until we find enough space to allocate this one */
+            while(grad_cache_used + req_size > grad_cache_size || grad_cache_cnt >= max_cnt) {
+                evict_oldest_item();
+            }
+            compact_cache();
+        }
         item = (lv_grad_t *)grad_cache_end;
         item->not_cached = 0;
     }
     else {
-        /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
-            while(act_size + req_size > grad_cache_size) {
-                uint32_t oldest_life = UINT32_MAX;
-                iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
-                iterate_cache(&kill_oldest_item, &oldest_life, NULL);
-                act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
-            }
-            item = (lv_grad_t *)grad_cache_end;
-            item->not_cached = 0;
-        }
-        else {
-            /*The cache is too small. Allocate the item manually and free it later.*/
-            item = lv_mem_alloc(req_size);
-            LV_ASSERT_MALLOC(item);
-            if(item == NULL) return NULL;
-            item->not_cached = 1;
-        }
+        /*The cache is too small. Allocate the item manually and free it later.*/
+        item = lv_mem_alloc(req_size);
+        LV_ASSERT_MALLOC(item);
+        if(item == NULL) return NULL;
+        item->not_cached = 1;
     }
 
     item->key = compute_key(g, size, w);
@@ -201,29 +259,26 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
     item->filled = 0;
     item->alloc_size = map_size;
     item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-    }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
+    item->lru_prev = NULL;
+    item->lru_next = NULL;
+
+    uint8_t * p = (uint8_t *)item;
+    item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
 #if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
+    item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
+    item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
+                                        ALIGN(map_size * sizeof(lv_color_t)));
+    item->w = w;
 #endif
 #endif
+
+    if(!item->not_cached) {
         grad_cache_end += req_size;
+        grad_cache_used += req_size;
+        grad_cache_cnt++;
+        index_insert(item);
+        lru_push_front(item);
     }
     return item;
 }
@@ -235,16 +290,35 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 void lv_gradient_free_cache(void)
 {
     lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    LV_GC_ROOT(_lv_grad_cache_mem) = grad_cache_end = NULL;
+    LV_GC_ROOT(_lv_grad_cache_mem) = grad_cache_start = grad_cache_end = NULL;
+    grad_index = NULL;
+    grad_index_bits = 0;
     grad_cache_size = 0;
+    grad_cache_used = 0;
+    grad_cache_cnt = 0;
+    grad_lru_head = grad_lru_tail = NULL;
 }
 
 void lv_gradient_set_cache_size(size_t max_bytes)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) = lv_mem_alloc(max_bytes);
+    lv_gradient_free_cache();
+    if(max_bytes == 0) return;
+
+    /*An item is never smaller than its header so this many items can live in the cache at most.
+     *Size the index to twice of that to keep the probe sequences short.*/
+    size_t max_cnt = max_bytes / ALIGN(sizeof(lv_grad_t)) + 1;
+    uint32_t bits = 3;
+    while(((size_t)1 << bits) < 2 * max_cnt) bits++;
+    size_t index_size = ALIGN(sizeof(lv_grad_t *) << bits);
+
+    LV_GC_ROOT(_lv_grad_cache_mem) = lv_mem_alloc(index_size + max_bytes);
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_memset_00(LV_GC_ROOT(_lv_grad_cache_mem), max_bytes);
+    if(LV_GC_ROOT(_lv_grad_cache_mem) == NULL) return;
+    lv_memset_00(LV_GC_ROOT(_lv_grad_cache_mem), index_size + max_bytes);
+
+    grad_index = (lv_grad_t **)LV_GC_ROOT(_lv_grad_cache_mem);
+    grad_index_bits = bits;
+    grad_cache_start = grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) + index_size;
     grad_cache_size = max_bytes;
 }
 
@@ -263,11 +337,17 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     /* Step 1: Search cache for the given key */
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
     uint32_t key = compute_key(g, size, w);
-    lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
-        item->life++; /* Don't forget to bump the counter */
+    lv_grad_t * item = find_item(key);
+    if(item) {
+        if(item->life < GRAD_LIFE_MAX) item->life++; /* Don't forget to bump the counter */
+        if(item != grad_lru_head) {
+            lru_unlink(item);
+            lru_push_front(item);
+        }
+        grad_stats.hits++;
         return item;
     }
+    grad_stats.misses++;
 
     /* Step 2: Need to allocate an item for it */
     item = allocate_item(g, w, h);
@@ -293,6 +373,18 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     return item;
 }
 
+void lv_gradient_get_cache_stats(lv_grad_cache_stats_t * stats)
+{
+    *stats = grad_stats;
+    stats->item_cnt = grad_cache_cnt;
+    stats->used_bytes = grad_cache_used;
+}
+
+void lv_gradient_reset_cache_stats(void)
+{
+    lv_memset_00(&grad_stats, sizeof(grad_stats));
+}
+
 LV_ATTRIBUTE_FAST_MEM lv_grad_color_t lv_gradient_calculate(const lv_grad_dsc_t * dsc, lv_coord_t range,
                                                             lv_coord_t frac)
 {
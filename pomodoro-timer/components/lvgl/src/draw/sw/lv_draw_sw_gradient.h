@@ -40,14 +40,16 @@ typedef lv_color_t lv_grad_color_t;
 typedef struct _lv_gradient_cache_t {
     uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
                                    * If the key does not match, the cache item is not used */
-    uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
+    uint32_t        life : 30;    /**< A life counter that's incremented on usage. 0 marks an evicted item
+                                   * waiting for the cache to be compacted */
     uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
     uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
     lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
                                    * cache's buffer, no free needed */
     lv_coord_t      alloc_size;   /**< The map allocated size in colors */
     lv_coord_t      size;         /**< The computed gradient color map size, in colors */
+    struct _lv_gradient_cache_t * lru_prev; /**< The more recently used neighbor in the cache's LRU list */
+    struct _lv_gradient_cache_t * lru_next; /**< The less recently used neighbor in the cache's LRU list */
 #if _DITHER_GRADIENT
     lv_color32_t  * hmap;         /**< If dithering, we need to store the current, high bitdepth gradient
                                    * map too, points to the cache's buffer, no free needed */
@@ -59,6 +61,16 @@ typedef struct _lv_gradient_cache_t {
 #endif
 } lv_grad_t;
 
+/** Usage statistics of the gradient cache */
+typedef struct {
+    uint32_t hits;                /**< Number of `lv_gradient_get` calls served from the cache */
+    uint32_t misses;              /**< Number of `lv_gradient_get` calls which had to compute the map */
+    uint32_t evicted_items;       /**< Number of items evicted to make room for new ones */
+    size_t evicted_bytes;         /**< Sum of the size of the evicted items */
+    uint32_t item_cnt;            /**< Number of items currently in the cache */
+    size_t used_bytes;            /**< Bytes currently used by the items in the cache */
+} lv_grad_cache_stats_t;
+
 
 /**********************
  *      PROTOTYPES
@@ -84,6 +96,15 @@ void lv_gradient_free_cache(void);
 /** Get a gradient cache from the given parameters */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, lv_coord_t w, lv_coord_t h);
 
+/**
+ * Get the usage statistics of the gradient cache
+ * @param stats     store the result here
+ */
+void lv_gradient_get_cache_stats(lv_grad_cache_stats_t * stats);
+
+/** Reset the hit, miss and eviction counters of the gradient cache */
+void lv_gradient_reset_cache_stats(void);
+
 /**
  * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
  * @param grad      pointer to a gradient
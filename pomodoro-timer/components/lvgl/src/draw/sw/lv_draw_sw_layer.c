@@ -22,6 +22,14 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * buf_take(lv_draw_sw_ctx_t * draw_sw_ctx, lv_draw_sw_layer_ctx_t * layer_sw_ctx, uint32_t size,
+                       uint32_t max_size);
+static void buf_give_back(lv_draw_sw_ctx_t * draw_sw_ctx, lv_draw_sw_layer_ctx_t * layer_sw_ctx);
+#if LV_LAYER_POOL_CNT
+    static uint32_t get_budget(lv_draw_sw_ctx_t * draw_sw_ctx);
+    static uint32_t get_kept_size(lv_draw_sw_ctx_t * draw_sw_ctx);
+    static void free_over_budget(lv_draw_sw_ctx_t * draw_sw_ctx, uint32_t budget);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -48,18 +56,19 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
         return NULL;
     }
 
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
     uint32_t px_size = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t full_size = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
     if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
-        layer_sw_ctx->buf_size_bytes = LV_LAYER_SIMPLE_BUF_SIZE;
-        uint32_t full_size = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
-        if(layer_sw_ctx->buf_size_bytes > full_size) layer_sw_ctx->buf_size_bytes = full_size;
-        layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
+        /*A larger kept buffer can be used entirely to draw the layer in fewer strips*/
+        uint32_t size = LV_MIN(LV_LAYER_SIMPLE_BUF_SIZE, full_size);
+        layer_sw_ctx->base_draw.buf = buf_take(draw_sw_ctx, layer_sw_ctx, size, full_size);
         if(layer_sw_ctx->base_draw.buf == NULL) {
             LV_LOG_WARN("Cannot allocate %"LV_PRIu32" bytes for layer buffer. Allocating %"LV_PRIu32" bytes instead. (Reduced performance)",
-                        (uint32_t)layer_sw_ctx->buf_size_bytes, (uint32_t)LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE * px_size);
-            layer_sw_ctx->buf_size_bytes = LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE;
-            layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
+                        size, (uint32_t)LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE);
+            layer_sw_ctx->base_draw.buf = buf_take(draw_sw_ctx, layer_sw_ctx, LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE,
+                                                   LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE);
             if(layer_sw_ctx->base_draw.buf == NULL) {
                 return NULL;
             }
@@ -72,13 +81,12 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
     }
     else {
         layer_sw_ctx->base_draw.area_act = layer_sw_ctx->base_draw.area_full;
-        layer_sw_ctx->buf_size_bytes = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
-        layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
-        lv_memset_00(layer_sw_ctx->base_draw.buf, layer_sw_ctx->buf_size_bytes);
+        layer_sw_ctx->base_draw.buf = buf_take(draw_sw_ctx, layer_sw_ctx, full_size, full_size);
         layer_sw_ctx->has_alpha = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? 1 : 0;
         if(layer_sw_ctx->base_draw.buf == NULL) {
             return NULL;
         }
+        lv_memset_00(layer_sw_ctx->base_draw.buf, layer_sw_ctx->buf_size_bytes);
 
         draw_ctx->buf = layer_sw_ctx->base_draw.buf;
         draw_ctx->buf_area = &layer_sw_ctx->base_draw.area_act;
@@ -115,7 +123,10 @@ void lv_draw_sw_layer_adjust(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_l
 void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_layer_ctx_t * layer_ctx,
                             const lv_draw_img_dsc_t * draw_dsc)
 {
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+    layer_sw_ctx->strip_cnt++;
+    draw_sw_ctx->layer_stats.strip_cnt++;
 
     lv_img_dsc_t img;
     img.data = draw_ctx->buf;
@@ -139,12 +150,179 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx)
 {
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+
+    draw_sw_ctx->layer_stats.layer_cnt++;
+    if(layer_sw_ctx->strip_cnt > draw_sw_ctx->layer_stats.max_strip_cnt) {
+        draw_sw_ctx->layer_stats.max_strip_cnt = layer_sw_ctx->strip_cnt;
+    }
+
+    buf_give_back(draw_sw_ctx, layer_sw_ctx);
+}
+
+void lv_draw_sw_layer_pool_set_budget(lv_draw_ctx_t * draw_ctx, uint32_t budget)
+{
+#if LV_LAYER_POOL_CNT
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    draw_sw_ctx->layer_pool_budget = budget;
+    free_over_budget(draw_sw_ctx, get_budget(draw_sw_ctx));
+#else
     LV_UNUSED(draw_ctx);
+    LV_UNUSED(budget);
+#endif
+}
 
-    lv_mem_free(layer_ctx->buf);
+void lv_draw_sw_layer_pool_free(lv_draw_ctx_t * draw_ctx)
+{
+#if LV_LAYER_POOL_CNT
+    free_over_budget((lv_draw_sw_ctx_t *) draw_ctx, 0);
+#else
+    LV_UNUSED(draw_ctx);
+#endif
 }
 
+void lv_draw_sw_layer_pool_get_stats(lv_draw_ctx_t * draw_ctx, lv_draw_sw_layer_pool_stats_t * stats)
+{
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    *stats = draw_sw_ctx->layer_stats;
+#if LV_LAYER_POOL_CNT
+    stats->budget = get_budget(draw_sw_ctx);
+    stats->kept_size = get_kept_size(draw_sw_ctx);
+#else
+    stats->budget = 0;
+    stats->kept_size = 0;
+#endif
+}
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Get a buffer for a layer. Use a free kept buffer or grow one if the budget allows it.
+ * Else allocate a buffer only for this layer.
+ * @param draw_sw_ctx   pointer to the draw context
+ * @param layer_sw_ctx  pointer to the layer context. `pool_id` and `buf_size_bytes` will be set.
+ * @param size          the needed size in bytes
+ * @param max_size      a larger kept buffer can be used up to this size
+ * @return              the buffer or NULL on error
+ */
+static void * buf_take(lv_draw_sw_ctx_t * draw_sw_ctx, lv_draw_sw_layer_ctx_t * layer_sw_ctx, uint32_t size,
+                       uint32_t max_size)
+{
+    layer_sw_ctx->pool_id = -1;
+    layer_sw_ctx->buf_size_bytes = size;
+
+#if LV_LAYER_POOL_CNT
+    lv_draw_sw_layer_buf_t * bufs = draw_sw_ctx->layer_bufs;
+    int32_t fit = -1;   /*The smallest free buffer which is large enough*/
+    int32_t grow = -1;  /*The largest free buffer which is too small*/
+    uint32_t kept = 0;
+    int32_t i;
+    for(i = 0; i < LV_LAYER_POOL_CNT; i++) {
+        kept += bufs[i].size;
+        if(bufs[i].used) continue;
+        if(bufs[i].size >= size) {
+            if(fit < 0 || bufs[i].size < bufs[fit].size) fit = i;
+        }
+        else if(grow < 0 || bufs[i].size > bufs[grow].size) {
+            grow = i;
+        }
+    }
+
+    if(fit >= 0) {
+        draw_sw_ctx->layer_stats.hit_cnt++;
+    }
+    else if(grow >= 0 && kept - bufs[grow].size + size <= get_budget(draw_sw_ctx)) {
+        /*Not realloc as the content is not needed*/
+        lv_mem_free(bufs[grow].buf);
+        bufs[grow].buf = lv_mem_alloc(size);
+        bufs[grow].size = bufs[grow].buf ? size : 0;
+        draw_sw_ctx->layer_stats.alloc_cnt++;
+        if(bufs[grow].buf) fit = grow;
+    }
+
+    if(fit >= 0) {
+        bufs[fit].used = 1;
+        layer_sw_ctx->pool_id = fit;
+        layer_sw_ctx->buf_size_bytes = LV_MIN(bufs[fit].size, max_size);
+        return bufs[fit].buf;
+    }
+#else
+    LV_UNUSED(max_size);
+#endif
+
+    draw_sw_ctx->layer_stats.alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static void buf_give_back(lv_draw_sw_ctx_t * draw_sw_ctx, lv_draw_sw_layer_ctx_t * layer_sw_ctx)
+{
+#if LV_LAYER_POOL_CNT
+    if(layer_sw_ctx->pool_id >= 0) {
+        draw_sw_ctx->layer_bufs[layer_sw_ctx->pool_id].used = 0;
+        /*The budget might be reduced while the buffer was used*/
+        free_over_budget(draw_sw_ctx, get_budget(draw_sw_ctx));
+        return;
+    }
+#else
+    LV_UNUSED(draw_sw_ctx);
+#endif
+
+    lv_mem_free(layer_sw_ctx->base_draw.buf);
+}
+
+#if LV_LAYER_POOL_CNT
+
+static uint32_t get_budget(lv_draw_sw_ctx_t * draw_sw_ctx)
+{
+    if(draw_sw_ctx->layer_pool_budget) return draw_sw_ctx->layer_pool_budget;
+    if(LV_LAYER_POOL_SIZE) return LV_LAYER_POOL_SIZE;
+
+    /*Use the draw buffer's size of the display of this draw context*/
+    lv_disp_t * disp = lv_disp_get_next(NULL);
+    while(disp) {
+        if(disp->driver->draw_ctx == &draw_sw_ctx->base_draw) {
+            if(disp->driver->draw_buf == NULL) return 0;
+            return disp->driver->draw_buf->size * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+        disp = lv_disp_get_next(disp);
+    }
+
+    return 0;
+}
+
+static uint32_t get_kept_size(lv_draw_sw_ctx_t * draw_sw_ctx)
+{
+    uint32_t kept = 0;
+    uint32_t i;
+    for(i = 0; i < LV_LAYER_POOL_CNT; i++) kept += draw_sw_ctx->layer_bufs[i].size;
+    return kept;
+}
+
+/**
+ * Free the not used kept buffers, the largest first, until they fit into the budget
+ */
+static void free_over_budget(lv_draw_sw_ctx_t * draw_sw_ctx, uint32_t budget)
+{
+    uint32_t kept = get_kept_size(draw_sw_ctx);
+    while(kept > budget) {
+        int32_t largest = -1;
+        int32_t i;
+        for(i = 0; i < LV_LAYER_POOL_CNT; i++) {
+            lv_draw_sw_layer_buf_t * b = &draw_sw_ctx->layer_bufs[i];
+            if(b->used || b->buf == NULL) continue;
+            if(largest < 0 || b->size > draw_sw_ctx->layer_bufs[largest].size) largest = i;
+        }
+        if(largest < 0) break;
+
+        lv_draw_sw_layer_buf_t * b = &draw_sw_ctx->layer_bufs[largest];
+        kept -= b->size;
+        lv_mem_free(b->buf);
+        b->buf = NULL;
+        b->size = 0;
+    }
+}
+
+#endif /*LV_LAYER_POOL_CNT*/
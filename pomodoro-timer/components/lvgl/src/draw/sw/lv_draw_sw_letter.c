@@ -14,19 +14,35 @@
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
 #include "../../core/lv_refr.h"
+#include "../../extra/others/txt_atlas/lv_txt_atlas.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*The letters of a line are blended together in strips of at most this many pixels*/
+#define LINE_STRIP_MAX_SIZE (8 * 1024)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_font_glyph_dsc_t g;
+    lv_point_t pos;         /*Top left corner of the glyph's bitmap*/
+    lv_area_t area;         /*The visible part of the glyph's bitmap*/
+    uint32_t letter;
+} line_glyph_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+static const uint8_t * get_opa_table(uint32_t bpp, lv_opa_t opa);
+static void line_strip_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, lv_color_t color,
+                             const line_glyph_t * glyphs, uint32_t glyph_cnt, const lv_area_t * strip_area);
+static void glyph_to_strip(const line_glyph_t * lg, const uint8_t * map_p, const uint8_t * opa_table, bool overlap,
+                           lv_opa_t * strip, const lv_area_t * strip_area);
+
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 
@@ -158,10 +174,252 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     }
 }
 
+/**
+ * Draw some letters of a line. The letters with the same color are rendered into
+ * a common mask and blended at once.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           the draw descriptor of the text. Its `color` is not used, each letter has its own.
+ * @param letters       the letters to draw in the order of drawing
+ * @param letter_cnt    number of letters in `letters`
+ */
+void lv_draw_sw_letter_line(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                            const lv_draw_label_letter_t * letters, uint32_t letter_cnt)
+{
+    lv_draw_label_dsc_t dsc_mod = *dsc;
+    line_glyph_t * glyphs = lv_mem_buf_get(letter_cnt * sizeof(line_glyph_t));
+    uint32_t glyph_cnt = 0;
+    lv_area_t strip_area;
+    lv_color_t strip_color = dsc->color;
+
+    uint32_t i;
+    for(i = 0; i < letter_cnt; i++) {
+        const lv_draw_label_letter_t * l = &letters[i];
+        line_glyph_t * lg = &glyphs[glyph_cnt];
+        bool simple = lv_font_get_glyph_dsc(dsc->font, &lg->g, l->letter, '\0');
+        if(simple) {
+            /*Don't draw anything if the character is empty. E.g. space*/
+            if(lg->g.box_w == 0 || lg->g.box_h == 0) continue;
+
+            uint32_t bpp = lg->g.bpp;
+            simple = !lg->g.resolved_font->subpx && (bpp == 1 || bpp == 2 || bpp == 3 || bpp == 4 || bpp == 8) &&
+                     (uint32_t)lg->g.box_w * lg->g.box_h <= LINE_STRIP_MAX_SIZE;
+        }
+
+        /*Draw the other letters (e.g. sub-pixel rendered or missing ones) one by one*/
+        if(!simple) {
+            line_strip_blend(draw_ctx, dsc, strip_color, glyphs, glyph_cnt, &strip_area);
+            glyph_cnt = 0;
+            dsc_mod.color = l->color;
+            lv_draw_sw_letter(draw_ctx, &dsc_mod, &l->pos, l->letter);
+            continue;
+        }
+
+        lv_area_t letter_area;
+        lg->pos.x = l->pos.x + lg->g.ofs_x;
+        lg->pos.y = l->pos.y + (dsc->font->line_height - dsc->font->base_line) - lg->g.box_h - lg->g.ofs_y;
+        lv_area_set(&letter_area, lg->pos.x, lg->pos.y, lg->pos.x + lg->g.box_w - 1, lg->pos.y + lg->g.box_h - 1);
+        if(!_lv_area_intersect(&lg->area, &letter_area, draw_ctx->clip_area)) continue;
+        lg->letter = l->letter;
+
+        /*Start a new strip if the color changes or the strip would be too large*/
+        if(glyph_cnt > 0) {
+            lv_area_t joined_area;
+            _lv_area_join(&joined_area, &strip_area, &lg->area);
+            if(l->color.full == strip_color.full && lv_area_get_size(&joined_area) <= LINE_STRIP_MAX_SIZE) {
+                strip_area = joined_area;
+                glyph_cnt++;
+                continue;
+            }
+
+            line_strip_blend(draw_ctx, dsc, strip_color, glyphs, glyph_cnt, &strip_area);
+            glyphs[0] = *lg;
+            glyph_cnt = 0;
+        }
+
+        strip_area = glyphs[0].area;
+        strip_color = l->color;
+        glyph_cnt = 1;
+    }
+
+    line_strip_blend(draw_ctx, dsc, strip_color, glyphs, glyph_cnt, &strip_area);
+    lv_mem_buf_release(glyphs);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the table to convert the pixels of a glyph's bitmap to opacity
+ * @param bpp       bit per pixel of the bitmap (1, 2, 4 or 8)
+ * @param opa       opacity of the text
+ * @return          the table or NULL if `bpp` is invalid
+ */
+static const uint8_t * get_opa_table(uint32_t bpp, lv_opa_t opa)
+{
+    const uint8_t * bpp_opa_table_p;
+    switch(bpp) {
+        case 1:
+            bpp_opa_table_p = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            bpp_opa_table_p = _lv_bpp2_opa_table;
+            break;
+        case 4:
+            bpp_opa_table_p = _lv_bpp4_opa_table;
+            break;
+        case 8:
+            bpp_opa_table_p = _lv_bpp8_opa_table;
+            break;       /*No opa table, pixel value will be used directly*/
+        default:
+            return NULL; /*Invalid bpp. Can't render the letter*/
+    }
+
+    if(opa >= LV_OPA_MAX) return bpp_opa_table_p;
+
+    static lv_opa_t opa_table[256];
+    static lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static uint32_t prev_bpp = 0;
+    if(prev_opa != opa || prev_bpp != bpp) {
+        uint32_t shades = 1 << bpp;
+        uint32_t i;
+        for(i = 0; i < shades; i++) {
+            opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
+        }
+    }
+    prev_opa = opa;
+    prev_bpp = bpp;
+    return opa_table;
+}
+
+/**
+ * Render glyphs of the same color into a mask and blend it
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           the draw descriptor of the text
+ * @param color         color of the glyphs
+ * @param glyphs        the glyphs to render
+ * @param glyph_cnt     number of glyphs. Nothing happens if 0.
+ * @param strip_area    the joined area of the glyphs
+ */
+static void line_strip_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, lv_color_t color,
+                             const line_glyph_t * glyphs, uint32_t glyph_cnt, const lv_area_t * strip_area)
+{
+    if(glyph_cnt == 0) return;
+
+    uint32_t bpp = glyphs[0].g.bpp == 3 ? 4 : glyphs[0].g.bpp;
+    const uint8_t * opa_table = get_opa_table(bpp, dsc->opa);
+
+    uint32_t strip_size = lv_area_get_size(strip_area);
+    lv_opa_t * strip = lv_mem_buf_get(strip_size);
+    lv_memset_00(strip, strip_size);
+
+    /*The glyphs on the already rendered area need to be combined with the strip*/
+    lv_area_t rendered_area;
+    uint32_t i;
+    for(i = 0; i < glyph_cnt; i++) {
+        const line_glyph_t * lg = &glyphs[i];
+        lv_area_t overlap_area;
+        bool overlap = i > 0 && _lv_area_intersect(&overlap_area, &rendered_area, &lg->area);
+        if(i == 0) rendered_area = lg->area;
+        else _lv_area_join(&rendered_area, &rendered_area, &lg->area);
+
+        /*Use the bitmap right away as some fonts keep only the last one*/
+        const uint8_t * map_p = lv_font_get_glyph_bitmap(lg->g.resolved_font, lg->letter);
+        if(map_p == NULL) {
+            LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
+            continue;
+        }
+
+        uint32_t glyph_bpp = lg->g.bpp == 3 ? 4 : lg->g.bpp;
+        if(glyph_bpp != bpp) {
+            bpp = glyph_bpp;
+            opa_table = get_opa_table(bpp, dsc->opa);
+        }
+
+        glyph_to_strip(lg, map_p, opa_table, overlap, strip, strip_area);
+    }
+
+#if LV_DRAW_COMPLEX
+    /*Apply masks if any*/
+    if(lv_draw_mask_is_any(strip_area)) {
+        lv_coord_t strip_w = lv_area_get_width(strip_area);
+        lv_opa_t * strip_row = strip;
+        lv_coord_t y;
+        for(y = strip_area->y1; y <= strip_area->y2; y++) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(strip_row, strip_area->x1, y, strip_w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(strip_row, strip_w);
+            strip_row += strip_w;
+        }
+    }
+#endif
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = color;
+    blend_dsc.opa = dsc->opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.blend_area = strip_area;
+    blend_dsc.mask_area = strip_area;
+    blend_dsc.mask_buf = strip;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+    lv_mem_buf_release(strip);
+}
+
+/**
+ * Add the visible part of a glyph to the mask of a strip
+ * @param lg            the glyph
+ * @param map_p         bitmap of the glyph
+ * @param opa_table     table to convert the pixels of the bitmap to opacity
+ * @param overlap       true: other glyphs might be on the area of this glyph already
+ * @param strip         mask of the strip
+ * @param strip_area    area of the strip
+ */
+static void glyph_to_strip(const line_glyph_t * lg, const uint8_t * map_p, const uint8_t * opa_table, bool overlap,
+                           lv_opa_t * strip, const lv_area_t * strip_area)
+{
+    uint32_t bpp = lg->g.bpp == 3 ? 4 : lg->g.bpp;
+    uint32_t px_mask = (1 << bpp) - 1;
+    uint32_t col_bit_max = 8 - bpp;
+    int32_t col_start = lg->area.x1 - lg->pos.x;
+    int32_t w = lv_area_get_width(&lg->area);
+    lv_coord_t strip_w = lv_area_get_width(strip_area);
+    lv_opa_t * dest = strip + (lg->area.y1 - strip_area->y1) * strip_w + (lg->area.x1 - strip_area->x1);
+
+    int32_t row;
+    for(row = lg->area.y1 - lg->pos.y; row <= lg->area.y2 - lg->pos.y; row++) {
+        uint32_t bit_ofs = (row * lg->g.box_w + col_start) * bpp;
+        const uint8_t * src = map_p + (bit_ofs >> 3);
+        uint32_t col_bit = bit_ofs & 0x7;
+        int32_t col;
+        if(!overlap) {
+            /*The strip is empty here so just store the opacities*/
+            for(col = 0; col < w; col++) {
+                dest[col] = opa_table[(*src >> (col_bit_max - col_bit)) & px_mask];
+                col_bit += bpp;
+                src += col_bit >> 3;
+                col_bit &= 0x7;
+            }
+        }
+        else {
+            for(col = 0; col < w; col++) {
+                uint32_t letter_px = (*src >> (col_bit_max - col_bit)) & px_mask;
+                if(letter_px) {
+                    lv_opa_t px_opa = opa_table[letter_px];
+                    /*Overlapping letters cover each other like when they are blended one by one*/
+                    if(dest[col] == LV_OPA_TRANSP) dest[col] = px_opa;
+                    else dest[col] = dest[col] + px_opa - (dest[col] * px_opa + 127) / 255;
+                }
+                col_bit += bpp;
+                src += col_bit >> 3;
+                col_bit &= 0x7;
+            }
+        }
+        dest += strip_w;
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p)
 {
@@ -171,7 +429,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     uint32_t bitmask;
     uint32_t bpp = g->bpp;
     lv_opa_t opa = dsc->opa;
-    uint32_t shades;
     if(bpp == 3) bpp = 4;
 
 #if LV_USE_IMGFONT
@@ -192,46 +449,42 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     }
 #endif
 
-    switch(bpp) {
-        case 1:
-            bpp_opa_table_p = _lv_bpp1_opa_table;
-            bitmask_init  = 0x80;
-            shades = 2;
-            break;
-        case 2:
-            bpp_opa_table_p = _lv_bpp2_opa_table;
-            bitmask_init  = 0xC0;
-            shades = 4;
-            break;
-        case 4:
-            bpp_opa_table_p = _lv_bpp4_opa_table;
-            bitmask_init  = 0xF0;
-            shades = 16;
-            break;
-        case 8:
-            bpp_opa_table_p = _lv_bpp8_opa_table;
-            bitmask_init  = 0xFF;
-            shades = 256;
-            break;       /*No opa table, pixel value will be used directly*/
-        default:
-            LV_LOG_WARN("lv_draw_letter: invalid bpp");
-            return; /*Invalid bpp. Can't render the letter*/
+#if LV_USE_TXT_ATLAS
+    /*The glyphs of a text atlas are opacity masks already.
+     *If there are no other masks use them directly instead of building a mask buffer row by row.
+     *Not with disabled anti-aliasing as the blender would round the mask in place.*/
+    if(lv_txt_atlas_is_atlas(g->resolved_font) && opa >= LV_OPA_MAX &&
+       _lv_refr_get_disp_refreshing()->driver->antialiasing) {
+        lv_area_t letter_area;
+        letter_area.x1 = pos->x;
+        letter_area.y1 = pos->y;
+        letter_area.x2 = pos->x + g->box_w - 1;
+        letter_area.y2 = pos->y + g->box_h - 1;
+#if LV_DRAW_COMPLEX
+        if(!lv_draw_mask_is_any(&letter_area))
+#endif
+        {
+            lv_draw_sw_blend_dsc_t blend_dsc;
+            lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+            blend_dsc.color = dsc->color;
+            blend_dsc.opa = opa;
+            blend_dsc.blend_mode = dsc->blend_mode;
+            blend_dsc.blend_area = &letter_area;
+            blend_dsc.mask_area = &letter_area;
+            blend_dsc.mask_buf = (lv_opa_t *)map_p;
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            return;
+        }
     }
+#endif
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
-    if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
-            uint32_t i;
-            for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
-            }
-        }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
+    bpp_opa_table_p = get_opa_table(bpp, opa);
+    if(bpp_opa_table_p == NULL) {
+        LV_LOG_WARN("lv_draw_letter: invalid bpp");
+        return; /*Invalid bpp. Can't render the letter*/
     }
+    bitmask_init = ((1 << bpp) - 1) << (8 - bpp);
 
     int32_t col, row;
     int32_t box_w = g->box_w;
@@ -29,6 +29,10 @@
  *  STATIC PROTOTYPES
  **********************/
 static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+#if LV_DRAW_COMPLEX
+static void blend_mask_span(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                            const lv_draw_mask_span_t * span, bool fill_cover);
+#endif
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
@@ -156,6 +160,8 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     }
 
     int32_t h;
+    lv_draw_mask_span_t span;
+    bool fill_cover = opa == LV_OPA_COVER;
 
     lv_area_t blend_area;
     blend_area.x1 = clipped_coords.x1;
@@ -226,14 +232,14 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
              * It saves calculating the final opa in lv_draw_sw_blend*/
             lv_memset(mask_buf, opa, clipped_w);
-            blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, clipped_coords.x1, h, clipped_w);
+            blend_dsc.mask_res = lv_draw_mask_apply_span(mask_buf, clipped_coords.x1, h, clipped_w, &span);
             if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
 
 #if _DITHER_GRADIENT
             if(dither_func) dither_func(grad, blend_area.x1,  h - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[h - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_span(draw_ctx, &blend_dsc, &span, fill_cover);
         }
         goto bg_clean_up;
     }
@@ -248,7 +254,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
         /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
          * It saves calculating the final opa in lv_draw_sw_blend*/
         lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
+        blend_dsc.mask_res = lv_draw_mask_apply_span(mask_buf, blend_area.x1, top_y, clipped_w, &span);
         if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
 
         if(top_y >= clipped_coords.y1) {
@@ -259,7 +265,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  top_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[top_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_span(draw_ctx, &blend_dsc, &span, fill_cover);
         }
 
         if(bottom_y <= clipped_coords.y2) {
@@ -270,7 +276,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
             if(dither_func) dither_func(grad, blend_area.x1,  bottom_y - bg_coords.y1, grad_size);
 #endif
             if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[bottom_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            blend_mask_span(draw_ctx, &blend_dsc, &span, fill_cover);
         }
     }
 
@@ -327,6 +333,53 @@ bg_clean_up:
 #endif
 }
 
+#if LV_DRAW_COMPLEX
+/**
+ * Blend a line masked by `lv_draw_mask_apply_span`. The transparent ends of the line are skipped.
+ * @param fill_cover true: the mask was initialized to `LV_OPA_COVER` so the run not changed by the masks
+ *                   can be filled without mask
+ */
+static void blend_mask_span(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                            const lv_draw_mask_span_t * span, bool fill_cover)
+{
+    if(blend_dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+
+    const lv_area_t * line_area = blend_dsc->blend_area;
+    const lv_color_t * src_buf = blend_dsc->src_buf;
+    lv_draw_mask_res_t mask_res = blend_dsc->mask_res;
+    lv_area_t blend_area = *line_area;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_area = line_area;
+
+    lv_coord_t x2 = span->x2;
+    bool cover = fill_cover && span->cover_x1 <= span->cover_x2;
+    if(cover) x2 = span->cover_x1 - 1;
+
+    blend_area.x1 = span->x1;
+    blend_area.x2 = x2;
+    if(src_buf) blend_dsc->src_buf = src_buf + (blend_area.x1 - line_area->x1);
+    if(blend_area.x1 <= blend_area.x2) lv_draw_sw_blend(draw_ctx, blend_dsc);
+
+    if(cover) {
+        blend_area.x1 = span->cover_x1;
+        blend_area.x2 = span->cover_x2;
+        if(src_buf) blend_dsc->src_buf = src_buf + (blend_area.x1 - line_area->x1);
+        blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+        lv_draw_sw_blend(draw_ctx, blend_dsc);
+        blend_dsc->mask_res = mask_res;
+
+        blend_area.x1 = span->cover_x2 + 1;
+        blend_area.x2 = span->x2;
+        if(src_buf) blend_dsc->src_buf = src_buf + (blend_area.x1 - line_area->x1);
+        if(blend_area.x1 <= blend_area.x2) lv_draw_sw_blend(draw_ctx, blend_dsc);
+    }
+
+    blend_dsc->blend_area = line_area;
+    blend_dsc->mask_area = line_area;
+    blend_dsc->src_buf = src_buf;
+}
+#endif
+
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_img_src == NULL) return;
@@ -33,6 +33,14 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+typedef struct {
+    int32_t ofs;        /*Index of the pixel in the source*/
+    int32_t ofs_hor;    /*Index of the horizontal neighbour relative to the pixel*/
+    int32_t ofs_ver;    /*Index of the vertical neighbour relative to the pixel*/
+    int32_t xs_fract;   /*Weight of the horizontal neighbour (0x00..0xFE)*/
+    int32_t ys_fract;   /*Weight of the vertical neighbour (0x00..0xFE)*/
+} bilinear_px_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -47,23 +55,45 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void clip_row(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t len,
+                     int32_t xs_min, int32_t xs_max, int32_t ys_min, int32_t ys_max, int32_t * x1, int32_t * x2);
+
+static void argb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
 
 #if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+                           int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
 #endif
 
 static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+                            int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+
+static void aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck);
+
+static void argb_aa_inner(const uint8_t * src, lv_coord_t src_stride,
+                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                          int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+
+static void rgb_aa_inner(const uint8_t * src, lv_coord_t src_stride,
+                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                         int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf,
+                         lv_color_t ck);
+
+#if LV_COLOR_DEPTH == 16
+static void rgb565a8_aa_inner(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                              int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -125,19 +155,36 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
         int32_t xs_ups = xs1_ups + 0x80;
         int32_t ys_ups = ys1_ups + 0x80;
 
+        /*The coordinates change linearly along the row so the pixels mapped into the image are one run.
+         *Find it once instead of checking the pixels one by one.*/
+        int32_t x1;
+        int32_t x2;
+        clip_row(xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, 0, src_w * 256 - 1, 0, src_h * 256 - 1, &x1, &x2);
+        if(x1 > x2) {
+            lv_memset_00(abuf, dest_w);
+            cbuf += dest_w;
+            abuf += dest_w;
+            continue;
+        }
+
+        lv_memset_00(abuf, x1);
+        lv_memset_00(abuf + x2 + 1, dest_w - x2 - 1);
+
         if(draw_dsc->antialias == 0) {
             switch(cf) {
                 case LV_IMG_CF_TRUE_COLOR_ALPHA:
-                    argb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
+                    argb_no_aa(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x1, x2 + 1, cbuf, abuf);
                     break;
                 case LV_IMG_CF_TRUE_COLOR:
                 case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
-                    rgb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
+                    rgb_no_aa(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x1, x2 + 1, cbuf, abuf,
+                              cf);
                     break;
 
 #if LV_COLOR_DEPTH == 16
                 case LV_IMG_CF_RGB565A8:
-                    rgb565a8_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
+                    rgb565a8_no_aa(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x1, x2 + 1,
+                                   cbuf, abuf);
                     break;
 #endif
                 default:
@@ -145,7 +192,8 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
             }
         }
         else {
-            argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
+            argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x1, x2 + 1,
+                            cbuf, abuf, cf);
         }
 
         cbuf += dest_w;
@@ -157,167 +205,285 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
  *   STATIC FUNCTIONS
  **********************/
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+/**
+ * Find the first pixel where the source coordinate reaches a limit.
+ * The coordinate of the `x`th pixel is `start + ((step * x) >> 8)`.
+ * @param start     upscaled source coordinate of the first pixel
+ * @param step      change of the coordinate in 1/256 upscaled units per pixel
+ * @param len       number of pixels
+ * @param limit     the coordinate reaches it if it's >= `limit` with positive and <= `limit` with negative step
+ * @return          index of the first pixel reaching `limit` or `len` if none of them
+ */
+static int32_t find_first(int32_t start, int32_t step, int32_t len, int32_t limit)
+{
+    int64_t d = (int64_t)limit - start;
+    int64_t x;
+    if(step > 0) x = d <= 0 ? 0 : (d * 256 + step - 1) / step;
+    else if(step < 0) x = d >= 0 ? 0 : (-d - 1) * 256 / -step + 1;
+    else x = d <= 0 ? 0 : len;
+
+    return (int32_t)LV_MIN(x, len);
+}
+
+static void coord_range(int32_t start, int32_t step, int32_t len, int32_t min, int32_t max, int32_t * x1,
+                        int32_t * x2)
+{
+    if(step >= 0) {
+        *x1 = find_first(start, step, len, min);
+        *x2 = find_first(start, step, len, max + 1) - 1;
+    }
+    else {
+        *x1 = find_first(start, step, len, max);
+        *x2 = find_first(start, step, len, min - 1) - 1;
+    }
+}
+
+/**
+ * Get the run of pixels of a row whose upscaled source coordinates are in the given ranges.
+ * It's empty if `x1 > x2`.
+ */
+static void clip_row(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t len,
+                     int32_t xs_min, int32_t xs_max, int32_t ys_min, int32_t ys_max, int32_t * x1, int32_t * x2)
+{
+    int32_t y1;
+    int32_t y2;
+    coord_range(xs_ups, xs_step, len, xs_min, xs_max, x1, x2);
+    coord_range(ys_ups, ys_step, len, ys_min, ys_max, &y1, &y2);
+    *x1 = LV_MAX(*x1, y1);
+    *x2 = LV_MIN(*x2, y2);
+}
+
+/**
+ * Mix two colors exactly as `lv_color_mix`.
+ * With 32 bit colors red-blue and green-alpha are mixed in the two 16 bit halves of a register.
+ * With 16 bit colors `lv_color_mix` already works on the channels together.
+ */
+static inline lv_color_t color_mix(lv_color_t c1, lv_color_t c2, uint8_t mix)
+{
+#if LV_COLOR_DEPTH == 32
+    uint32_t mix_inv = 255 - mix;
+    uint32_t rb = (c1.full & 0x00FF00FF) * mix + (c2.full & 0x00FF00FF) * mix_inv;
+    uint32_t ga = ((c1.full >> 8) & 0x00FF00FF) * mix + ((c2.full >> 8) & 0x00FF00FF) * mix_inv;
+    rb += LV_COLOR_MIX_ROUND_OFS * 0x00010001;
+    ga += LV_COLOR_MIX_ROUND_OFS * 0x00010001;
+
+    /*The same as `LV_UDIV255` on both halves*/
+    rb = ((rb + 0x00010001 + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    ga = ((ga + 0x00010001 + ((ga >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    lv_color_t ret;
+    ret.full = rb | (ga << 8) | 0xFF000000;
+    return ret;
+#else
+    return lv_color_mix(c1, c2, mix);
+#endif
+}
+
+/**
+ * Get the neighbours and the weights for bilinear filtering without branches.
+ * The horizontal neighbour is on the left in the left half of the pixel and on the right in the right half.
+ * The same applies to the vertical neighbour.
+ */
+static inline void bilinear_px_init(bilinear_px_t * p, int32_t xs_ups, int32_t ys_ups, int32_t src_stride)
+{
+    int32_t xs_fract = xs_ups & 0xFF;
+    int32_t ys_fract = ys_ups & 0xFF;
+    int32_t x_right = xs_fract >> 7;
+    int32_t y_bottom = ys_fract >> 7;
+
+    p->ofs = (ys_ups >> 8) * src_stride + (xs_ups >> 8);
+    p->ofs_hor = x_right * 2 - 1;
+    p->ofs_ver = (y_bottom * 2 - 1) * src_stride;
+
+    /*`(0x7F - fract) * 2` in the left/top and `(fract - 0x80) * 2` in the right/bottom half*/
+    p->xs_fract = ((xs_fract ^ ((x_right - 1) & 0x7F)) & 0x7F) << 1;
+    p->ys_fract = ((ys_fract ^ ((y_bottom - 1) & 0x7F)) & 0x7F) << 1;
+}
+
+static inline lv_opa_t bilinear_opa(lv_opa_t a_base, lv_opa_t a_hor, lv_opa_t a_ver, const bilinear_px_t * p)
+{
+    a_ver = ((a_ver * p->ys_fract) + (a_base * (0x100 - p->ys_fract))) >> 8;
+    a_hor = ((a_hor * p->xs_fract) + (a_base * (0x100 - p->xs_fract))) >> 8;
+    return (a_ver + a_hor) >> 1;
+}
+
+static inline lv_color_t bilinear_color(lv_color_t c_base, lv_color_t c_hor, lv_color_t c_ver,
+                                        const bilinear_px_t * p)
+{
+    if(c_base.full == c_ver.full && c_base.full == c_hor.full) return c_base;
+
+    c_ver = color_mix(c_ver, c_base, p->ys_fract);
+    c_hor = color_mix(c_hor, c_base, p->xs_fract);
+    return color_mix(c_hor, c_ver, LV_OPA_50);
+}
+
+static void rgb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-    lv_disp_t * d = _lv_refr_get_disp_refreshing();
-    lv_color_t ck = d->driver->color_chroma_key;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
 
-    lv_memset_ff(abuf, x_end);
+    lv_memset_ff(abuf + x_start, x_end - x_start);
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-        }
-        else {
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            const uint8_t * src_tmp = src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x].full = src_tmp[0];
+        const uint8_t * src_tmp = src;
+        src_tmp += ys_int * src_stride + xs_int;
+        cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
+        const lv_color_t * src_tmp = (const lv_color_t *)src;
+        src_tmp += ys_int * src_stride + xs_int;
+        cbuf[x] = *src_tmp;
 #elif LV_COLOR_DEPTH == 32
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
+        cbuf[x].full = *((uint32_t *)src_tmp);
 #endif
-        }
-        if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && cbuf[x].full == ck.full) {
-            abuf[x] = 0x00;
+    }
+
+    if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_disp_t * d = _lv_refr_get_disp_refreshing();
+        lv_color_t ck = d->driver->color_chroma_key;
+        for(x = x_start; x < x_end; x++) {
+            if(cbuf[x].full == ck.full) abuf[x] = 0x00;
         }
     }
 }
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void argb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
 
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            cbuf[x].full = src_tmp[0];
+        cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+        cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        cbuf[x].full = *((uint32_t *)src_tmp);
 #endif
-            abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-        }
+        abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
     }
 }
 
 #if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+                           int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t);
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
-
-            const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-            a_tmp += ys_int * src_stride + xs_int;
-            abuf[x] = *a_tmp;
-        }
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t ofs = ys_int * src_stride + xs_int;
+        cbuf[x] = src_c[ofs];
+        abuf[x] = src_a[ofs];
     }
 }
 #endif
 
-
 static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+                            int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-    bool has_alpha;
-    int32_t px_size;
     lv_color_t ck = {0};
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR:
-            has_alpha = false;
-            px_size = sizeof(lv_color_t);
-            break;
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
-            has_alpha = true;
-            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+#endif
             break;
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
-                has_alpha = true;
-                px_size = sizeof(lv_color_t);
                 lv_disp_t * d = _lv_refr_get_disp_refreshing();
                 ck = d->driver->color_chroma_key;
                 break;
             }
+        default:
+            return;
+    }
+
+    /*Both neighbours are in the image in the middle of the run so no checks are required there*/
+    int32_t in_x1;
+    int32_t in_x2;
+    clip_row(xs_ups, ys_ups, xs_step, ys_step, x_end, 0x80, (src_w - 1) * 256 + 0x7F, 0x80, (src_h - 1) * 256 + 0x7F,
+             &in_x1, &in_x2);
+    if(in_x1 > in_x2) {
+        in_x1 = x_end;
+        in_x2 = x_end - 1;
+    }
+
+    aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, in_x1, cbuf, abuf, cf, ck);
+    aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_x2 + 1, x_end, cbuf, abuf, cf, ck);
+
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            argb_aa_inner(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_x1, in_x2 + 1, cbuf, abuf);
+            break;
 #if LV_COLOR_DEPTH == 16
         case LV_IMG_CF_RGB565A8:
-            has_alpha = true;
-            px_size = sizeof(lv_color_t);
+            rgb565a8_aa_inner(src, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_x1, in_x2 + 1, cbuf, abuf);
             break;
 #endif
         default:
-            return;
+            rgb_aa_inner(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_x1, in_x2 + 1, cbuf, abuf, cf, ck);
+            break;
     }
+}
 
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+/**
+ * Handle the pixels in the image whose horizontal or vertical neighbour is out of the image.
+ * They fade out towards the edge of the image.
+ */
+static void aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck)
+{
+    int32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : (int32_t)sizeof(lv_color_t);
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
+    lv_coord_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
-        /*Fully out of the image*/
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-            continue;
-        }
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
 
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
+        int32_t xs_fract = xs & 0xFF;
+        int32_t ys_fract = ys & 0xFF;
 
         int32_t x_next;
         int32_t y_next;
@@ -341,130 +507,138 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
         const uint8_t * src_tmp = src;
         src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
 
-
-        if(xs_int + x_next >= 0 &&
-           xs_int + x_next <= src_w - 1 &&
-           ys_int + y_next >= 0 &&
-           ys_int + y_next <= src_h - 1) {
-
-            const uint8_t * px_base = src_tmp;
-            const uint8_t * px_hor = src_tmp + x_next * px_size;
-            const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
-            lv_color_t c_base;
-            lv_color_t c_ver;
-            lv_color_t c_hor;
-
-            if(has_alpha) {
-                lv_opa_t a_base;
-                lv_opa_t a_ver;
-                lv_opa_t a_hor;
-                if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
-                    a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                }
-#if LV_COLOR_DEPTH == 16
-                else if(cf == LV_IMG_CF_RGB565A8) {
-                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-                    a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
-                    a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
-                    a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
-                }
-#endif
-                else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
-                    if(((lv_color_t *)px_base)->full == ck.full ||
-                       ((lv_color_t *)px_ver)->full == ck.full ||
-                       ((lv_color_t *)px_hor)->full == ck.full) {
-                        abuf[x] = 0x00;
-                        continue;
-                    }
-                    else {
-                        a_base = 0xff;
-                        a_ver = 0xff;
-                        a_hor = 0xff;
-                    }
-                }
-                else {
-                    a_base = 0xff;
-                    a_ver = 0xff;
-                    a_hor = 0xff;
-                }
-
-                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
-                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
-                abuf[x] = (a_ver + a_hor) >> 1;
-
-                if(abuf[x] == 0x00) continue;
-
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-                c_base.full = px_base[0];
-                c_ver.full = px_ver[0];
-                c_hor.full = px_hor[0];
+        cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-                c_base.full = px_base[0] + (px_base[1] << 8);
-                c_ver.full = px_ver[0] + (px_ver[1] << 8);
-                c_hor.full = px_hor[0] + (px_hor[1] << 8);
+        cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-                c_base.full = *((uint32_t *)px_base);
-                c_ver.full = *((uint32_t *)px_ver);
-                c_hor.full = *((uint32_t *)px_hor);
+        cbuf[x].full = *((uint32_t *)src_tmp);
 #endif
-            }
-            /*No alpha channel -> RGB*/
-            else {
-                c_base = *((const lv_color_t *) px_base);
-                c_hor = *((const lv_color_t *) px_hor);
-                c_ver = *((const lv_color_t *) px_ver);
-                abuf[x] = 0xff;
-            }
+        lv_opa_t a;
+        switch(cf) {
+            case LV_IMG_CF_TRUE_COLOR_ALPHA:
+                a = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                break;
+            case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+                a = cbuf[x].full == ck.full ? 0x00 : 0xff;
+                break;
+#if LV_COLOR_DEPTH == 16
+            case LV_IMG_CF_RGB565A8:
+                a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
+                break;
+#endif
+            default:
+                a = 0xff;
+        }
 
-            if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
-                cbuf[x] = c_base;
-            }
-            else {
-                c_ver = lv_color_mix(c_ver, c_base, ys_fract);
-                c_hor = lv_color_mix(c_hor, c_base, xs_fract);
-                cbuf[x] = lv_color_mix(c_hor, c_ver, LV_OPA_50);
-            }
+        if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
+            abuf[x] = (a * (0xFF - xs_fract)) >> 8;
+        }
+        else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
+            abuf[x] = (a * (0xFF - ys_fract)) >> 8;
         }
-        /*Partially out of the image*/
         else {
+            abuf[x] = 0x00;
+        }
+    }
+}
+
+static void argb_aa_inner(const uint8_t * src, lv_coord_t src_stride,
+                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                          int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+{
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    lv_coord_t x;
+    for(x = x_start; x < x_end; x++) {
+        bilinear_px_t p;
+        bilinear_px_init(&p, xs_ups + (xs_acc >> 8), ys_ups + (ys_acc >> 8), src_stride);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        const uint8_t * px_base = src + p.ofs * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        const uint8_t * px_hor = px_base + p.ofs_hor * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        const uint8_t * px_ver = px_base + p.ofs_ver * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+        abuf[x] = bilinear_opa(px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1],
+                               px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], &p);
+        if(abuf[x] == 0x00) continue;
+
+        lv_color_t c_base;
+        lv_color_t c_ver;
+        lv_color_t c_hor;
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            cbuf[x].full = src_tmp[0];
+        c_base.full = px_base[0];
+        c_ver.full = px_ver[0];
+        c_hor.full = px_hor[0];
 #elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+        c_base.full = px_base[0] + (px_base[1] << 8);
+        c_ver.full = px_ver[0] + (px_ver[1] << 8);
+        c_hor.full = px_hor[0] + (px_hor[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        c_base.full = *((uint32_t *)px_base);
+        c_ver.full = *((uint32_t *)px_ver);
+        c_hor.full = *((uint32_t *)px_hor);
 #endif
-            lv_opa_t a;
-            switch(cf) {
-                case LV_IMG_CF_TRUE_COLOR_ALPHA:
-                    a = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    break;
-                case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
-                    a = cbuf[x].full == ck.full ? 0x00 : 0xff;
-                    break;
-#if LV_COLOR_DEPTH == 16
-                case LV_IMG_CF_RGB565A8:
-                    a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
-                    break;
-#endif
-                default:
-                    a = 0xff;
-            }
+        cbuf[x] = bilinear_color(c_base, c_hor, c_ver, &p);
+    }
+}
 
-            if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
-                abuf[x] = (a * (0xFF - xs_fract)) >> 8;
-            }
-            else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
-                abuf[x] = (a * (0xFF - ys_fract)) >> 8;
-            }
-            else {
-                abuf[x] = 0x00;
-            }
+static void rgb_aa_inner(const uint8_t * src, lv_coord_t src_stride,
+                         int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                         int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf,
+                         lv_color_t ck)
+{
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    bool chroma_keyed = cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+
+    lv_coord_t x;
+    for(x = x_start; x < x_end; x++) {
+        bilinear_px_t p;
+        bilinear_px_init(&p, xs_ups + (xs_acc >> 8), ys_ups + (ys_acc >> 8), src_stride);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        lv_color_t c_base = src_c[p.ofs];
+        lv_color_t c_hor = src_c[p.ofs + p.ofs_hor];
+        lv_color_t c_ver = src_c[p.ofs + p.ofs_ver];
+        if(chroma_keyed && (c_base.full == ck.full || c_ver.full == ck.full || c_hor.full == ck.full)) {
+            abuf[x] = 0x00;
+            continue;
         }
+
+        abuf[x] = 0xff;
+        cbuf[x] = bilinear_color(c_base, c_hor, c_ver, &p);
+    }
+}
+
+#if LV_COLOR_DEPTH == 16
+static void rgb565a8_aa_inner(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                              int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+{
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t);
+
+    lv_coord_t x;
+    for(x = x_start; x < x_end; x++) {
+        bilinear_px_t p;
+        bilinear_px_init(&p, xs_ups + (xs_acc >> 8), ys_ups + (ys_acc >> 8), src_stride);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        abuf[x] = bilinear_opa(src_a[p.ofs], src_a[p.ofs + p.ofs_hor], src_a[p.ofs + p.ofs_ver], &p);
+        if(abuf[x] == 0x00) continue;
+
+        cbuf[x] = bilinear_color(src_c[p.ofs], src_c[p.ofs + p.ofs_hor], src_c[p.ofs + p.ofs_ver], &p);
     }
 }
+#endif
 
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout)
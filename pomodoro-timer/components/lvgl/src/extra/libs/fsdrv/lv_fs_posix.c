@@ -16,6 +16,10 @@
 #ifndef WIN32
     #include <dirent.h>
     #include <unistd.h>
+    #if LV_FS_POSIX_MMAP
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+    #endif
 #else
     #include <windows.h>
 #endif
@@ -41,6 +45,10 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#if LV_FS_POSIX_MMAP && !defined(WIN32)
+    static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t * size);
+    static void fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * map, uint32_t size);
+#endif
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -80,6 +88,10 @@ void lv_fs_posix_init(void)
     fs_drv.write_cb = fs_write;
     fs_drv.seek_cb = fs_seek;
     fs_drv.tell_cb = fs_tell;
+#if LV_FS_POSIX_MMAP && !defined(WIN32)
+    fs_drv.map_cb = fs_map;
+    fs_drv.unmap_cb = fs_unmap;
+#endif
 
     fs_drv.dir_close_cb = fs_dir_close;
     fs_drv.dir_open_cb = fs_dir_open;
@@ -196,6 +208,42 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return offset < 0 ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
 }
 
+#if LV_FS_POSIX_MMAP && !defined(WIN32)
+/**
+ * Map a file opened for reading into the memory
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable
+ * @param size store the size of the file here
+ * @return address of the mapped file or NULL if it can't be mapped (e.g. it's empty)
+ */
+static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t * size)
+{
+    LV_UNUSED(drv);
+    struct stat st;
+    if(fstat((lv_uintptr_t)file_p, &st) != 0 || st.st_size <= 0 || st.st_size > UINT32_MAX) return NULL;
+
+    void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, (lv_uintptr_t)file_p, 0);
+    if(map == MAP_FAILED) return NULL;
+
+    *size = st.st_size;
+    return map;
+}
+
+/**
+ * Unmap a file mapped by `fs_map()`
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable
+ * @param map the address returned by `fs_map()`
+ * @param size the size of the file
+ */
+static void fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * map, uint32_t size)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+    munmap((void *)map, size);
+}
+#endif
+
 #ifdef WIN32
     static char next_fn[256];
 #endif
@@ -11,6 +11,14 @@
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
+#if LV_COLOR_DEPTH == 32
+    #define CANVAS_PX_SIZE  4
+#elif LV_COLOR_DEPTH == 16
+    #define CANVAS_PX_SIZE  3
+#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+    #define CANVAS_PX_SIZE  2
+#endif
+
 typedef struct Entry {
     uint16_t length;
     uint16_t prefix;
@@ -487,85 +495,122 @@ read_image(gd_GIF *gif)
     return read_image_data(gif, interlace);
 }
 
+/* Convert a palette color to the pixel format of the canvas. */
 static void
-render_frame_rect(gd_GIF *gif, uint8_t *buffer)
+make_px(uint8_t *px, const uint8_t *color, uint8_t opa)
 {
-    int i, j, k;
-    uint8_t index, *color;
-    i = gif->fy * gif->width + gif->fx;
-    for (j = 0; j < gif->fh; j++) {
-        for (k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
-            color = &gif->palette->colors[index*3];
-            if (!gif->gce.transparency || index != gif->gce.tindex) {
 #if LV_COLOR_DEPTH == 32
-                buffer[(i+k)*4 + 0] = *(color + 2);
-                buffer[(i+k)*4 + 1] = *(color + 1);
-                buffer[(i+k)*4 + 2] = *(color + 0);
-                buffer[(i+k)*4 + 3] = 0xFF;
+    px[0] = *(color + 2);
+    px[1] = *(color + 1);
+    px[2] = *(color + 0);
+    px[3] = opa;
 #elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*3 + 0] = c.full & 0xff;
-                buffer[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                buffer[(i+k)*3 + 2] = 0xff;
+    lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+    px[0] = c.full & 0xff;
+    px[1] = (c.full >> 8) & 0xff;
+    px[2] = opa;
 #elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*2 + 0] = c.full;
-                buffer[(i+k)*2 + 1] = 0xff;
+    lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+    px[0] = c.full;
+    px[1] = opa;
 #elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
-                buffer[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                buffer[(i+k)*2 + 1] = 0xff;
+    uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
+    px[0] = b > 128 ? 1 : 0;
+    px[1] = opa;
 #endif
-            }
+}
+
+/* Add a changed span of a line to the dirty area. */
+static void
+add_dirty(gd_GIF *gif, int32_t x1, int32_t x2, int32_t y)
+{
+    if (gif->dirty_x2 < gif->dirty_x1) {
+        gif->dirty_x1 = x1;
+        gif->dirty_x2 = x2;
+        gif->dirty_y1 = y;
+        gif->dirty_y2 = y;
+        return;
+    }
+    gif->dirty_x1 = MIN(gif->dirty_x1, x1);
+    gif->dirty_x2 = MAX(gif->dirty_x2, x2);
+    gif->dirty_y1 = MIN(gif->dirty_y1, y);
+    gif->dirty_y2 = MAX(gif->dirty_y2, y);
+}
+
+/* Write only the changed pixels to see what needs to be redrawn. */
+static void
+render_frame_rect(gd_GIF *gif, uint8_t *buffer)
+{
+    int j, k;
+    uint8_t index, px[CANVAS_PX_SIZE];
+    for (j = 0; j < gif->fh; j++) {
+        int32_t y = gif->fy + j;
+        int32_t x1 = -1, x2 = -1;
+        uint8_t *src = &gif->frame[y * gif->width + gif->fx];
+        uint8_t *dst = &buffer[(y * gif->width + gif->fx) * CANVAS_PX_SIZE];
+        for (k = 0; k < gif->fw; k++, dst += CANVAS_PX_SIZE) {
+            index = src[k];
+            if (gif->gce.transparency && index == gif->gce.tindex) continue;
+            make_px(px, &gif->palette->colors[index*3], 0xff);
+            if (memcmp(dst, px, CANVAS_PX_SIZE) == 0) continue;
+            memcpy(dst, px, CANVAS_PX_SIZE);
+            if (x1 < 0) x1 = gif->fx + k;
+            x2 = gif->fx + k;
+        }
+        if (x1 >= 0) add_dirty(gif, x1, x2, y);
+    }
+}
+
+/* Copy a rectangle between the canvas and a buffer of its size. */
+static void
+copy_rect(gd_GIF *gif, uint8_t *rect_buf, bool to_canvas)
+{
+    int j;
+    uint32_t line_size = gif->shown_fw * CANVAS_PX_SIZE;
+    for (j = 0; j < gif->shown_fh; j++) {
+        uint8_t *canvas = &gif->canvas[((gif->shown_fy + j) * gif->width + gif->shown_fx) * CANVAS_PX_SIZE];
+        uint8_t *rect = &rect_buf[j * line_size];
+        if (to_canvas) {
+            if (memcmp(canvas, rect, line_size) == 0) continue;
+            memcpy(canvas, rect, line_size);
+            add_dirty(gif, gif->shown_fx, gif->shown_fx + gif->shown_fw - 1, gif->shown_fy + j);
+        }
+        else {
+            memcpy(rect, canvas, line_size);
         }
-        i += gif->width;
     }
 }
 
+/* Apply the disposal method of the shown frame. Only the changed pixels are written. */
 static void
 dispose(gd_GIF *gif)
 {
-    int i, j, k;
-    uint8_t *bgcolor;
-    switch (gif->gce.disposal) {
+    int j, k;
+    switch (gif->shown_gce.disposal) {
     case 2: /* Restore to background color. */
-        bgcolor = &gif->palette->colors[gif->bgindex*3];
-
-        uint8_t opa = 0xff;
-        if(gif->gce.transparency) opa = 0x00;
-
-        i = gif->fy * gif->width + gif->fx;
-        for (j = 0; j < gif->fh; j++) {
-            for (k = 0; k < gif->fw; k++) {
-#if LV_COLOR_DEPTH == 32
-                gif->canvas[(i+k)*4 + 0] = *(bgcolor + 2);
-                gif->canvas[(i+k)*4 + 1] = *(bgcolor + 1);
-                gif->canvas[(i+k)*4 + 2] = *(bgcolor + 0);
-                gif->canvas[(i+k)*4 + 3] = opa;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*3 + 0] = c.full & 0xff;
-                gif->canvas[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                gif->canvas[(i+k)*3 + 2] = opa;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = c.full;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(bgcolor + 0)) | (*(bgcolor + 1)) | (*(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#endif
+    {
+        uint8_t px[CANVAS_PX_SIZE];
+        make_px(px, &gif->gct.colors[gif->bgindex*3], gif->shown_gce.transparency ? 0x00 : 0xff);
+        for (j = 0; j < gif->shown_fh; j++) {
+            int32_t y = gif->shown_fy + j;
+            int32_t x1 = -1, x2 = -1;
+            uint8_t *dst = &gif->canvas[(y * gif->width + gif->shown_fx) * CANVAS_PX_SIZE];
+            for (k = 0; k < gif->shown_fw; k++, dst += CANVAS_PX_SIZE) {
+                if (memcmp(dst, px, CANVAS_PX_SIZE) == 0) continue;
+                memcpy(dst, px, CANVAS_PX_SIZE);
+                if (x1 < 0) x1 = gif->shown_fx + k;
+                x2 = gif->shown_fx + k;
             }
-            i += gif->width;
+            if (x1 >= 0) add_dirty(gif, x1, x2, y);
         }
         break;
-    case 3: /* Restore to previous, i.e., don't update canvas.*/
+    }
+    case 3: /* Restore to previous, i.e. to the canvas before the frame was rendered. */
+        if (gif->backup) copy_rect(gif, gif->backup, true);
         break;
     default:
-        /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        /* Keep the frame on the canvas. */
+        break;
     }
 }
 
@@ -575,7 +620,6 @@ gd_get_frame(gd_GIF *gif)
 {
     char sep;
 
-    dispose(gif);
     f_gif_read(gif, &sep, 1);
     while (sep != ',') {
         if (sep == ';') {
@@ -597,18 +641,28 @@ gd_get_frame(gd_GIF *gif)
     return 1;
 }
 
+/* Dispose the shown frame and render the frame read by gd_get_frame() on `buffer`, which must be the canvas.
+ * The changed area is stored in `dirty_x1..dirty_y2`. */
 void
 gd_render_frame(gd_GIF *gif, uint8_t *buffer)
 {
-//    uint32_t i;
-//    uint32_t j;
-//    for(i = 0, j = 0; i < gif->width * gif->height * 3; i+= 3, j+=4) {
-//        buffer[j + 0] = gif->canvas[i + 2];
-//        buffer[j + 1] = gif->canvas[i + 1];
-//        buffer[j + 2] = gif->canvas[i + 0];
-//        buffer[j + 3] = 0xFF;
-//    }
-//    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
+    gif->dirty_x1 = 0;
+    gif->dirty_x2 = -1;
+    dispose(gif);
+
+    gif->shown_gce = gif->gce;
+    gif->shown_fx = gif->fx;
+    gif->shown_fy = gif->fy;
+    gif->shown_fw = gif->fw;
+    gif->shown_fh = gif->fh;
+
+    /* Save the canvas under the frame to restore it when the frame is disposed */
+    if (gif->gce.disposal == 3) {
+        if (gif->backup) lv_mem_free(gif->backup);
+        gif->backup = lv_mem_alloc(gif->fw * gif->fh * CANVAS_PX_SIZE);
+        if (gif->backup) copy_rect(gif, gif->backup, false);
+    }
+
     render_frame_rect(gif, buffer);
 }
 
@@ -623,6 +677,7 @@ void
 gd_close_gif(gd_GIF *gif)
 {
     f_gif_close(gif);
+    if (gif->backup) lv_mem_free(gif->backup);
     lv_mem_free(gif);
 }
 
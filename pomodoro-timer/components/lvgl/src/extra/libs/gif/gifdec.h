@@ -43,6 +43,12 @@ typedef struct gd_GIF {
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
     uint8_t *canvas, *frame;
+    /* The frame rendered last, to dispose it before rendering the next one */
+    gd_GCE shown_gce;
+    uint16_t shown_fx, shown_fy, shown_fw, shown_fh;
+    uint8_t *backup;    /* Canvas under the shown frame if it's disposed by restoring the previous one */
+    /* Area of the canvas changed by the last gd_render_frame(). Empty if dirty_x2 < dirty_x1. */
+    int32_t dirty_x1, dirty_y1, dirty_x2, dirty_y2;
 } gd_GIF;
 
 gd_GIF * gd_open_gif_file(const char *fname);
@@ -16,6 +16,9 @@
  *********************/
 #define MY_CLASS    &lv_gif_class
 
+/*`next_frame` when the next frame is not decoded yet*/
+#define NEXT_FRAME_NONE     2
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -27,6 +30,7 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_dirty_area(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -85,6 +89,7 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.header.h = gifobj->gif->height;
     gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
+    gifobj->next_frame = NEXT_FRAME_NONE;
 
     lv_img_set_src(obj, &gifobj->imgdsc);
 
@@ -99,6 +104,7 @@ void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     gd_rewind(gifobj->gif);
+    gifobj->next_frame = NEXT_FRAME_NONE;
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
@@ -114,6 +120,7 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+    gifobj->next_frame = NEXT_FRAME_NONE;
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -132,23 +139,53 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    /*Decode the next frame while the current one is shown, so only the changed pixels are rendered when it's due*/
+    if(gifobj->next_frame == NEXT_FRAME_NONE) gifobj->next_frame = (int8_t)gd_get_frame(gifobj->gif);
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
-    if(elaps < gifobj->gif->gce.delay * 10) return;
+    if(elaps < gifobj->gif->shown_gce.delay * 10) return;
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
+    int has_next = gifobj->next_frame;
+    gifobj->next_frame = NEXT_FRAME_NONE;
     if(has_next == 0) {
         /*It was the last repeat*/
-        lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
         lv_timer_pause(t);
-        if(res != LV_FS_RES_OK) return;
+        lv_event_send(obj, LV_EVENT_READY, NULL);
+        /*No new frame was read, the last one stays on the canvas*/
+        return;
     }
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_dirty_area(obj);
+}
+
+/*Invalidate only the pixels changed by the last frame if the image is drawn 1:1*/
+static void invalidate_dirty_area(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    gd_GIF * gif = gifobj->gif;
+    if(gif->dirty_x2 < gif->dirty_x1) return;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_img_t * img = &gifobj->img;
+    if(img->angle != 0 || img->zoom != LV_IMG_ZOOM_NONE || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_area_get_width(&content) != gif->width || lv_area_get_height(&content) != gif->height) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t a;
+    a.x1 = content.x1 + gif->dirty_x1;
+    a.y1 = content.y1 + gif->dirty_y1;
+    a.x2 = content.x1 + gif->dirty_x2;
+    a.y2 = content.y1 + gif->dirty_y2;
+    lv_obj_invalidate_area(obj, &a);
 }
 
 #endif /*LV_USE_GIF*/
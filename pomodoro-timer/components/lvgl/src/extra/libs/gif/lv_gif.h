@@ -33,6 +33,7 @@ typedef struct {
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+    int8_t next_frame;      /*Result of `gd_get_frame()` for the already decoded next frame*/
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
@@ -10,6 +10,7 @@
 #if LV_USE_PNG
 
 #include "lv_png.h"
+#include "lv_png_stream.h"
 #include "lodepng.h"
 #include <stdlib.h>
 
@@ -26,12 +27,15 @@
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t stream_min_px = LV_PNG_STREAM_MIN_PX;
 
 /**********************
  *      MACROS
@@ -49,9 +53,20 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
+/**
+ * Set the number of pixels from which the PNG images are decoded line by line.
+ * Overrides `LV_PNG_STREAM_MIN_PX` at run time. Affects only the images opened later.
+ * @param px    number of pixels, 0: always decode the whole image at once
+ */
+void lv_png_set_stream_min_px(uint32_t px)
+{
+    stream_min_px = px;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -129,6 +144,13 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     (void) decoder; /*Unused*/
     uint32_t error;                 /*For the return values of PNG decoder functions*/
 
+    /*Decode the large images line by line in `decoder_read_line` to need only a little memory*/
+    if(stream_min_px && (uint32_t)dsc->header.w * dsc->header.h >= stream_min_px) {
+        dsc->user_data = _lv_png_stream_open(dsc->src, dsc->src_type);
+        if(dsc->user_data) return LV_RES_OK;
+        /*E.g. interlaced images can't be streamed, decode them at once*/
+    }
+
     uint8_t * img_data = NULL;
 
     /*If it's a PNG file...*/
@@ -136,14 +158,24 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         const char * fn = dsc->src;
         if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
 
-            /*Load the PNG file into buffer. It's still compressed (not decoded)*/
-            unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
-            size_t png_data_size;          /*Size of `png_data` in bytes*/
-
-            error = lodepng_load_file(&png_data, &png_data_size, fn);   /*Load the file*/
-            if(error) {
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
+            /*Decode a mapped file in place*/
+            lv_fs_file_t f;
+            if(lv_fs_open(&f, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+            uint32_t map_size;
+            const unsigned char * png_data = lv_fs_get_map(&f, &map_size);
+            size_t png_data_size = map_size;
+            unsigned char * png_loaded = NULL;
+
+            /*Else load the PNG file into buffer. It's still compressed (not decoded)*/
+            if(png_data == NULL) {
+                lv_fs_close(&f);
+                error = lodepng_load_file(&png_loaded, &png_data_size, fn);   /*Load the file*/
+                if(error) {
+                    LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+                    return LV_RES_INV;
+                }
+                png_data = png_loaded;
             }
 
             /*Decode the PNG image*/
@@ -152,7 +184,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
             /*Decode the loaded image in ARGB8888 */
             error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
-            lv_mem_free(png_data); /*Free the loaded file*/
+            if(png_loaded) lv_mem_free(png_loaded); /*Free the loaded file*/
+            else lv_fs_close(&f);
             if(error) {
                 if(img_data != NULL) {
                     lv_mem_free(img_data);
@@ -193,12 +226,27 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     return LV_RES_INV;    /*If not returned earlier then it failed*/
 }
 
+/**
+ * Decode a line of a PNG opened for streaming
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    if(dsc->user_data == NULL) return LV_RES_INV;
+    return _lv_png_stream_read_line(dsc->user_data, x, y, len, buf);
+}
+
 /**
  * Free the allocated resources
  */
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder); /*Unused*/
+    if(dsc->user_data) {
+        _lv_png_stream_close(dsc->user_data);
+        dsc->user_data = NULL;
+    }
     if(dsc->img_data) {
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
@@ -33,6 +33,13 @@ extern "C" {
  */
 void lv_png_init(void);
 
+/**
+ * Set the number of pixels from which the PNG images are decoded line by line.
+ * Overrides `LV_PNG_STREAM_MIN_PX` at run time. Affects only the images opened later.
+ * @param px    number of pixels, 0: always decode the whole image at once
+ */
+void lv_png_set_stream_min_px(uint32_t px);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,783 @@
+/**
+ * @file lv_png_stream.c
+ * Line by line PNG decoder. It needs a 32 kB inflate window, two lines of the image
+ * and a small input buffer instead of the whole decoded image.
+ * Interlaced images are not supported.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_png_stream.h"
+#if LV_USE_PNG
+
+/*********************
+ *      DEFINES
+ *********************/
+#define WINDOW_SIZE     32768       /*The largest distance of deflate*/
+#define WINDOW_MASK     (WINDOW_SIZE - 1)
+#define FAST_BITS       9           /*Codes of at most this many bits are decoded by a table look up*/
+#define FAST_MASK       ((1 << FAST_BITS) - 1)
+#define IN_BUF_SIZE     512         /*Read the files in this large blocks*/
+
+#define CHUNK_IHDR      0x49484452
+#define CHUNK_PLTE      0x504C5445
+#define CHUNK_TRNS      0x74524E53
+#define CHUNK_IDAT      0x49444154
+#define CHUNK_IEND      0x49454E44
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint16_t fast[1 << FAST_BITS];  /*Symbol << 4 | code length of the short codes. 0: the code is longer.*/
+    uint16_t count[16];             /*Number of codes of each length*/
+    uint16_t symbol[288];           /*Symbols ordered by their codes*/
+} huffman_t;
+
+typedef enum {
+    INFLATE_BLOCK_START,
+    INFLATE_STORED,
+    INFLATE_HUFFMAN,
+} inflate_state_t;
+
+struct _lv_png_stream_t {
+    /*Source*/
+    lv_fs_file_t file;
+    const uint8_t * data;           /*Data of a C array or NULL if it's a file*/
+    uint32_t data_size;
+    uint32_t src_pos;
+    uint32_t in_pos;                /*Position in `in_buf`*/
+    uint32_t in_len;                /*Number of valid bytes in `in_buf`*/
+    uint32_t idat_start;            /*Position of the data of the first IDAT chunk*/
+    uint32_t idat_start_len;
+    uint32_t idat_left;             /*Unread bytes in the current IDAT chunk*/
+
+    /*Inflate*/
+    uint32_t bit_buf;
+    uint8_t bit_cnt;
+    uint8_t state;                  /*An `inflate_state_t`*/
+    uint8_t last_block : 1;
+    uint8_t eof : 1;                /*Tried to read after the image data*/
+    uint16_t stored_left;
+    uint16_t copy_len;
+    uint16_t copy_dist;
+    uint32_t win_pos;
+    huffman_t lit;
+    huffman_t dist;
+
+    /*Image*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t depth;
+    uint8_t color_type;
+    uint8_t filter_bpp;             /*Distance of the bytes compared by the filters*/
+    uint8_t has_trns : 1;
+    uint16_t trns[3];               /*The transparent gray or RGB value in the image's depth*/
+    uint32_t stride;                /*Bytes of a line without the filter type byte*/
+    uint32_t next_y;                /*The line decoded by the next `decode_row()`*/
+    uint8_t * rows;                 /*Memory for `cur` and `prev`. They are swapped after every line.*/
+    uint8_t * cur;                  /*The last decoded line, starting with the filter type*/
+    uint8_t * prev;                 /*The line before it*/
+    lv_color32_t palette[256];      /*In RGBA byte order*/
+
+    uint8_t in_buf[IN_BUF_SIZE];
+    uint8_t window[WINDOW_SIZE];
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool read_header(_lv_png_stream_t * s);
+static bool restart(_lv_png_stream_t * s);
+static bool decode_row(_lv_png_stream_t * s);
+static void unfilter(uint8_t * row, const uint8_t * prev, uint32_t stride, uint8_t bpp, uint8_t type);
+static bool inflate_read(_lv_png_stream_t * s, uint8_t * out, uint32_t n);
+static bool huffman_build(huffman_t * h, const uint8_t * lengths, uint32_t n);
+static bool build_fixed(_lv_png_stream_t * s);
+static bool build_dynamic(_lv_png_stream_t * s);
+static int32_t huffman_decode(_lv_png_stream_t * s, const huffman_t * h);
+static uint8_t read_idat_byte(_lv_png_stream_t * s);
+static uint8_t src_byte(_lv_png_stream_t * s);
+static uint32_t src_u32(_lv_png_stream_t * s);
+static void src_seek(_lv_png_stream_t * s, uint32_t pos);
+static void write_px(uint8_t * buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t clen_order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+_lv_png_stream_t * _lv_png_stream_open(const void * src, lv_img_src_t src_type)
+{
+    _lv_png_stream_t * s = lv_mem_alloc(sizeof(_lv_png_stream_t));
+    LV_ASSERT_MALLOC(s);
+    if(s == NULL) return NULL;
+    lv_memset_00(s, offsetof(_lv_png_stream_t, in_buf));
+
+    if(src_type == LV_IMG_SRC_FILE) {
+        if(lv_fs_open(&s->file, src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_mem_free(s);
+            return NULL;
+        }
+    }
+    else if(src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        s->data = img_dsc->data;
+        s->data_size = img_dsc->data_size;
+    }
+    else {
+        lv_mem_free(s);
+        return NULL;
+    }
+
+    if(!read_header(s)) {
+        _lv_png_stream_close(s);
+        return NULL;
+    }
+
+    s->rows = lv_mem_alloc(2 * (s->stride + 1));
+    LV_ASSERT_MALLOC(s->rows);
+    if(s->rows == NULL) {
+        _lv_png_stream_close(s);
+        return NULL;
+    }
+
+    if(!restart(s)) {
+        _lv_png_stream_close(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+lv_res_t _lv_png_stream_read_line(_lv_png_stream_t * s, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    if(x < 0 || y < 0 || len < 0 || (uint32_t)(x + len) > s->w || (uint32_t)y >= s->h) return LV_RES_INV;
+
+    /*The line is decoded already or it's above. The current line is kept to be read in more parts.*/
+    if((uint32_t)y + 1 < s->next_y) {
+        if(!restart(s)) return LV_RES_INV;
+    }
+
+    while(s->next_y <= (uint32_t)y) {
+        if(!decode_row(s)) {
+            LV_LOG_WARN("invalid PNG image data");
+            /*Try again from the beginning next time*/
+            s->next_y = UINT32_MAX;
+            return LV_RES_INV;
+        }
+    }
+
+    const uint8_t * row = s->cur + 1;
+    uint8_t depth = s->depth;
+    /*Scale the gray values of the small depths to 0..255*/
+    uint8_t gray_scale = depth == 1 ? 255 : depth == 2 ? 85 : depth == 4 ? 17 : 1;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t px = x + i;
+        uint8_t r, g, b, a;
+        switch(s->color_type) {
+            case 0: {   /*Gray*/
+                    uint16_t v;
+                    if(depth == 16) v = (row[px * 2] << 8) | row[px * 2 + 1];
+                    else if(depth == 8) v = row[px];
+                    else v = (row[(px * depth) >> 3] >> (8 - depth - ((px * depth) & 7))) & ((1 << depth) - 1);
+                    a = s->has_trns && v == s->trns[0] ? 0x00 : 0xff;
+                    r = depth == 16 ? v >> 8 : v * gray_scale;
+                    g = r;
+                    b = r;
+                    break;
+                }
+            case 2:     /*RGB*/
+                if(depth == 16) {
+                    const uint8_t * p = &row[px * 6];
+                    r = p[0];
+                    g = p[2];
+                    b = p[4];
+                    a = s->has_trns && ((p[0] << 8) | p[1]) == s->trns[0] && ((p[2] << 8) | p[3]) == s->trns[1] &&
+                        ((p[4] << 8) | p[5]) == s->trns[2] ? 0x00 : 0xff;
+                }
+                else {
+                    const uint8_t * p = &row[px * 3];
+                    r = p[0];
+                    g = p[1];
+                    b = p[2];
+                    a = s->has_trns && r == s->trns[0] && g == s->trns[1] && b == s->trns[2] ? 0x00 : 0xff;
+                }
+                break;
+            case 3: {   /*Palette*/
+                    uint8_t idx;
+                    if(depth == 8) idx = row[px];
+                    else idx = (row[(px * depth) >> 3] >> (8 - depth - ((px * depth) & 7))) & ((1 << depth) - 1);
+                    const lv_color32_t * c = &s->palette[idx];
+                    /*Stored in RGBA byte order*/
+                    r = c->ch.blue;
+                    g = c->ch.green;
+                    b = c->ch.red;
+                    a = c->ch.alpha;
+                    break;
+                }
+            case 4:     /*Gray with alpha*/
+                if(depth == 16) {
+                    r = row[px * 4];
+                    a = row[px * 4 + 2];
+                }
+                else {
+                    r = row[px * 2];
+                    a = row[px * 2 + 1];
+                }
+                g = r;
+                b = r;
+                break;
+            default:    /*RGBA*/
+                if(depth == 16) {
+                    const uint8_t * p = &row[px * 8];
+                    r = p[0];
+                    g = p[2];
+                    b = p[4];
+                    a = p[6];
+                }
+                else {
+                    const uint8_t * p = &row[px * 4];
+                    r = p[0];
+                    g = p[1];
+                    b = p[2];
+                    a = p[3];
+                }
+                break;
+        }
+
+        write_px(buf, r, g, b, a);
+        buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+
+    return LV_RES_OK;
+}
+
+void _lv_png_stream_close(_lv_png_stream_t * s)
+{
+    if(s->data == NULL) lv_fs_close(&s->file);
+    if(s->rows) lv_mem_free(s->rows);
+    lv_mem_free(s);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Read the chunks until the first IDAT*/
+static bool read_header(_lv_png_stream_t * s)
+{
+    static const uint8_t signature[8] = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
+    uint32_t i;
+    for(i = 0; i < sizeof(signature); i++) {
+        if(src_byte(s) != signature[i]) return false;
+    }
+
+    bool ihdr_found = false;
+    while(!s->eof) {
+        uint32_t len = src_u32(s);
+        uint32_t type = src_u32(s);
+        uint32_t data_pos = s->src_pos;
+        /*Not allowed by the PNG spec and the position of the next chunk would wrap around*/
+        if(len > 0x7fffffff) return false;
+
+        if(type == CHUNK_IHDR) {
+            s->w = src_u32(s);
+            s->h = src_u32(s);
+            s->depth = src_byte(s);
+            s->color_type = src_byte(s);
+            uint8_t compression = src_byte(s);
+            uint8_t filter = src_byte(s);
+            uint8_t interlace = src_byte(s);
+            if(compression != 0 || filter != 0 || interlace != 0) return false;
+            /*Must fit into the 11 bits of `lv_img_header_t`*/
+            if(s->w == 0 || s->h == 0 || s->w > 2047 || s->h > 2047) return false;
+
+            uint8_t channels;
+            switch(s->color_type) {
+                case 0:
+                    channels = 1;
+                    if(s->depth != 1 && s->depth != 2 && s->depth != 4 && s->depth != 8 && s->depth != 16) return false;
+                    break;
+                case 3:
+                    channels = 1;
+                    if(s->depth != 1 && s->depth != 2 && s->depth != 4 && s->depth != 8) return false;
+                    break;
+                case 2:
+                case 4:
+                case 6:
+                    channels = s->color_type == 2 ? 3 : s->color_type == 4 ? 2 : 4;
+                    if(s->depth != 8 && s->depth != 16) return false;
+                    break;
+                default:
+                    return false;
+            }
+
+            uint32_t px_bits = channels * s->depth;
+            s->stride = (s->w * px_bits + 7) >> 3;
+            s->filter_bpp = px_bits < 8 ? 1 : px_bits >> 3;
+            ihdr_found = true;
+        }
+        else if(type == CHUNK_PLTE) {
+            if(len > 256 * 3 || len % 3) return false;
+            for(i = 0; i < len / 3; i++) {
+                s->palette[i].ch.blue = src_byte(s);    /*RGBA byte order*/
+                s->palette[i].ch.green = src_byte(s);
+                s->palette[i].ch.red = src_byte(s);
+                s->palette[i].ch.alpha = 0xff;
+            }
+        }
+        else if(type == CHUNK_TRNS) {
+            if(s->color_type == 3) {
+                if(len > 256) return false;
+                for(i = 0; i < len; i++) s->palette[i].ch.alpha = src_byte(s);
+            }
+            else if(s->color_type == 0 || s->color_type == 2) {
+                uint32_t n = s->color_type == 0 ? 1 : 3;
+                if(len != n * 2) return false;
+                for(i = 0; i < n; i++) {
+                    s->trns[i] = src_byte(s) << 8;
+                    s->trns[i] |= src_byte(s);
+                }
+                s->has_trns = 1;
+            }
+        }
+        else if(type == CHUNK_IDAT) {
+            if(!ihdr_found) return false;
+            s->idat_start = data_pos;
+            s->idat_start_len = len;
+            return true;
+        }
+        else if(type == CHUNK_IEND) {
+            return false;
+        }
+
+        /*Skip the rest of the chunk and the CRC*/
+        src_seek(s, data_pos + len + 4);
+    }
+
+    return false;
+}
+
+/*Start the decompression from the first line*/
+static bool restart(_lv_png_stream_t * s)
+{
+    src_seek(s, s->idat_start);
+    s->idat_left = s->idat_start_len;
+    s->bit_buf = 0;
+    s->bit_cnt = 0;
+    s->state = INFLATE_BLOCK_START;
+    s->last_block = 0;
+    s->eof = 0;
+    s->copy_len = 0;
+    s->win_pos = 0;
+    s->next_y = 0;
+    /*The line above the first line is considered to be 0*/
+    lv_memset_00(s->rows, 2 * (s->stride + 1));
+    s->cur = s->rows;
+    s->prev = s->rows + s->stride + 1;
+
+    /*zlib header*/
+    uint8_t cmf = read_idat_byte(s);
+    uint8_t flg = read_idat_byte(s);
+    if((cmf & 0x0f) != 8 || (flg & 0x20) || ((cmf << 8) | flg) % 31) return false;
+    return !s->eof;
+}
+
+static bool decode_row(_lv_png_stream_t * s)
+{
+    if(s->next_y >= s->h) return false;
+
+    uint8_t * tmp = s->prev;
+    s->prev = s->cur;
+    s->cur = tmp;
+
+    if(!inflate_read(s, s->cur, s->stride + 1)) return false;
+    if(s->cur[0] > 4) return false;
+    unfilter(s->cur + 1, s->prev + 1, s->stride, s->filter_bpp, s->cur[0]);
+    s->next_y++;
+    return true;
+}
+
+static void unfilter(uint8_t * row, const uint8_t * prev, uint32_t stride, uint8_t bpp, uint8_t type)
+{
+    uint32_t i;
+    switch(type) {
+        case 1:     /*Sub*/
+            for(i = bpp; i < stride; i++) row[i] += row[i - bpp];
+            break;
+        case 2:     /*Up*/
+            for(i = 0; i < stride; i++) row[i] += prev[i];
+            break;
+        case 3:     /*Average*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+            for(; i < stride; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4:     /*Paeth*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i];
+            for(; i < stride; i++) {
+                int16_t a = row[i - bpp];
+                int16_t b = prev[i];
+                int16_t c = prev[i - bpp];
+                int16_t pa = LV_ABS(b - c);
+                int16_t pb = LV_ABS(a - c);
+                int16_t pc = LV_ABS(a + b - 2 * c);
+                if(pa <= pb && pa <= pc) row[i] += a;
+                else if(pb <= pc) row[i] += b;
+                else row[i] += c;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*Make sure at least `n` bits are in `bit_buf`*/
+static inline void need_bits(_lv_png_stream_t * s, uint8_t n)
+{
+    while(s->bit_cnt < n) {
+        s->bit_buf |= (uint32_t)read_idat_byte(s) << s->bit_cnt;
+        s->bit_cnt += 8;
+    }
+}
+
+static inline uint32_t get_bits(_lv_png_stream_t * s, uint8_t n)
+{
+    need_bits(s, n);
+    uint32_t v = s->bit_buf & ((1UL << n) - 1);
+    s->bit_buf >>= n;
+    s->bit_cnt -= n;
+    return v;
+}
+
+/*Decompress the next `n` bytes*/
+static bool inflate_read(_lv_png_stream_t * s, uint8_t * out, uint32_t n)
+{
+    uint8_t * window = s->window;
+    uint32_t i = 0;
+    while(i < n) {
+        /*Copy the pending part of a match from the window*/
+        if(s->copy_len) {
+            uint32_t cnt = LV_MIN(s->copy_len, n - i);
+            uint32_t src = s->win_pos - s->copy_dist;
+            s->copy_len -= cnt;
+            while(cnt) {
+                uint8_t v = window[src++ & WINDOW_MASK];
+                window[s->win_pos++ & WINDOW_MASK] = v;
+                out[i++] = v;
+                cnt--;
+            }
+            continue;
+        }
+
+        if(s->state == INFLATE_HUFFMAN) {
+            int32_t sym = huffman_decode(s, &s->lit);
+            if(sym < 256) {
+                if(sym < 0) return false;
+                window[s->win_pos++ & WINDOW_MASK] = (uint8_t)sym;
+                out[i++] = (uint8_t)sym;
+            }
+            else if(sym == 256) {
+                s->state = INFLATE_BLOCK_START;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return false;
+                s->copy_len = len_base[sym] + get_bits(s, len_extra[sym]);
+                int32_t dsym = huffman_decode(s, &s->dist);
+                if(dsym < 0 || dsym >= 30) return false;
+                s->copy_dist = dist_base[dsym] + get_bits(s, dist_extra[dsym]);
+                if(s->copy_dist > s->win_pos) return false;
+            }
+        }
+        else if(s->state == INFLATE_STORED) {
+            if(s->stored_left == 0) {
+                s->state = INFLATE_BLOCK_START;
+                continue;
+            }
+            uint8_t v = get_bits(s, 8);
+            window[s->win_pos++ & WINDOW_MASK] = v;
+            out[i++] = v;
+            s->stored_left--;
+        }
+        else {
+            if(s->last_block) return false;     /*There is no more data*/
+            s->last_block = get_bits(s, 1);
+            uint32_t type = get_bits(s, 2);
+            if(type == 0) {
+                /*Stored block: skip to the byte boundary and read the length*/
+                get_bits(s, s->bit_cnt & 7);
+                uint32_t len = get_bits(s, 16);
+                uint32_t nlen = get_bits(s, 16);
+                if((len ^ 0xffff) != nlen) return false;
+                s->stored_left = len;
+                s->state = INFLATE_STORED;
+            }
+            else if(type == 1) {
+                if(!build_fixed(s)) return false;
+                s->state = INFLATE_HUFFMAN;
+            }
+            else if(type == 2) {
+                if(!build_dynamic(s)) return false;
+                s->state = INFLATE_HUFFMAN;
+            }
+            else {
+                return false;
+            }
+        }
+
+        if(s->eof) return false;
+    }
+
+    return true;
+}
+
+/*Build the canonical Huffman code from the code lengths of the symbols*/
+static bool huffman_build(huffman_t * h, const uint8_t * lengths, uint32_t n)
+{
+    uint16_t offs[16];
+    uint32_t i;
+    uint32_t len;
+
+    lv_memset_00(h->count, sizeof(h->count));
+    for(i = 0; i < n; i++) h->count[lengths[i]]++;
+    h->count[0] = 0;
+
+    /*Over-subscribed codes are invalid. Incomplete ones are allowed, e.g. with only one distance code.*/
+    int32_t left = 1;
+    for(len = 1; len < 16; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if(left < 0) return false;
+    }
+
+    offs[1] = 0;
+    for(len = 1; len < 15; len++) offs[len + 1] = offs[len] + h->count[len];
+    for(i = 0; i < n; i++) {
+        if(lengths[i]) h->symbol[offs[lengths[i]]++] = i;
+    }
+
+    /*The bits of the codes are stored in reversed order in the stream*/
+    lv_memset_00(h->fast, sizeof(h->fast));
+    uint32_t code = 0;
+    uint32_t idx = 0;
+    for(len = 1; len <= FAST_BITS; len++) {
+        for(i = 0; i < h->count[len]; i++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+            uint16_t entry = (h->symbol[idx] << 4) | len;
+            for(; rev <= FAST_MASK; rev += 1 << len) h->fast[rev] = entry;
+            code++;
+            idx++;
+        }
+        code <<= 1;
+    }
+
+    return true;
+}
+
+static bool build_fixed(_lv_png_stream_t * s)
+{
+    uint8_t lengths[288];
+    uint32_t i;
+    for(i = 0; i < 144; i++) lengths[i] = 8;
+    for(; i < 256; i++) lengths[i] = 9;
+    for(; i < 280; i++) lengths[i] = 7;
+    for(; i < 288; i++) lengths[i] = 8;
+    if(!huffman_build(&s->lit, lengths, 288)) return false;
+
+    for(i = 0; i < 30; i++) lengths[i] = 5;
+    return huffman_build(&s->dist, lengths, 30);
+}
+
+static bool build_dynamic(_lv_png_stream_t * s)
+{
+    uint8_t lengths[286 + 30];
+    uint32_t nlen = get_bits(s, 5) + 257;
+    uint32_t ndist = get_bits(s, 5) + 1;
+    uint32_t ncode = get_bits(s, 4) + 4;
+    if(nlen > 286 || ndist > 30) return false;
+
+    /*The code of the code lengths. `dist` is used temporarily.*/
+    uint32_t i;
+    lv_memset_00(lengths, 19);
+    for(i = 0; i < ncode; i++) lengths[clen_order[i]] = get_bits(s, 3);
+    if(!huffman_build(&s->dist, lengths, 19)) return false;
+
+    i = 0;
+    while(i < nlen + ndist) {
+        int32_t sym = huffman_decode(s, &s->dist);
+        if(sym < 0) return false;
+        if(sym < 16) {
+            lengths[i++] = sym;
+            continue;
+        }
+
+        uint8_t v = 0;
+        uint32_t rep;
+        if(sym == 16) {
+            if(i == 0) return false;
+            v = lengths[i - 1];
+            rep = 3 + get_bits(s, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + get_bits(s, 3);
+        }
+        else {
+            rep = 11 + get_bits(s, 7);
+        }
+        if(i + rep > nlen + ndist) return false;
+        while(rep--) lengths[i++] = v;
+    }
+
+    if(lengths[256] == 0) return false;     /*No end of block code*/
+    if(!huffman_build(&s->lit, lengths, nlen)) return false;
+    return huffman_build(&s->dist, lengths + nlen, ndist);
+}
+
+static int32_t huffman_decode(_lv_png_stream_t * s, const huffman_t * h)
+{
+    need_bits(s, FAST_BITS);
+    uint16_t entry = h->fast[s->bit_buf & FAST_MASK];
+    if(entry) {
+        uint8_t len = entry & 0xf;
+        s->bit_buf >>= len;
+        s->bit_cnt -= len;
+        return entry >> 4;
+    }
+
+    /*A long code: walk the codes length by length*/
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t idx = 0;
+    uint32_t len;
+    for(len = 1; len < 16; len++) {
+        code |= get_bits(s, 1);
+        int32_t count = h->count[len];
+        if(code - first < count) return h->symbol[idx + (code - first)];
+        idx += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/*Read the next byte of the zlib stream stored in the consecutive IDAT chunks*/
+static uint8_t read_idat_byte(_lv_png_stream_t * s)
+{
+    while(s->idat_left == 0) {
+        if(s->eof) return 0;
+        src_seek(s, s->src_pos + 4);    /*CRC*/
+        s->idat_left = src_u32(s);
+        if(src_u32(s) != CHUNK_IDAT) {
+            s->idat_left = 0;
+            s->eof = 1;
+            return 0;
+        }
+    }
+
+    s->idat_left--;
+    return src_byte(s);
+}
+
+static uint8_t src_byte(_lv_png_stream_t * s)
+{
+    if(s->data) {
+        if(s->src_pos >= s->data_size) {
+            s->eof = 1;
+            return 0;
+        }
+        return s->data[s->src_pos++];
+    }
+
+    if(s->in_pos >= s->in_len) {
+        uint32_t rn = 0;
+        lv_fs_read(&s->file, s->in_buf, IN_BUF_SIZE, &rn);
+        s->in_len = rn;
+        s->in_pos = 0;
+        if(rn == 0) {
+            s->eof = 1;
+            return 0;
+        }
+    }
+    s->src_pos++;
+    return s->in_buf[s->in_pos++];
+}
+
+/*Read a big endian 32 bit number*/
+static uint32_t src_u32(_lv_png_stream_t * s)
+{
+    uint32_t v = (uint32_t)src_byte(s) << 24;
+    v |= (uint32_t)src_byte(s) << 16;
+    v |= (uint32_t)src_byte(s) << 8;
+    v |= src_byte(s);
+    return v;
+}
+
+static void src_seek(_lv_png_stream_t * s, uint32_t pos)
+{
+    if(s->data == NULL) {
+        /*Stay in the buffer if possible*/
+        uint32_t buf_start = s->src_pos - s->in_pos;
+        if(pos >= buf_start && pos < buf_start + s->in_len) {
+            s->in_pos = pos - buf_start;
+        }
+        else {
+            lv_fs_seek(&s->file, pos, LV_FS_SEEK_SET);
+            s->in_pos = 0;
+            s->in_len = 0;
+        }
+    }
+    s->src_pos = pos;
+}
+
+/*Same format as `LV_IMG_CF_TRUE_COLOR_ALPHA`*/
+static void write_px(uint8_t * buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+#if LV_COLOR_DEPTH == 32
+    buf[0] = b;
+    buf[1] = g;
+    buf[2] = r;
+    buf[3] = a;
+#elif LV_COLOR_DEPTH == 16
+    lv_color_t c = lv_color_make(r, g, b);
+    buf[0] = c.full & 0xff;
+    buf[1] = c.full >> 8;
+    buf[2] = a;
+#elif LV_COLOR_DEPTH == 8
+    lv_color_t c = lv_color_make(r, g, b);
+    buf[0] = c.full;
+    buf[1] = a;
+#elif LV_COLOR_DEPTH == 1
+    buf[0] = (r | g | b) > 128 ? 1 : 0;
+    buf[1] = a;
+#endif
+}
+
+#endif /*LV_USE_PNG*/
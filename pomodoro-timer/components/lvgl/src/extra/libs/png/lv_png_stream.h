@@ -0,0 +1,72 @@
+/**
+ * @file lv_png_stream.h
+ * Decode PNG images line by line with a small, constant amount of memory
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_PNG
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct _lv_png_stream_t _lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prepare a PNG image to be decoded line by line.
+ * Only the header is read here, the image data is decompressed by `_lv_png_stream_read_line()`.
+ * @param src       path to a PNG file or pointer to an `lv_img_dsc_t` with PNG data
+ * @param src_type  type of `src`
+ * @return          the stream or NULL if the image can't be streamed (e.g. it's interlaced or invalid)
+ */
+_lv_png_stream_t * _lv_png_stream_open(const void * src, lv_img_src_t src_type);
+
+/**
+ * Read a part of a line of the image in the color format of `LV_IMG_CF_TRUE_COLOR_ALPHA`.
+ * The lines are decoded from the last read line, so reading them from top to bottom is the fastest.
+ * Reading an earlier line starts the decompression again from the beginning.
+ * @param stream    pointer to a stream opened by `_lv_png_stream_open()`
+ * @param x         start x coordinate
+ * @param y         the line to read
+ * @param len       number of pixels to read
+ * @param buf       store the pixels here (`len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes)
+ * @return          LV_RES_OK: success; LV_RES_INV: the image data is invalid
+ */
+lv_res_t _lv_png_stream_read_line(_lv_png_stream_t * stream, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                  uint8_t * buf);
+
+/**
+ * Close the source of a stream and free it
+ * @param stream    pointer to a stream opened by `_lv_png_stream_open()`
+ */
+void _lv_png_stream_close(_lv_png_stream_t * stream);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PNG*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
@@ -65,6 +65,8 @@
 #define SJPEG_BLOCK_WIDTH_OFFSET        20
 #define SJPEG_FRAME_INFO_ARRAY_OFFSET   22
 
+#define PREFETCH_STACK_SIZE             (8 * 1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -85,21 +87,52 @@ typedef struct {
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
+typedef enum {
+    FRAME_FREE,                         //No valid pixels
+    FRAME_READY,
+    FRAME_PREFETCHING,                  //Being decoded by the prefetch thread
+} frame_state_t;
 
 typedef struct {
+    uint8_t * buf;                      //RGB888 pixels of the frame. Allocated when used first.
+    int frame_index;
+    uint32_t life;                      //`frame_cache_clock` when the frame was used last
+    frame_state_t state;
+} frame_cache_t;
+
+#if _LV_SJPG_PREFETCH
+typedef struct _prefetch_t {
+    struct _prefetch_t * next;          //Next in the list of the prefetch thread
+    struct _SJPEG * sjpeg;
+    JDEC * tjpeg_jd;                    //Own decoder and file as the drawing thread decodes meanwhile too
+    uint8_t * workb;
+    io_source_t io;
+    frame_cache_t * frame;              //The frame being decoded. NULL if no prefetch is in progress.
+    int frame_index;
+    bool done;                          //Set by the prefetch thread
+    JRESULT res;
+} prefetch_t;
+#endif
+
+typedef struct _SJPEG {
     uint8_t * sjpeg_data;
     uint32_t sjpeg_data_size;
     int sjpeg_x_res;
     int sjpeg_y_res;
     int sjpeg_total_frames;
     int sjpeg_single_frame_height;
-    int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    frame_cache_t * frame_cache;        //Decoded frames. The least recently used one is replaced.
+    int frame_cache_cnt;
+    uint32_t frame_cache_clock;         //Incremented when the read lines move to an other frame
+    int last_frame_index;               //Frame of the last read line. -1 at the beginning.
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
+#if _LV_SJPG_PREFETCH
+    prefetch_t prefetch;
+#endif
 } SJPEG;
 
 /**********************
@@ -114,10 +147,32 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static lv_res_t frame_cache_init(SJPEG * sjpeg);
+static frame_cache_t * frame_cache_find(SJPEG * sjpeg, int frame_index);
+static frame_cache_t * frame_cache_get_free(SJPEG * sjpeg, const frame_cache_t * keep);
+static uint8_t * get_frame(SJPEG * sjpeg, int frame_index);
+static JRESULT decode_frame(SJPEG * sjpeg, JDEC * jd, uint8_t * workb, io_source_t * io, int frame_index,
+                            uint8_t * buf);
+#if _LV_SJPG_PREFETCH
+    static void prefetch_init(SJPEG * sjpeg, const char * fn);
+    static void prefetch_start(SJPEG * sjpeg, int frame_index, const frame_cache_t * keep);
+    static void prefetch_wait(SJPEG * sjpeg);
+    static void prefetch_thread(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t cache_size = LV_SJPG_CACHE_SIZE;
+static lv_split_jpeg_stats_t stats;
+
+#if _LV_SJPG_PREFETCH
+    static bool prefetch_thread_started;
+    static lv_mutex_t prefetch_lock;            //Protects the list and the `done` flags
+    static lv_thread_sync_t prefetch_sync;      //Wakes up the prefetch thread
+    static lv_thread_sync_t prefetch_done_sync; //Signaled when a frame is prefetched
+    static prefetch_t * prefetch_todo;
+#endif
 
 /**********************
  *      MACROS
@@ -133,6 +188,28 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+
+#if _LV_SJPG_PREFETCH
+    /*Start the thread here as the images might be opened in the background too*/
+    if(!prefetch_thread_started) {
+        if(lv_mutex_init(&prefetch_lock) != LV_RES_OK) return;
+        if(lv_thread_sync_init(&prefetch_sync) != LV_RES_OK) return;
+        if(lv_thread_sync_init(&prefetch_done_sync) != LV_RES_OK) return;
+        lv_thread_t thread;
+        if(lv_thread_init(&thread, prefetch_thread, PREFETCH_STACK_SIZE, NULL) != LV_RES_OK) return;
+        prefetch_thread_started = true;
+    }
+#endif
+}
+
+void lv_split_jpeg_set_cache_size(uint32_t size)
+{
+    cache_size = size;
+}
+
+void lv_split_jpeg_get_stats(lv_split_jpeg_stats_t * stats_p)
+{
+    *stats_p = stats;
 }
 
 /**********************
@@ -395,15 +472,11 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 offset |= *data++ << 8;
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
-            sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
+            if(frame_cache_init(sjpeg) != LV_RES_OK) {
                 lv_sjpg_cleanup(sjpeg);
                 sjpeg = NULL;
                 return LV_RES_INV;
             }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-            sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
                 lv_sjpg_cleanup(sjpeg);
@@ -419,6 +492,9 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
             }
             sjpeg->io.type = SJPEG_IO_SOURCE_C_ARRAY;
             sjpeg->io.lv_file.file_d = NULL;
+#if _LV_SJPG_PREFETCH
+            prefetch_init(sjpeg, NULL);
+#endif
             dsc->img_data = NULL;
             return lv_ret;
         }
@@ -458,16 +534,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 uint8_t * img_frame_base = sjpeg->sjpeg_data;
                 sjpeg->frame_base_array[0] = img_frame_base;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(frame_cache_init(sjpeg) != LV_RES_OK) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_sjpg_cleanup(sjpeg);
@@ -577,15 +649,11 @@ end:
                     sjpeg->frame_base_offset[i] = sjpeg->frame_base_offset[i - 1] + offset;
                 }
 
-                sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(frame_cache_init(sjpeg) != LV_RES_OK) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -602,6 +670,9 @@ end:
 
                 sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
                 sjpeg->io.lv_file = lv_file;
+#if _LV_SJPG_PREFETCH
+                prefetch_init(sjpeg, fn);
+#endif
                 dsc->img_data = NULL;
                 return LV_RES_OK;
             }
@@ -665,16 +736,12 @@ end:
                 int img_frame_start_offset = 0;
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(frame_cache_init(sjpeg) != LV_RES_OK) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -722,143 +789,53 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
 
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    uint8_t * frame = get_frame(sjpeg, y / sjpeg->sjpeg_single_frame_height);
+    if(frame == NULL) return LV_RES_INV;
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
+    int offset = 0;
+    uint8_t * cache = frame + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res * 3;
 
 #if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+    for(int i = 0; i < len; i++) {
+        buf[offset + 3] = 0xff;
+        buf[offset + 2] = *cache++;
+        buf[offset + 1] = *cache++;
+        buf[offset + 0] = *cache++;
+        offset += 4;
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
 
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
 #elif  LV_COLOR_DEPTH == 16
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
+    for(int i = 0; i < len; i++) {
+        uint16_t col_16bit = (*cache++ & 0xf8) << 8;
+        col_16bit |= (*cache++ & 0xFC) << 3;
+        col_16bit |= (*cache++ >> 3);
 #if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
 #else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
 #endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    }
 
 #elif  LV_COLOR_DEPTH == 8
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
+    for(int i = 0; i < len; i++) {
+        uint8_t col_8bit = (*cache++ & 0xC0);
+        col_8bit |= (*cache++ & 0xe0) >> 2;
+        col_8bit |= (*cache++ & 0xe0) >> 5;
+        buf[offset++] = col_8bit;
+    }
 #else
 #error Unsupported LV_COLOR_DEPTH
 
 
 #endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
+    return LV_RES_OK;
 }
 
 /**
@@ -899,7 +876,19 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
+#if _LV_SJPG_PREFETCH
+    prefetch_t * prefetch = &sjpeg->prefetch;
+    prefetch_wait(sjpeg);
+    if(prefetch->io.lv_file.file_d) lv_fs_close(&prefetch->io.lv_file);
+    if(prefetch->tjpeg_jd) lv_mem_free(prefetch->tjpeg_jd);
+    if(prefetch->workb) lv_mem_free(prefetch->workb);
+#endif
+    if(sjpeg->frame_cache) {
+        for(int i = 0; i < sjpeg->frame_cache_cnt; i++) {
+            if(sjpeg->frame_cache[i].buf) lv_mem_free(sjpeg->frame_cache[i].buf);
+        }
+        lv_mem_free(sjpeg->frame_cache);
+    }
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
@@ -914,4 +903,245 @@ static void lv_sjpg_cleanup(SJPEG * sjpeg)
     lv_mem_free(sjpeg);
 }
 
+static lv_res_t frame_cache_init(SJPEG * sjpeg)
+{
+    uint32_t frame_size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3;
+    int cnt = (int)LV_MIN(cache_size / frame_size, (uint32_t)sjpeg->sjpeg_total_frames);
+    if(cnt < 1) cnt = 1;
+
+    sjpeg->frame_cache = lv_mem_alloc(sizeof(frame_cache_t) * cnt);
+    if(! sjpeg->frame_cache) return LV_RES_INV;
+    lv_memset_00(sjpeg->frame_cache, sizeof(frame_cache_t) * cnt);
+    for(int i = 0; i < cnt; i++) sjpeg->frame_cache[i].frame_index = -1;
+    sjpeg->frame_cache_cnt = cnt;
+    sjpeg->last_frame_index = -1;
+
+    /*Fail already here if not even one frame fits into the memory*/
+    sjpeg->frame_cache[0].buf = lv_mem_alloc(frame_size);
+    if(! sjpeg->frame_cache[0].buf) return LV_RES_INV;
+
+    sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+    return LV_RES_OK;
+}
+
+static frame_cache_t * frame_cache_find(SJPEG * sjpeg, int frame_index)
+{
+    for(int i = 0; i < sjpeg->frame_cache_cnt; i++) {
+        frame_cache_t * frame = &sjpeg->frame_cache[i];
+        if(frame->state != FRAME_FREE && frame->frame_index == frame_index) return frame;
+    }
+    return NULL;
+}
+
+/*Get the least recently used frame to decode a new one into. Not `keep` and not the one being prefetched.*/
+static frame_cache_t * frame_cache_get_free(SJPEG * sjpeg, const frame_cache_t * keep)
+{
+    uint32_t frame_size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3;
+    bool allocated_only = false;
+    while(1) {
+        frame_cache_t * lru = NULL;
+        for(int i = 0; i < sjpeg->frame_cache_cnt; i++) {
+            frame_cache_t * frame = &sjpeg->frame_cache[i];
+            if(frame == keep || frame->state == FRAME_PREFETCHING) continue;
+            if(allocated_only && frame->buf == NULL) continue;
+            if(lru == NULL || frame->life < lru->life) lru = frame;
+        }
+
+        if(lru == NULL || lru->buf) return lru;
+
+        /*Use the already allocated frames if there is no memory for more*/
+        lru->buf = lv_mem_alloc(frame_size);
+        if(lru->buf) return lru;
+        allocated_only = true;
+    }
+}
+
+/*Get the decoded pixels of a frame from the cache or decode it now*/
+static uint8_t * get_frame(SJPEG * sjpeg, int frame_index)
+{
+    if(frame_index < 0 || frame_index >= sjpeg->sjpeg_total_frames) return NULL;
+
+    frame_cache_t * frame = frame_cache_find(sjpeg, frame_index);
+#if _LV_SJPG_PREFETCH
+    if(frame && frame->state == FRAME_PREFETCHING) {
+        prefetch_wait(sjpeg);
+        if(frame->state != FRAME_READY) frame = NULL;
+    }
+#endif
+
+    if(frame == NULL) {
+        frame = frame_cache_get_free(sjpeg, NULL);
+        if(frame == NULL) return NULL;
+        frame->state = FRAME_FREE;
+        if(decode_frame(sjpeg, sjpeg->tjpeg_jd, sjpeg->workb, &sjpeg->io, frame_index, frame->buf) != JDR_OK) {
+            return NULL;
+        }
+        frame->state = FRAME_READY;
+        frame->frame_index = frame_index;
+        stats.decoded_cnt++;
+    }
+    else if(frame_index != sjpeg->last_frame_index) {
+        stats.hit_cnt++;
+    }
+
+    if(frame_index != sjpeg->last_frame_index) {
+        sjpeg->frame_cache_clock++;
+        frame->life = sjpeg->frame_cache_clock;
+#if _LV_SJPG_PREFETCH
+        /*Moving to the neighbor frame probably means drawing or scrolling in that direction*/
+        int step = frame_index - sjpeg->last_frame_index;
+        if(sjpeg->last_frame_index >= 0 && (step == 1 || step == -1)) {
+            prefetch_start(sjpeg, frame_index + step, frame);
+        }
+#endif
+        sjpeg->last_frame_index = frame_index;
+    }
+
+    return frame->buf;
+}
+
+/*Decode a frame into `buf`. The decoder, work buffer and source are parameters to be usable from any thread.*/
+static JRESULT decode_frame(SJPEG * sjpeg, JDEC * jd, uint8_t * workb, io_source_t * io, int frame_index,
+                            uint8_t * buf)
+{
+    if(io->type == SJPEG_IO_SOURCE_C_ARRAY) {
+        io->raw_sjpg_data = sjpeg->frame_base_array[frame_index];
+        if(frame_index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(io->raw_sjpg_data - sjpeg->sjpeg_data);
+            io->raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+        }
+        else {
+            io->raw_sjpg_data_size = (uint32_t)(sjpeg->frame_base_array[frame_index + 1] - io->raw_sjpg_data);
+        }
+        io->raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        io->raw_sjpg_data_next_read_pos = (uint32_t)sjpeg->frame_base_offset[frame_index];
+        lv_fs_seek(&io->lv_file, io->raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+
+    io->img_cache_buff = buf;
+    io->img_cache_x_res = sjpeg->sjpeg_x_res;
+
+    JRESULT rc = jd_prepare(jd, input_func, workb, (size_t)TJPGD_WORKBUFF_SIZE, io);
+    if(rc != JDR_OK) return rc;
+    return jd_decomp(jd, img_data_cb, 0);
+}
+
+#if _LV_SJPG_PREFETCH
+/*Allocate an other decoder for the prefetch thread. If it fails the image is used without prefetch.*/
+static void prefetch_init(SJPEG * sjpeg, const char * fn)
+{
+    prefetch_t * prefetch = &sjpeg->prefetch;
+    if(!prefetch_thread_started || sjpeg->frame_cache_cnt < 2) return;
+
+    prefetch->io = sjpeg->io;
+    lv_memset_00(&prefetch->io.lv_file, sizeof(lv_fs_file_t));
+    if(fn) {
+        if(lv_fs_open(&prefetch->io.lv_file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            prefetch->io.lv_file.file_d = NULL;
+            return;
+        }
+    }
+
+    prefetch->workb = lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
+    prefetch->tjpeg_jd = lv_mem_alloc(sizeof(JDEC));
+    if(prefetch->workb == NULL || prefetch->tjpeg_jd == NULL) {
+        if(prefetch->workb) lv_mem_free(prefetch->workb);
+        if(prefetch->tjpeg_jd) lv_mem_free(prefetch->tjpeg_jd);
+        prefetch->workb = NULL;
+        prefetch->tjpeg_jd = NULL;
+        return;
+    }
+
+    prefetch->sjpeg = sjpeg;
+}
+
+/*Decode a frame in the prefetch thread if it's not cached yet and the previous prefetch is finished*/
+static void prefetch_start(SJPEG * sjpeg, int frame_index, const frame_cache_t * keep)
+{
+    prefetch_t * prefetch = &sjpeg->prefetch;
+    if(prefetch->tjpeg_jd == NULL || prefetch->frame) return;
+    if(frame_index < 0 || frame_index >= sjpeg->sjpeg_total_frames) return;
+    if(frame_cache_find(sjpeg, frame_index)) return;
+
+    frame_cache_t * frame = frame_cache_get_free(sjpeg, keep);
+    if(frame == NULL) return;
+
+    frame->state = FRAME_PREFETCHING;
+    frame->frame_index = frame_index;
+    frame->life = sjpeg->frame_cache_clock;
+    prefetch->frame = frame;
+    prefetch->frame_index = frame_index;
+    prefetch->done = false;
+
+    lv_mutex_lock(&prefetch_lock);
+    prefetch_t ** tail = &prefetch_todo;
+    while(*tail) tail = &(*tail)->next;
+    prefetch->next = NULL;
+    *tail = prefetch;
+    lv_mutex_unlock(&prefetch_lock);
+    lv_thread_sync_signal(&prefetch_sync);
+
+    stats.prefetched_cnt++;
+}
+
+/*Wait for the prefetch of an image to finish. If it hasn't started yet, just cancel it.*/
+static void prefetch_wait(SJPEG * sjpeg)
+{
+    prefetch_t * prefetch = &sjpeg->prefetch;
+    if(prefetch->frame == NULL) return;
+
+    bool canceled = false;
+    lv_mutex_lock(&prefetch_lock);
+    prefetch_t ** p;
+    for(p = &prefetch_todo; *p; p = &(*p)->next) {
+        if(*p == prefetch) {
+            *p = prefetch->next;
+            canceled = true;
+            break;
+        }
+    }
+    lv_mutex_unlock(&prefetch_lock);
+
+    while(!canceled) {
+        lv_mutex_lock(&prefetch_lock);
+        bool done = prefetch->done;
+        lv_mutex_unlock(&prefetch_lock);
+        if(done) break;
+        /*Signaled after every prefetched frame, maybe of an other image*/
+        lv_thread_sync_wait(&prefetch_done_sync);
+    }
+
+    prefetch->frame->state = !canceled && prefetch->res == JDR_OK ? FRAME_READY : FRAME_FREE;
+    prefetch->frame = NULL;
+}
+
+/*Runs in its own thread. Uses only the decoder and the source of the `prefetch_t` and the constant fields of `SJPEG`.*/
+static void prefetch_thread(void * user_data)
+{
+    LV_UNUSED(user_data);
+    while(1) {
+        lv_thread_sync_wait(&prefetch_sync);
+        while(1) {
+            lv_mutex_lock(&prefetch_lock);
+            prefetch_t * prefetch = prefetch_todo;
+            if(prefetch) prefetch_todo = prefetch->next;
+            lv_mutex_unlock(&prefetch_lock);
+            if(prefetch == NULL) break;
+
+            JRESULT res = decode_frame(prefetch->sjpeg, prefetch->tjpeg_jd, prefetch->workb, &prefetch->io,
+                                       prefetch->frame_index, prefetch->frame->buf);
+
+            lv_mutex_lock(&prefetch_lock);
+            prefetch->res = res;
+            prefetch->done = true;
+            lv_mutex_unlock(&prefetch_lock);
+            lv_thread_sync_signal(&prefetch_done_sync);
+        }
+    }
+}
+#endif /*_LV_SJPG_PREFETCH*/
+
 #endif /*LV_USE_SJPG*/
@@ -19,17 +19,44 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_SJPG_PREFETCH && LV_USE_OS != LV_OS_NONE
+#  define _LV_SJPG_PREFETCH  1
+#else
+#  define _LV_SJPG_PREFETCH  0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Statistics of the split JPG decoder.
+ */
+typedef struct {
+    uint32_t decoded_cnt;       /**< Number of frames decoded while drawing*/
+    uint32_t prefetched_cnt;    /**< Number of frames given to the prefetch thread*/
+    uint32_t hit_cnt;           /**< Number of frame changes served from the frame cache*/
+} lv_split_jpeg_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_split_jpeg_init(void);
 
+/**
+ * Set how many bytes of decoded frames (horizontal strips) an image can keep.
+ * Overrides `LV_SJPG_CACHE_SIZE` at run time. Affects only the images opened later.
+ * @param size      the limit in bytes. At least one frame is always kept.
+ */
+void lv_split_jpeg_set_cache_size(uint32_t size);
+
+/**
+ * Get the statistics of the split JPG decoder.
+ * @param stats     pointer to a `lv_split_jpeg_stats_t` variable, the result will be stored here
+ */
+void lv_split_jpeg_get_stats(lv_split_jpeg_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
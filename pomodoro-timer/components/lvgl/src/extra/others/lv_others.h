@@ -20,6 +20,7 @@ extern "C" {
 #include "imgfont/lv_imgfont.h"
 #include "msg/lv_msg.h"
 #include "ime/lv_ime_pinyin.h"
+#include "txt_atlas/lv_txt_atlas.h"
 
 /*********************
  *      DEFINES
@@ -0,0 +1,240 @@
+/**
+ * @file lv_txt_atlas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_txt_atlas.h"
+
+#if LV_USE_TXT_ATLAS
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t letter;
+    uint32_t bitmap_ofs;    /*Offset of the glyph's A8 bitmap in the atlas*/
+    uint16_t adv_w;         /*Advance width without kerning*/
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+} txt_atlas_glyph_t;
+
+typedef struct {
+    lv_font_t font;
+    uint32_t glyph_cnt;
+    txt_atlas_glyph_t * glyphs;
+    int8_t * kern;          /*glyph_cnt * glyph_cnt table of `adv_w` corrections for the glyph pairs*/
+    uint8_t * bitmap;       /*The bitmaps of all the glyphs one after the other, 1 byte per pixel*/
+    uint32_t bitmap_size;
+} txt_atlas_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const uint8_t * txt_atlas_get_glyph_bitmap(const lv_font_t * font, uint32_t unicode);
+static bool txt_atlas_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out,
+                                    uint32_t unicode, uint32_t unicode_next);
+static int32_t find_glyph(const txt_atlas_dsc_t * dsc, uint32_t letter);
+static void render_glyph(uint8_t * out, const uint8_t * bitmap, const lv_font_glyph_dsc_t * g);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_font_t * lv_txt_atlas_create(const lv_font_t * font, const char * glyphs)
+{
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(glyphs);
+
+    /*Count the glyphs and the size of their bitmaps*/
+    uint32_t glyph_cnt = 0;
+    uint32_t bitmap_size = 0;
+    uint32_t i = 0;
+    while(glyphs[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(glyphs, &i);
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) {
+            LV_LOG_WARN("glyph dsc. not found for U+%" PRIX32, letter);
+            continue;
+        }
+        glyph_cnt++;
+        bitmap_size += (uint32_t)g.box_w * g.box_h;
+    }
+
+    size_t size = sizeof(txt_atlas_dsc_t) + glyph_cnt * sizeof(txt_atlas_glyph_t) + glyph_cnt * glyph_cnt + bitmap_size;
+    txt_atlas_dsc_t * dsc = lv_mem_alloc(size);
+    LV_ASSERT_MALLOC(dsc);
+    if(dsc == NULL) return NULL;
+    lv_memset_00(dsc, size);
+
+    dsc->glyph_cnt = glyph_cnt;
+    dsc->glyphs = (txt_atlas_glyph_t *)(dsc + 1);
+    dsc->kern = (int8_t *)(dsc->glyphs + glyph_cnt);
+    dsc->bitmap = (uint8_t *)(dsc->kern + glyph_cnt * glyph_cnt);
+    dsc->bitmap_size = bitmap_size;
+
+    /*Render the glyphs into the atlas*/
+    uint32_t g_i = 0;
+    uint32_t bitmap_ofs = 0;
+    i = 0;
+    while(glyphs[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(glyphs, &i);
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) continue;
+
+        txt_atlas_glyph_t * ag = &dsc->glyphs[g_i];
+        ag->letter = letter;
+        ag->bitmap_ofs = bitmap_ofs;
+        ag->adv_w = g.adv_w;
+        ag->box_w = g.box_w;
+        ag->box_h = g.box_h;
+        ag->ofs_x = g.ofs_x;
+        ag->ofs_y = g.ofs_y;
+
+        if(g.box_w && g.box_h) {
+            const uint8_t * bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+            if(bitmap) render_glyph(&dsc->bitmap[bitmap_ofs], bitmap, &g);
+            bitmap_ofs += (uint32_t)g.box_w * g.box_h;
+        }
+        g_i++;
+    }
+
+    /*Store the kerning of all glyph pairs*/
+    uint32_t l;
+    uint32_t r;
+    for(l = 0; l < glyph_cnt; l++) {
+        for(r = 0; r < glyph_cnt; r++) {
+            lv_font_glyph_dsc_t g;
+            lv_font_get_glyph_dsc(font, &g, dsc->glyphs[l].letter, dsc->glyphs[r].letter);
+            int32_t k = (int32_t)g.adv_w - dsc->glyphs[l].adv_w;
+            dsc->kern[l * glyph_cnt + r] = (int8_t)LV_CLAMP(INT8_MIN, k, INT8_MAX);
+        }
+    }
+
+    lv_font_t * atlas_font = &dsc->font;
+    atlas_font->dsc = dsc;
+    atlas_font->get_glyph_dsc = txt_atlas_get_glyph_dsc;
+    atlas_font->get_glyph_bitmap = txt_atlas_get_glyph_bitmap;
+    atlas_font->line_height = font->line_height;
+    atlas_font->base_line = font->base_line;
+    atlas_font->subpx = LV_FONT_SUBPX_NONE;
+    atlas_font->underline_position = font->underline_position;
+    atlas_font->underline_thickness = font->underline_thickness;
+    atlas_font->fallback = font;
+
+    return atlas_font;
+}
+
+void lv_txt_atlas_del(lv_font_t * font)
+{
+    if(font == NULL) return;
+    lv_mem_free(font->dsc);
+}
+
+uint32_t lv_txt_atlas_get_size(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const txt_atlas_dsc_t * dsc = font->dsc;
+    return dsc->bitmap_size;
+}
+
+bool lv_txt_atlas_is_atlas(const lv_font_t * font)
+{
+    return font != NULL && font->get_glyph_bitmap == txt_atlas_get_glyph_bitmap;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int32_t find_glyph(const txt_atlas_dsc_t * dsc, uint32_t letter)
+{
+    /*The atlas is meant for a few glyphs, e.g. the digits of a clock, so a linear search is fine*/
+    uint32_t i;
+    for(i = 0; i < dsc->glyph_cnt; i++) {
+        if(dsc->glyphs[i].letter == letter) return (int32_t)i;
+    }
+    return -1;
+}
+
+static const uint8_t * txt_atlas_get_glyph_bitmap(const lv_font_t * font, uint32_t unicode)
+{
+    const txt_atlas_dsc_t * dsc = font->dsc;
+    int32_t i = find_glyph(dsc, unicode);
+    if(i < 0) return NULL;
+
+    return &dsc->bitmap[dsc->glyphs[i].bitmap_ofs];
+}
+
+static bool txt_atlas_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out,
+                                    uint32_t unicode, uint32_t unicode_next)
+{
+    const txt_atlas_dsc_t * dsc = font->dsc;
+    int32_t i = find_glyph(dsc, unicode);
+    if(i < 0) return false;
+
+    const txt_atlas_glyph_t * ag = &dsc->glyphs[i];
+    int32_t adv_w = ag->adv_w;
+    if(unicode_next != '\0') {
+        int32_t next_i = find_glyph(dsc, unicode_next);
+        if(next_i >= 0) {
+            adv_w += dsc->kern[i * dsc->glyph_cnt + next_i];
+        }
+        else {
+            /*The kerning with a glyph out of the atlas is not stored, ask the source font*/
+            lv_font_glyph_dsc_t g;
+            if(lv_font_get_glyph_dsc(font->fallback, &g, unicode, unicode_next)) adv_w = g.adv_w;
+        }
+    }
+
+    dsc_out->adv_w = (uint16_t)adv_w;
+    dsc_out->box_w = ag->box_w;
+    dsc_out->box_h = ag->box_h;
+    dsc_out->ofs_x = ag->ofs_x;
+    dsc_out->ofs_y = ag->ofs_y;
+    dsc_out->bpp = 8;
+    dsc_out->is_placeholder = false;
+
+    return true;
+}
+
+/**
+ * Convert a glyph's bitmap to 1 byte per pixel opacity values the same way `lv_draw_sw_letter` does
+ * @param out buffer for `box_w * box_h` bytes
+ * @param bitmap the glyph's bitmap in the font's format
+ * @param g the glyph's descriptor
+ */
+static void render_glyph(uint8_t * out, const uint8_t * bitmap, const lv_font_glyph_dsc_t * g)
+{
+    uint32_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t scale = 255 / mask;
+    uint32_t i;
+    uint32_t bit_ofs = 0;
+
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t shift = 8 - bpp - (bit_ofs & 0x7);
+        uint32_t px = (bitmap[bit_ofs >> 3] >> shift) & mask;
+        out[i] = (uint8_t)(px * scale);
+        bit_ofs += bpp;
+    }
+}
+
+#endif /*LV_USE_TXT_ATLAS*/
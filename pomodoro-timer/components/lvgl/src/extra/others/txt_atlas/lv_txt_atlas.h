@@ -0,0 +1,71 @@
+/**
+ * @file lv_txt_atlas.h
+ *
+ */
+
+#ifndef LV_TXT_ATLAS_H
+#define LV_TXT_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_TXT_ATLAS
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Render a fixed set of glyphs of a font once into an 8 bpp atlas and create a font which draws them from there.
+ * Glyphs not in the set are taken from the source font which is set as fallback.
+ * @param font the source font
+ * @param glyphs UTF-8 string with the glyphs to render, e.g. "0123456789:"
+ * @return pointer to the new font or NULL on error
+ */
+lv_font_t * lv_txt_atlas_create(const lv_font_t * font, const char * glyphs);
+
+/**
+ * Delete a font created by `lv_txt_atlas_create()`
+ * @param font pointer to an atlas font
+ */
+void lv_txt_atlas_del(lv_font_t * font);
+
+/**
+ * Get the size of an atlas font's glyph bitmaps
+ * @param font pointer to an atlas font
+ * @return size of the atlas in bytes
+ */
+uint32_t lv_txt_atlas_get_size(const lv_font_t * font);
+
+/**
+ * Check whether a font was created by `lv_txt_atlas_create()`
+ * @param font pointer to a font
+ * @return true: the font is an atlas font
+ */
+bool lv_txt_atlas_is_atlas(const lv_font_t * font);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_TXT_ATLAS*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TXT_ATLAS_H*/
@@ -18,6 +18,8 @@
 /*********************
  *      DEFINES
  *********************/
+#define GLYPH_CACHE_BUCKET_BITS     6
+#define GLYPH_CACHE_BUCKET_CNT      (1 << GLYPH_CACHE_BUCKET_BITS)
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +30,26 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_USE_FONT_COMPRESSED
+/*A decompressed glyph bitmap. The bitmap itself is stored right after this header.*/
+typedef struct _glyph_cache_entry_t {
+    struct _glyph_cache_entry_t * bucket_next;  /*Next entry with the same hash*/
+    struct _glyph_cache_entry_t * lru_prev;     /*More recently used entry*/
+    struct _glyph_cache_entry_t * lru_next;     /*Less recently used entry*/
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t letter;
+    uint32_t size;                              /*Size of the entry with the bitmap in bytes*/
+} glyph_cache_entry_t;
+
+typedef struct {
+    glyph_cache_entry_t * buckets[GLYPH_CACHE_BUCKET_CNT];
+    glyph_cache_entry_t * lru_head;
+    glyph_cache_entry_t * lru_tail;
+    size_t used;
+    uint32_t entry_cnt;
+} glyph_cache_t;
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -44,6 +66,10 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+
+    static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+    static uint8_t * glyph_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, uint32_t bitmap_size);
+    static void glyph_cache_remove(glyph_cache_entry_t * e);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -56,6 +82,9 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static uint8_t rle_prev_v;
     static uint8_t rle_cnt;
     static rle_state_t rle_state;
+
+    static size_t glyph_cache_max_size = LV_FONT_COMPR_CACHE_DEF_SIZE;
+    static lv_font_fmt_txt_cache_stats_t glyph_cache_stats;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -81,6 +110,15 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     if(unicode_letter == '\t') unicode_letter = ' ';
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+
+#if LV_USE_FONT_COMPRESSED
+    /*Neither the glyph id lookup nor the decompression is required if the glyph is cached*/
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+        const uint8_t * cached = glyph_cache_get(fdsc, unicode_letter);
+        if(cached) return cached;
+    }
+#endif
+
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
@@ -115,18 +153,23 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(last_buf_size < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MALLOC(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-            last_buf_size = buf_size;
+        /*Decompress into the cache if possible, else fall back to the shared buffer*/
+        uint8_t * out = glyph_cache_add(fdsc, unicode_letter, buf_size);
+        if(out == NULL) {
+            if(last_buf_size < buf_size) {
+                uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+                LV_ASSERT_MALLOC(tmp);
+                if(tmp == NULL) return NULL;
+                LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+                last_buf_size = buf_size;
+            }
+            out = LV_GC_ROOT(_lv_font_decompr_buf);
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        return out;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
         return NULL;
@@ -202,6 +245,82 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+/**
+ * Free the decompression buffer and the glyph cache.
+ * Not done in `_lv_font_clean_up_fmt_txt()` because that runs after every refresh and the cache should survive it.
+ */
+void _lv_font_deinit_fmt_txt(void)
+{
+#if LV_USE_FONT_COMPRESSED
+    _lv_font_clean_up_fmt_txt();
+
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) return;
+
+    while(cache->lru_tail) glyph_cache_remove(cache->lru_tail);
+    lv_mem_free(cache);
+    LV_GC_ROOT(_lv_font_glyph_cache) = NULL;
+#endif
+}
+
+void lv_font_fmt_txt_set_cache_size(size_t max_bytes)
+{
+#if LV_USE_FONT_COMPRESSED
+    glyph_cache_max_size = max_bytes;
+
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) return;
+
+    while(cache->lru_tail && cache->used > max_bytes) {
+        glyph_cache_remove(cache->lru_tail);
+    }
+
+    if(max_bytes == 0) {
+        lv_mem_free(cache);
+        LV_GC_ROOT(_lv_font_glyph_cache) = NULL;
+    }
+#else
+    LV_UNUSED(max_bytes);
+#endif
+}
+
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font)
+{
+#if LV_USE_FONT_COMPRESSED
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) return;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    glyph_cache_entry_t * e = cache->lru_head;
+    while(e) {
+        glyph_cache_entry_t * next = e->lru_next;
+        if(e->fdsc == fdsc) glyph_cache_remove(e);
+        e = next;
+    }
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+void lv_font_fmt_txt_get_cache_stats(lv_font_fmt_txt_cache_stats_t * stats)
+{
+#if LV_USE_FONT_COMPRESSED
+    *stats = glyph_cache_stats;
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    stats->used_bytes = cache ? cache->used : 0;
+    stats->entry_cnt = cache ? cache->entry_cnt : 0;
+#else
+    lv_memset_00(stats, sizeof(lv_font_fmt_txt_cache_stats_t));
+#endif
+}
+
+void lv_font_fmt_txt_reset_cache_stats(void)
+{
+#if LV_USE_FONT_COMPRESSED
+    lv_memset_00(&glyph_cache_stats, sizeof(glyph_cache_stats));
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -403,6 +522,120 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
     lv_mem_buf_release(line_buf2);
 }
 
+static inline glyph_cache_entry_t ** glyph_cache_bucket(glyph_cache_t * cache, const lv_font_fmt_txt_dsc_t * fdsc,
+                                                        uint32_t letter)
+{
+    uint32_t h = (uint32_t)(((lv_uintptr_t)fdsc >> 3) + letter);
+    h = (uint32_t)((h * 2654435761UL) & 0xFFFFFFFFUL) >> (32 - GLYPH_CACHE_BUCKET_BITS);
+    return &cache->buckets[h];
+}
+
+static inline void glyph_cache_lru_unlink(glyph_cache_t * cache, glyph_cache_entry_t * e)
+{
+    if(e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+    else cache->lru_head = e->lru_next;
+
+    if(e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+    else cache->lru_tail = e->lru_prev;
+}
+
+static inline void glyph_cache_lru_push_front(glyph_cache_t * cache, glyph_cache_entry_t * e)
+{
+    e->lru_prev = NULL;
+    e->lru_next = cache->lru_head;
+    if(cache->lru_head) cache->lru_head->lru_prev = e;
+    else cache->lru_tail = e;
+    cache->lru_head = e;
+}
+
+/**
+ * Get a decompressed glyph from the cache
+ * @param fdsc the font's descriptor
+ * @param letter a UNICODE letter code
+ * @return pointer to the decompressed bitmap or NULL if not cached
+ */
+static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) {
+        if(glyph_cache_max_size) glyph_cache_stats.misses++;
+        return NULL;
+    }
+
+    glyph_cache_entry_t * e = *glyph_cache_bucket(cache, fdsc, letter);
+    while(e) {
+        if(e->letter == letter && e->fdsc == fdsc) {
+            if(e != cache->lru_head) {
+                glyph_cache_lru_unlink(cache, e);
+                glyph_cache_lru_push_front(cache, e);
+            }
+            glyph_cache_stats.hits++;
+            return (const uint8_t *)(e + 1);
+        }
+        e = e->bucket_next;
+    }
+
+    glyph_cache_stats.misses++;
+    return NULL;
+}
+
+/**
+ * Allocate a cache entry for a glyph. The least recently used glyphs are evicted if the budget requires.
+ * @param fdsc the font's descriptor
+ * @param letter a UNICODE letter code
+ * @param bitmap_size size of the decompressed bitmap in bytes
+ * @return pointer where the bitmap should be decompressed or NULL if it can't be cached
+ */
+static uint8_t * glyph_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, uint32_t bitmap_size)
+{
+    uint32_t size = sizeof(glyph_cache_entry_t) + bitmap_size;
+    if(size > glyph_cache_max_size) return NULL;
+
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(glyph_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return NULL;
+        lv_memset_00(cache, sizeof(glyph_cache_t));
+        LV_GC_ROOT(_lv_font_glyph_cache) = cache;
+    }
+
+    while(cache->lru_tail && cache->used + size > glyph_cache_max_size) {
+        glyph_cache_remove(cache->lru_tail);
+    }
+
+    glyph_cache_entry_t * e = lv_mem_alloc(size);
+    if(e == NULL) return NULL;
+
+    e->fdsc = fdsc;
+    e->letter = letter;
+    e->size = size;
+
+    glyph_cache_entry_t ** bucket = glyph_cache_bucket(cache, fdsc, letter);
+    e->bucket_next = *bucket;
+    *bucket = e;
+    glyph_cache_lru_push_front(cache, e);
+    cache->used += size;
+    cache->entry_cnt++;
+
+    return (uint8_t *)(e + 1);
+}
+
+static void glyph_cache_remove(glyph_cache_entry_t * e)
+{
+    glyph_cache_t * cache = LV_GC_ROOT(_lv_font_glyph_cache);
+
+    glyph_cache_entry_t ** p = glyph_cache_bucket(cache, e->fdsc, e->letter);
+    while(*p != e) p = &(*p)->bucket_next;
+    *p = e->bucket_next;
+
+    glyph_cache_lru_unlink(cache, e);
+    cache->used -= e->size;
+    cache->entry_cnt--;
+    glyph_cache_stats.evicted_bytes += e->size;
+    lv_mem_free(e);
+}
+
 /**
  * Decompress one line. Store one pixel per byte
  * @param out output buffer
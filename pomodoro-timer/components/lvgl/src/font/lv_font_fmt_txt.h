@@ -156,6 +156,15 @@ typedef struct {
     uint32_t last_glyph_id;
 } lv_font_fmt_txt_glyph_cache_t;
 
+/** Usage statistics of the decompressed glyph cache*/
+typedef struct {
+    uint32_t hits;          /**< Number of bitmaps served from the cache*/
+    uint32_t misses;        /**< Number of bitmaps which needed to be decompressed*/
+    uint32_t evicted_bytes; /**< Sum of the size of the removed entries*/
+    uint32_t entry_cnt;     /**< Number of glyphs currently in the cache*/
+    size_t used_bytes;      /**< Bytes currently used by the cache*/
+} lv_font_fmt_txt_cache_stats_t;
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -225,6 +234,35 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Free the decompression buffer and the cached glyphs of the compressed fonts. Called by `lv_deinit()`.
+ */
+void _lv_font_deinit_fmt_txt(void);
+
+/**
+ * Set the size of the cache which stores the decompressed bitmaps of compressed fonts.
+ * The cache is shared by all fonts and the least recently used glyphs are evicted first.
+ * @param max_bytes size of the cache in bytes. 0: disable the cache
+ */
+void lv_font_fmt_txt_set_cache_size(size_t max_bytes);
+
+/**
+ * Remove the glyphs of a font from the decompressed glyph cache. Needs to be called before a font is freed.
+ * @param font pointer to a font
+ */
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font);
+
+/**
+ * Get the usage statistics of the decompressed glyph cache
+ * @param stats store the result here
+ */
+void lv_font_fmt_txt_get_cache_stats(lv_font_fmt_txt_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss and eviction counters of the decompressed glyph cache
+ */
+void lv_font_fmt_txt_reset_cache_stats(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -22,6 +22,7 @@
 #include "../draw/sdl/lv_draw_sdl.h"
 #include "../draw/stm32_dma2d/lv_gpu_stm32_dma2d.h"
 #include "../draw/swm341_dma2d/lv_gpu_swm341_dma2d.h"
+#include "../draw/esp/lv_gpu_esp_gdma.h"
 #include "../draw/arm2d/lv_gpu_arm2d.h"
 #include "../draw/nxp/vglite/lv_draw_vglite.h"
 #include "../draw/nxp/pxp/lv_draw_pxp.h"
@@ -98,12 +99,16 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
 
 #if LV_USE_GPU_STM32_DMA2D
     driver->draw_ctx_init = lv_draw_stm32_dma2d_ctx_init;
-    driver->draw_ctx_deinit = lv_draw_stm32_dma2d_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_stm32_dma2d_ctx_deinit;
     driver->draw_ctx_size = sizeof(lv_draw_stm32_dma2d_ctx_t);
 #elif LV_USE_GPU_SWM341_DMA2D
     driver->draw_ctx_init = lv_draw_swm341_dma2d_ctx_init;
-    driver->draw_ctx_deinit = lv_draw_swm341_dma2d_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_swm341_dma2d_ctx_deinit;
     driver->draw_ctx_size = sizeof(lv_draw_swm341_dma2d_ctx_t);
+#elif LV_USE_GPU_ESP_GDMA
+    driver->draw_ctx_init = lv_draw_esp_gdma_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_esp_gdma_ctx_deinit;
+    driver->draw_ctx_size = sizeof(lv_draw_esp_gdma_ctx_t);
 #elif LV_USE_GPU_NXP_VG_LITE
     driver->draw_ctx_init = lv_draw_vglite_ctx_init;
     driver->draw_ctx_deinit = lv_draw_vglite_ctx_deinit;
@@ -118,11 +123,11 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->draw_ctx_size = sizeof(lv_draw_sdl_ctx_t);
 #elif LV_USE_GPU_ARM2D
     driver->draw_ctx_init = lv_draw_arm2d_ctx_init;
-    driver->draw_ctx_deinit = lv_draw_arm2d_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_arm2d_ctx_deinit;
     driver->draw_ctx_size = sizeof(lv_draw_arm2d_ctx_t);
 #else
     driver->draw_ctx_init = lv_draw_sw_init_ctx;
-    driver->draw_ctx_deinit = lv_draw_sw_init_ctx;
+    driver->draw_ctx_deinit = lv_draw_sw_deinit_ctx;
     driver->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
 #endif
 
@@ -168,17 +173,20 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     }
 
     /*Create a draw context if not created yet*/
+    bool draw_ctx_created = false;
     if(driver->draw_ctx == NULL) {
         lv_draw_ctx_t * draw_ctx = lv_mem_alloc(driver->draw_ctx_size);
         LV_ASSERT_MALLOC(draw_ctx);
         if(draw_ctx == NULL) return NULL;
         driver->draw_ctx_init(driver, draw_ctx);
         driver->draw_ctx = draw_ctx;
+        draw_ctx_created = true;
     }
 
     lv_memset_00(disp, sizeof(lv_disp_t));
 
     disp->driver = driver;
+    disp->draw_ctx_created = draw_ctx_created;
 
     disp->inv_en_cnt = 1;
 
@@ -313,6 +321,14 @@ void lv_disp_remove(lv_disp_t * disp)
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
+
+    /*Free the draw context and its buffers (e.g. the kept layers) if it was created for this display*/
+    if(disp->draw_ctx_created) {
+        disp->driver->draw_ctx_deinit(disp->driver, disp->driver->draw_ctx);
+        lv_mem_free(disp->driver->draw_ctx);
+        disp->driver->draw_ctx = NULL;
+    }
+
     lv_mem_free(disp);
 
     if(was_default) lv_disp_set_default(_lv_ll_get_head(&LV_GC_ROOT(_lv_disp_ll)));
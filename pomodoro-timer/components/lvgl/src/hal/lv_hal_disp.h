@@ -178,6 +178,7 @@ uint8_t draw_prev_over_act  :
 uint8_t del_prev  :
     1;          /**< 1: Automatically delete the previous screen when the screen load animation is ready*/
     uint8_t rendering_in_progress : 1; /**< 1: The current screen rendering is in progress*/
+    uint8_t draw_ctx_created : 1;   /**< 1: The draw context was created by `lv_disp_drv_register()`*/
 
     lv_opa_t bg_opa;                /**<Opacity of the background color or wallpaper*/
     lv_color_t bg_color;            /**< Default display color when screens are transparent*/
@@ -10,6 +10,11 @@
 
 #include <stdint.h>
 
+/*Possible values of LV_USE_OS. Defined here to be usable in lv_conf.h and in the `#if`s everywhere.*/
+#define LV_OS_NONE      0
+#define LV_OS_PTHREAD   1
+#define LV_OS_FREERTOS  2
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -157,6 +162,16 @@
         #endif
     #endif
 
+    /*Reserve this many bytes of `LV_MEM_SIZE` for slabs serving the small (<= 128 bytes) allocations.
+     *It makes creating and deleting objects faster and causes less fragmentation. 0: disable*/
+    #ifndef LV_MEM_SLAB_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_SIZE
+            #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+        #else
+            #define LV_MEM_SLAB_SIZE 0
+        #endif
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #ifndef LV_MEM_CUSTOM_INCLUDE
         #ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -198,6 +213,16 @@
     #endif
 #endif
 
+/*Shrink the arena of the intermediate buffers if this many refreshes in a row needed less of it
+ *(e.g. after closing a screen with large shadows). 0: never shrink*/
+#ifndef LV_MEM_BUF_SHRINK_FRAMES
+    #ifdef CONFIG_LV_MEM_BUF_SHRINK_FRAMES
+        #define LV_MEM_BUF_SHRINK_FRAMES CONFIG_LV_MEM_BUF_SHRINK_FRAMES
+    #else
+        #define LV_MEM_BUF_SHRINK_FRAMES 60
+    #endif
+#endif
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #ifndef LV_MEMCPY_MEMSET_STD
     #ifdef CONFIG_LV_MEMCPY_MEMSET_STD
@@ -268,6 +293,17 @@
     #endif
 #endif
 
+/*Operating system to create threads and locks with. Needed for background work, e.g. `LV_IMG_DECODE_ASYNC_MIN_PX`.
+ *With an OS `lv_mem_alloc()` & co. are protected by a mutex. Call the other LVGL functions from one thread.
+ *LV_OS_NONE, LV_OS_PTHREAD, LV_OS_FREERTOS*/
+#ifndef LV_USE_OS
+    #ifdef CONFIG_LV_USE_OS
+        #define LV_USE_OS CONFIG_LV_USE_OS
+    #else
+        #define LV_USE_OS LV_OS_NONE
+    #endif
+#endif
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -343,6 +379,37 @@
     #endif
 #endif
 
+/*The layer buffers are kept and reused by the next layers and refreshes instead of allocating them for every widget.
+ *LV_LAYER_POOL_CNT: the number of kept buffers. Nested layers need one each. 0: don't keep the buffers
+ *LV_LAYER_POOL_SIZE: [bytes] the most memory the kept buffers can use together.
+ *                    0: the size of the display's draw buffer in ARGB format
+ *Larger layers get a buffer allocated only for them.*/
+#ifndef LV_LAYER_POOL_CNT
+    #ifdef CONFIG_LV_LAYER_POOL_CNT
+        #define LV_LAYER_POOL_CNT CONFIG_LV_LAYER_POOL_CNT
+    #else
+        #define LV_LAYER_POOL_CNT  0
+    #endif
+#endif
+#ifndef LV_LAYER_POOL_SIZE
+    #ifdef CONFIG_LV_LAYER_POOL_SIZE
+        #define LV_LAYER_POOL_SIZE CONFIG_LV_LAYER_POOL_SIZE
+    #else
+        #define LV_LAYER_POOL_SIZE 0
+    #endif
+#endif
+
+/*Objects with LV_OBJ_FLAG_RETAIN_LAYER are rendered with their children into an image once and
+ *only the image is drawn until something changes on them.
+ *LV_OBJ_RETAIN_CACHE_SIZE: [bytes] the most memory the images can use together. 0: ignore the flag*/
+#ifndef LV_OBJ_RETAIN_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_RETAIN_CACHE_SIZE
+        #define LV_OBJ_RETAIN_CACHE_SIZE CONFIG_LV_OBJ_RETAIN_CACHE_SIZE
+    #else
+        #define LV_OBJ_RETAIN_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -356,6 +423,28 @@
     #endif
 #endif
 
+/*Limit the decoded bytes kept in the image cache. The least recently used images are closed above it.
+ *Images drawn in the current refresh are kept even above the limit.
+ *0: no limit, only the number of entries is limited*/
+#ifndef LV_IMG_CACHE_MAX_BYTES
+    #ifdef CONFIG_LV_IMG_CACHE_MAX_BYTES
+        #define LV_IMG_CACHE_MAX_BYTES CONFIG_LV_IMG_CACHE_MAX_BYTES
+    #else
+        #define LV_IMG_CACHE_MAX_BYTES 0
+    #endif
+#endif
+
+/*Decode the images with at least this many pixels in a background thread. It needs `LV_USE_OS` and the image cache.
+ *A placeholder is drawn with the `img_placeholder_color/opa` style properties until the image is decoded.
+ *0: decode all images while drawing them*/
+#ifndef LV_IMG_DECODE_ASYNC_MIN_PX
+    #ifdef CONFIG_LV_IMG_DECODE_ASYNC_MIN_PX
+        #define LV_IMG_DECODE_ASYNC_MIN_PX CONFIG_LV_IMG_DECODE_ASYNC_MIN_PX
+    #else
+        #define LV_IMG_DECODE_ASYNC_MIN_PX 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -402,6 +491,18 @@
     #endif
 #endif
 
+/*Dither the semi-transparent pixels (anti-aliased edges, shadows, opacity) with LV_COLOR_DEPTH 16.
+ *They are mixed with 8 bit per channel precision and rounded to RGB565 with an ordered 8x8 pattern
+ *instead of the 33 opacity levels of `lv_color_mix()`. Removes the banding of soft shadows and fades
+ *at a small CPU cost on the semi-transparent pixels only. No extra memory is used.*/
+#ifndef LV_DITHER_BLEND
+    #ifdef CONFIG_LV_DITHER_BLEND
+        #define LV_DITHER_BLEND CONFIG_LV_DITHER_BLEND
+    #else
+        #define LV_DITHER_BLEND 0
+    #endif
+#endif
+
 /*Maximum buffer size to allocate for rotation.
  *Only used if software rotation is enabled in the display driver.*/
 #ifndef LV_DISP_ROT_MAX_BUF
@@ -463,6 +564,34 @@
     #endif
 #endif
 
+/*Use the GDMA of ESP32-S3 (and other ESP chips with GDMA) to make large fills and image copies in the background.
+ *Without ESP-IDF a stand-in engine makes the copies with the CPU to test the drawing on a PC*/
+#ifndef LV_USE_GPU_ESP_GDMA
+    #ifdef CONFIG_LV_USE_GPU_ESP_GDMA
+        #define LV_USE_GPU_ESP_GDMA CONFIG_LV_USE_GPU_ESP_GDMA
+    #else
+        #define LV_USE_GPU_ESP_GDMA 0
+    #endif
+#endif
+#if LV_USE_GPU_ESP_GDMA
+    /*Fill and copy only the areas with at least this many pixels in the background*/
+    #ifndef LV_GPU_ESP_GDMA_MIN_SIZE
+        #ifdef CONFIG_LV_GPU_ESP_GDMA_MIN_SIZE
+            #define LV_GPU_ESP_GDMA_MIN_SIZE CONFIG_LV_GPU_ESP_GDMA_MIN_SIZE
+        #else
+            #define LV_GPU_ESP_GDMA_MIN_SIZE 2048
+        #endif
+    #endif
+    /*Number of memory copies which can wait in the queue of the GDMA*/
+    #ifndef LV_GPU_ESP_GDMA_QUEUE_LEN
+        #ifdef CONFIG_LV_GPU_ESP_GDMA_QUEUE_LEN
+            #define LV_GPU_ESP_GDMA_QUEUE_LEN CONFIG_LV_GPU_ESP_GDMA_QUEUE_LEN
+        #else
+            #define LV_GPU_ESP_GDMA_QUEUE_LEN 16
+        #endif
+    #endif
+#endif
+
 /*Use NXP's PXP GPU iMX RTxxx platforms*/
 #ifndef LV_USE_GPU_NXP_PXP
     #ifdef CONFIG_LV_USE_GPU_NXP_PXP
@@ -828,6 +957,17 @@
     #endif
 #endif
 
+/*Number of resolved style properties to cache.
+ *Without the cache every style property read walks all the styles of the object.
+ *About 24 bytes per entry. Should be a power of 2. 0: to disable caching*/
+#ifndef LV_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_STYLE_CACHE_SIZE
+        #define LV_STYLE_CACHE_SIZE CONFIG_LV_STYLE_CACHE_SIZE
+    #else
+        #define LV_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #ifndef LV_ENABLE_GC
@@ -1208,6 +1348,17 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of decompressed glyphs in bytes. It's shared by all compressed fonts.
+     *0: decompress the glyphs every time they are drawn*/
+    #ifndef LV_FONT_COMPR_CACHE_DEF_SIZE
+        #ifdef CONFIG_LV_FONT_COMPR_CACHE_DEF_SIZE
+            #define LV_FONT_COMPR_CACHE_DEF_SIZE CONFIG_LV_FONT_COMPR_CACHE_DEF_SIZE
+        #else
+            #define LV_FONT_COMPR_CACHE_DEF_SIZE (16 * 1024)
+        #endif
+    #endif
+#endif
 
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
@@ -1477,6 +1628,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LINE_CACHE
+                #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+            #else
+                #define LV_LABEL_LINE_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LINE_CACHE 1     /*Cache the line breaks of the text to speed up redrawing (8 bytes per line)*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -1958,6 +2120,33 @@
 
 /*File system interfaces for common APIs */
 
+/*Size of a block cache shared by the files of the drivers which have a `cache_size` [bytes].
+ *It replaces the single cache window of these drivers. The files are cached in LV_FS_BLOCK_SIZE blocks per path,
+ *so the blocks are kept when seeking in the file or opening it again. 0: disable*/
+#ifndef LV_FS_BLOCK_CACHE_SIZE
+    #ifdef CONFIG_LV_FS_BLOCK_CACHE_SIZE
+        #define LV_FS_BLOCK_CACHE_SIZE CONFIG_LV_FS_BLOCK_CACHE_SIZE
+    #else
+        #define LV_FS_BLOCK_CACHE_SIZE 0
+    #endif
+#endif
+#if LV_FS_BLOCK_CACHE_SIZE
+    #ifndef LV_FS_BLOCK_SIZE
+        #ifdef CONFIG_LV_FS_BLOCK_SIZE
+            #define LV_FS_BLOCK_SIZE CONFIG_LV_FS_BLOCK_SIZE
+        #else
+            #define LV_FS_BLOCK_SIZE 512        /*[bytes]*/
+        #endif
+    #endif
+    #ifndef LV_FS_READ_AHEAD
+        #ifdef CONFIG_LV_FS_READ_AHEAD
+            #define LV_FS_READ_AHEAD CONFIG_LV_FS_READ_AHEAD
+        #else
+            #define LV_FS_READ_AHEAD 4          /*Load this many blocks with one read when a file is read sequentially*/
+        #endif
+    #endif
+#endif
+
 /*API for fopen, fread, etc*/
 #ifndef LV_USE_FS_STDIO
     #ifdef CONFIG_LV_USE_FS_STDIO
@@ -2020,6 +2209,13 @@
             #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
         #endif
     #endif
+    #ifndef LV_FS_POSIX_MMAP
+        #ifdef CONFIG_LV_FS_POSIX_MMAP
+            #define LV_FS_POSIX_MMAP CONFIG_LV_FS_POSIX_MMAP
+        #else
+            #define LV_FS_POSIX_MMAP 0          /*1: map the files opened for reading into the memory (not on Windows)*/
+        #endif
+    #endif
 #endif
 
 /*API for CreateFile, ReadFile, etc*/
@@ -2087,6 +2283,18 @@
         #define LV_USE_PNG 0
     #endif
 #endif
+#if LV_USE_PNG
+    /*Decode the PNG images having at least this many pixels line by line while they are drawn.
+     *It needs about 34 kB + 2 lines of RAM instead of the whole image, but the image is decoded again in every refresh.
+     *Interlaced images are always decoded at once. 0: disable*/
+    #ifndef LV_PNG_STREAM_MIN_PX
+        #ifdef CONFIG_LV_PNG_STREAM_MIN_PX
+            #define LV_PNG_STREAM_MIN_PX CONFIG_LV_PNG_STREAM_MIN_PX
+        #else
+            #define LV_PNG_STREAM_MIN_PX 0
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -2106,6 +2314,26 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Keep this many bytes of decoded frames (horizontal strips) per image to not decode them again when redrawn.
+     *The least recently used frame is replaced. At least one frame is always kept.*/
+    #ifndef LV_SJPG_CACHE_SIZE
+        #ifdef CONFIG_LV_SJPG_CACHE_SIZE
+            #define LV_SJPG_CACHE_SIZE CONFIG_LV_SJPG_CACHE_SIZE
+        #else
+            #define LV_SJPG_CACHE_SIZE 0
+        #endif
+    #endif
+    /*Decode the next frame in a background thread while drawing or scrolling the image.
+     *Needs `LV_USE_OS`, a thread safe file system driver and room for at least 2 frames in `LV_SJPG_CACHE_SIZE`*/
+    #ifndef LV_SJPG_PREFETCH
+        #ifdef CONFIG_LV_SJPG_PREFETCH
+            #define LV_SJPG_PREFETCH CONFIG_LV_SJPG_PREFETCH
+        #else
+            #define LV_SJPG_PREFETCH 0
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -2250,6 +2478,15 @@
     #endif
 #endif
 
+/*1: Support pre-rendering a fixed set of glyphs (e.g. the digits of a clock) into an atlas font*/
+#ifndef LV_USE_TXT_ATLAS
+    #ifdef CONFIG_LV_USE_TXT_ATLAS
+        #define LV_USE_TXT_ATLAS CONFIG_LV_USE_TXT_ATLAS
+    #else
+        #define LV_USE_TXT_ATLAS 0
+    #endif
+#endif
+
 /*1: Enable a published subscriber based messaging system */
 #ifndef LV_USE_MSG
     #ifdef CONFIG_LV_USE_MSG
@@ -41,6 +41,26 @@ extern "C" {
 #  define CONFIG_LV_MEM_SIZE (CONFIG_LV_MEM_SIZE_KILOBYTES * 1024U)
 #endif
 
+#ifdef CONFIG_LV_MEM_SLAB_SIZE_KILOBYTES
+#  define CONFIG_LV_MEM_SLAB_SIZE (CONFIG_LV_MEM_SLAB_SIZE_KILOBYTES * 1024U)
+#endif
+
+#ifdef CONFIG_LV_IMG_CACHE_MAX_KILOBYTES
+#  define CONFIG_LV_IMG_CACHE_MAX_BYTES (CONFIG_LV_IMG_CACHE_MAX_KILOBYTES * 1024U)
+#endif
+
+/*------------------
+ * OPERATING SYSTEM
+ *-----------------*/
+
+#ifdef CONFIG_LV_OS_NONE
+#  define CONFIG_LV_USE_OS LV_OS_NONE
+#elif defined(CONFIG_LV_OS_PTHREAD)
+#  define CONFIG_LV_USE_OS LV_OS_PTHREAD
+#elif defined(CONFIG_LV_OS_FREERTOS)
+#  define CONFIG_LV_USE_OS LV_OS_FREERTOS
+#endif
+
 /*------------------
  * MONITOR POSITION
  *-----------------*/
@@ -20,25 +20,80 @@
  *********************/
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
+#define ANIM_CHUNK_SIZE 8
+#define ANIM_ACTIVE_DEF_CAP 8
+
+#define ACTIVE ((lv_anim_t **)LV_GC_ROOT(_lv_anim_active))
+#define ANIM_SKIP _ANIM_PATH_NUM            /*Doesn't run in this round*/
+#define ANIM_START (_ANIM_PATH_NUM + 1)     /*Starts in this round so it's handled alone in the last pass*/
+#define BEZIER_U(kind) bezier_u[(kind) - ANIM_PATH_EASE_IN]
 
 /**********************
  *      TYPEDEFS
  **********************/
+struct _anim_chunk_t;
+
+/*A place of an animation in the pool. The address of `anim` never changes while the animation exists.*/
+typedef struct {
+    lv_anim_t anim;     /*Must be the first to convert `lv_anim_t *` to the slot*/
+    struct _anim_chunk_t * chunk;
+    uint8_t used : 1;
+    uint8_t deleted : 1;    /*Deleted but removed from the active array only later*/
+} anim_slot_t;
+
+/*The animations are allocated in chunks to keep them close to each other in the memory*/
+typedef struct _anim_chunk_t {
+    struct _anim_chunk_t * next;
+    uint32_t used_cnt;
+    anim_slot_t slots[ANIM_CHUNK_SIZE];
+} anim_chunk_t;
+
+/*The paths which are evaluated in batches. The others are called one by one.*/
+typedef enum {
+    ANIM_PATH_LINEAR,
+    ANIM_PATH_EASE_IN,
+    ANIM_PATH_EASE_OUT,
+    ANIM_PATH_EASE_IN_OUT,
+    ANIM_PATH_OVERSHOOT,
+    ANIM_PATH_OTHER,
+    _ANIM_PATH_NUM,
+} anim_path_kind_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
-static void anim_mark_list_change(void);
+static void anim_update_timer_state(void);
 static void anim_ready_handler(lv_anim_t * a);
+static anim_slot_t * slot_alloc(void);
+static void slot_free(anim_slot_t * slot);
+static void slot_mark_deleted(anim_slot_t * slot);
+static void active_compact(void);
+static bool scratch_reserve(uint32_t cnt);
+static anim_path_kind_t get_path_kind(lv_anim_path_cb_t path_cb);
+static inline int32_t path_step(anim_path_kind_t kind, int32_t act_time, int32_t time);
+static inline int32_t path_value(const lv_anim_t * a, int32_t step);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
 static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+static uint32_t active_cnt;     /*Number of animations in the active array including the deleted ones*/
+static uint32_t active_cap;
+static uint32_t live_cnt;       /*Number of not deleted animations*/
+static uint32_t scratch_cap;
+static bool has_deleted;
+static bool timer_running;
+
+/*Control points of the bezier paths in the order of `anim_path_kind_t`*/
+static const int32_t bezier_u[][2] = {
+    {50, 100},      /*ease in*/
+    {900, 950},     /*ease out*/
+    {50, 952},      /*ease in-out*/
+    {1000, 1300},   /*overshoot*/
+};
 
 /**********************
  *      MACROS
@@ -56,10 +111,17 @@ static lv_timer_t * _lv_anim_tmr;
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    LV_GC_ROOT(_lv_anim_chunks) = NULL;
+    LV_GC_ROOT(_lv_anim_active) = NULL;
+    LV_GC_ROOT(_lv_anim_scratch) = NULL;
+    scratch_cap = 0;
+    active_cnt = 0;
+    active_cap = 0;
+    live_cnt = 0;
+    has_deleted = false;
+    timer_running = false;
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
-    anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
+    anim_update_timer_state(); /*Turn off the animation timer*/
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -80,15 +142,27 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim timer was suspended and it's last run measure is invalid*/
+    if(live_cnt == 0) {
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
-    LV_ASSERT_MALLOC(new_anim);
-    if(new_anim == NULL) return NULL;
+    /*Add the new animation to the end of the active array*/
+    if(active_cnt == active_cap) {
+        uint32_t new_cap = active_cap == 0 ? ANIM_ACTIVE_DEF_CAP : active_cap * 2;
+        lv_anim_t ** new_active = lv_mem_realloc(LV_GC_ROOT(_lv_anim_active), new_cap * sizeof(lv_anim_t *));
+        LV_ASSERT_MALLOC(new_active);
+        if(new_active == NULL) return NULL;
+        LV_GC_ROOT(_lv_anim_active) = new_active;
+        active_cap = new_cap;
+    }
+
+    anim_slot_t * slot = slot_alloc();
+    if(slot == NULL) return NULL;
+    lv_anim_t * new_anim = &slot->anim;
+    ACTIVE[active_cnt] = new_anim;
+    active_cnt++;
+    live_cnt++;
 
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
@@ -106,9 +180,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
-    anim_mark_list_change();
+    anim_update_timer_state();
 
     TRACE_ANIM("finished");
     return new_anim;
@@ -137,24 +209,24 @@ uint32_t lv_anim_get_playtime(lv_anim_t * a)
 
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+    uint32_t i;
+    for(i = 0; i < active_cnt; i++) {
+        anim_slot_t * slot = (anim_slot_t *)ACTIVE[i];
+        if(slot->deleted) continue;
 
+        lv_anim_t * a = &slot->anim;
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            /*Only mark it as deleted because `anim_timer` might be using it.*/
+            slot_mark_deleted(slot);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
             del = true;
         }
+    }
 
-        a = a_next;
+    if(del) {
+        if(!timer_running) active_compact();
+        anim_update_timer_state();
     }
 
     return del;
@@ -162,14 +234,25 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
-    anim_mark_list_change();
+    uint32_t i;
+    for(i = 0; i < active_cnt; i++) {
+        anim_slot_t * slot = (anim_slot_t *)ACTIVE[i];
+        if(!slot->deleted) slot_mark_deleted(slot);
+    }
+
+    if(!timer_running) active_compact();
+    anim_update_timer_state();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
+    /*Search from the newest animation*/
+    uint32_t i;
+    for(i = active_cnt; i > 0; i--) {
+        anim_slot_t * slot = (anim_slot_t *)ACTIVE[i - 1];
+        if(slot->deleted) continue;
+
+        lv_anim_t * a = &slot->anim;
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
@@ -185,11 +268,7 @@ struct _lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return (uint16_t)live_cnt;
 }
 
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
@@ -211,73 +290,27 @@ void lv_anim_refr_now(void)
 
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    int32_t step = lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
-
-    /*Get the new value which will be proportional to `step`
-     *and the `start` and `end` values*/
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_ANIM_RES_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_value(a, path_step(ANIM_PATH_LINEAR, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 100, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_value(a, path_step(ANIM_PATH_EASE_IN, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 900, 950, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_value(a, path_step(ANIM_PATH_EASE_OUT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 952, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_value(a, path_step(ANIM_PATH_EASE_IN_OUT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 1000, 1300, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return path_value(a, path_step(ANIM_PATH_OVERSHOOT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -345,68 +378,150 @@ int32_t lv_anim_path_step(const lv_anim_t * a)
 
 /**
  * Periodically handle the animations.
+ * The animations are handled in three passes:
+ * 1. advance the time of the animations and group them by their path
+ * 2. evaluate the paths group by group
+ * 3. apply the new values and handle the finished animations
+ * Except the custom paths the callbacks are called only in the last pass, animation by animation.
+ * The animations starting now are handled there alone so that `start_cb` runs right before their first `exec_cb`.
+ * If the callbacks set the values, time or path of an animation its value is calculated again before applying it.
+ * Animations deleted meanwhile are only marked and removed from the active array at the end.
  * @param param unused
  */
 static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
+    /*Don't run again if called from an animation's callback (e.g. via `lv_refr_now`)*/
+    if(timer_running) return;
+    timer_running = true;
+
     uint32_t elaps = lv_tick_elaps(last_timer_run);
 
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
 
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+    /*Animations started in the callbacks are added to the end and will run only in the next round*/
+    uint32_t cnt = active_cnt;
+    if(cnt == 0 || !scratch_reserve(cnt)) {
+        timer_running = false;
+        last_timer_run = lv_tick_get();
+        return;
+    }
+    int32_t * values = LV_GC_ROOT(_lv_anim_scratch);
+    uint32_t * order = (uint32_t *)(values + scratch_cap);
+    uint8_t * kinds = (uint8_t *)(order + scratch_cap);
+    uint32_t kind_cnt[_ANIM_PATH_NUM] = {0};
+    uint32_t i;
+
+    /*Advance the time. The newer animations go first.*/
+    for(i = cnt; i > 0; i--) {
+        uint32_t idx = i - 1;
+        kinds[idx] = ANIM_SKIP;
+        anim_slot_t * slot = (anim_slot_t *)ACTIVE[idx];
+        lv_anim_t * a = &slot->anim;
+        if(slot->deleted || a->run_round == anim_run_round) continue;
+        a->run_round = anim_run_round;
+
+        /*The animation will run now for the first time. `start_cb` might change it so handle it later.*/
+        int32_t new_act_time = a->act_time + elaps;
+        if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
+            kinds[idx] = ANIM_START;
+            continue;
+        }
+        a->act_time = new_act_time;
+        if(a->act_time < 0) continue;
+        if(a->act_time > a->time) a->act_time = a->time;
+        a->changed = 0;
+
+        anim_path_kind_t kind = get_path_kind(a->path_cb);
+        kinds[idx] = kind;
+        kind_cnt[kind]++;
+    }
+
+    /*Sort the indices by path kind so that each kind is a continuous range in `order`*/
+    uint32_t kind_start[_ANIM_PATH_NUM + 1];
+    kind_start[0] = 0;
+    for(i = 0; i < _ANIM_PATH_NUM; i++) kind_start[i + 1] = kind_start[i] + kind_cnt[i];
+    uint32_t kind_pos[_ANIM_PATH_NUM];
+    lv_memcpy(kind_pos, kind_start, sizeof(kind_pos));
+    for(i = 0; i < cnt; i++) {
+        if(kinds[i] < _ANIM_PATH_NUM) order[kind_pos[kinds[i]]++] = i;
+    }
+
+    /*Evaluate the paths in batches without calling `path_cb`.
+     *Animations started together (e.g. the style transitions of an object) are next to each other
+     *and have the same progress, so the step of the path is calculated only once for them.*/
+    lv_anim_t ** active = ACTIVE;
+    int32_t k;
+    for(k = ANIM_PATH_LINEAR; k < ANIM_PATH_OTHER; k++) {
+        int32_t prev_act_time = -1;
+        int32_t prev_time = -1;
+        int32_t path_s = 0;
+        for(i = kind_start[k]; i < kind_start[k + 1]; i++) {
+            lv_anim_t * a = active[order[i]];
+            if(a->act_time != prev_act_time || a->time != prev_time) {
+                prev_act_time = a->act_time;
+                prev_time = a->time;
+                path_s = path_step(k, a->act_time, a->time);
             }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+            values[order[i]] = path_value(a, path_s);
+        }
+    }
+
+    for(i = kind_start[ANIM_PATH_OTHER]; i < kind_start[ANIM_PATH_OTHER + 1]; i++) {
+        lv_anim_t * a = ACTIVE[order[i]];   /*A custom path might start animations and move the array*/
+        values[order[i]] = a->path_cb(a);
+    }
+
+    /*Apply the values in the original order*/
+    for(i = cnt; i > 0; i--) {
+        uint32_t idx = i - 1;
+        if(kinds[idx] == ANIM_SKIP) continue;
+
+        /*The callbacks might delete it but the active array is changed only at the end*/
+        anim_slot_t * slot = (anim_slot_t *)ACTIVE[idx];
+        if(slot->deleted) continue;
+
+        lv_anim_t * a = &slot->anim;
+        if(kinds[idx] == ANIM_START) {
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
             }
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
+            if(slot->deleted) continue;
+
+            a->act_time += elaps;
+            if(a->act_time < 0) continue;
+            if(a->act_time > a->time) a->act_time = a->time;
+            a->changed = 1;
+        }
+
+        /*Calculate the value again if the callbacks have changed the animation since pass 2*/
+        if(a->changed) {
+            a->changed = 0;
+            values[idx] = a->path_cb(a);
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        if(values[idx] != a->current_value) {
+            a->current_value = values[idx];
+            /*Apply the calculated value*/
+            if(a->exec_cb) a->exec_cb(a->var, values[idx]);
+        }
+
+        /*If the time is elapsed the animation is ready*/
+        if(!slot->deleted && a->act_time >= a->time) {
+            anim_ready_handler(a);
+        }
     }
 
+    timer_running = false;
+    active_compact();
+    anim_update_timer_state();
+
     last_timer_run = lv_tick_get();
 }
 
@@ -427,16 +542,13 @@ static void anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_time == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Mark the animation as deleted.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
+        slot_mark_deleted((anim_slot_t *)a);
 
-        /*Call the callback function at the end*/
+        /*Call the callback function at the end. The memory is freed only after `anim_timer`.*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -460,11 +572,154 @@ static void anim_ready_handler(lv_anim_t * a)
     }
 }
 
-static void anim_mark_list_change(void)
+static void anim_update_timer_state(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(live_cnt == 0)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Get a free slot from the pool. Allocate a new chunk if required.
+ * @return pointer to the slot or NULL if out of memory
+ */
+static anim_slot_t * slot_alloc(void)
+{
+    anim_chunk_t * chunk = LV_GC_ROOT(_lv_anim_chunks);
+    while(chunk && chunk->used_cnt == ANIM_CHUNK_SIZE) chunk = chunk->next;
+
+    if(chunk == NULL) {
+        chunk = lv_mem_alloc(sizeof(anim_chunk_t));
+        LV_ASSERT_MALLOC(chunk);
+        if(chunk == NULL) return NULL;
+        lv_memset_00(chunk, sizeof(anim_chunk_t));
+        chunk->next = LV_GC_ROOT(_lv_anim_chunks);
+        LV_GC_ROOT(_lv_anim_chunks) = chunk;
+    }
+
+    uint32_t i;
+    for(i = 0; chunk->slots[i].used; i++);
+
+    anim_slot_t * slot = &chunk->slots[i];
+    slot->chunk = chunk;
+    slot->used = 1;
+    slot->deleted = 0;
+    chunk->used_cnt++;
+    return slot;
+}
+
+/**
+ * Give back a slot to the pool. Free its chunk if it became empty.
+ * @param slot pointer to a slot
+ */
+static void slot_free(anim_slot_t * slot)
+{
+    anim_chunk_t * chunk = slot->chunk;
+    slot->used = 0;
+    chunk->used_cnt--;
+    if(chunk->used_cnt > 0) return;
+
+    anim_chunk_t ** prev_next = (anim_chunk_t **)&LV_GC_ROOT(_lv_anim_chunks);
+    while(*prev_next != chunk) prev_next = &(*prev_next)->next;
+    *prev_next = chunk->next;
+    lv_mem_free(chunk);
+}
+
+static void slot_mark_deleted(anim_slot_t * slot)
+{
+    slot->deleted = 1;
+    live_cnt--;
+    has_deleted = true;
+}
+
+/**
+ * Remove the deleted animations from the active array and free their slots. Keep the order of the others.
+ */
+static void active_compact(void)
+{
+    if(!has_deleted) return;
+    has_deleted = false;
+
+    lv_anim_t ** active = ACTIVE;
+    uint32_t i;
+    uint32_t new_cnt = 0;
+    for(i = 0; i < active_cnt; i++) {
+        anim_slot_t * slot = (anim_slot_t *)active[i];
+        if(slot->deleted) slot_free(slot);
+        else active[new_cnt++] = active[i];
+    }
+    active_cnt = new_cnt;
+
+    if(active_cnt == 0) {
+        lv_mem_free(LV_GC_ROOT(_lv_anim_active));
+        LV_GC_ROOT(_lv_anim_active) = NULL;
+        active_cap = 0;
+        lv_mem_free(LV_GC_ROOT(_lv_anim_scratch));
+        LV_GC_ROOT(_lv_anim_scratch) = NULL;
+        scratch_cap = 0;
+    }
+}
+
+/**
+ * Make sure the arrays used by `anim_timer` can store data of a given number of animations.
+ * @param cnt number of animations
+ * @return true: success; false: out of memory
+ */
+static bool scratch_reserve(uint32_t cnt)
+{
+    if(cnt <= scratch_cap) return true;
+
+    /*`values`, `order` and `kinds` of `anim_timer` in one buffer*/
+    uint32_t new_cap = LV_MAX(cnt, active_cap);
+    void * new_scratch = lv_mem_realloc(LV_GC_ROOT(_lv_anim_scratch),
+                                        new_cap * (sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint8_t)));
+    LV_ASSERT_MALLOC(new_scratch);
+    if(new_scratch == NULL) return false;
+
+    LV_GC_ROOT(_lv_anim_scratch) = new_scratch;
+    scratch_cap = new_cap;
+    return true;
+}
+
+static anim_path_kind_t get_path_kind(lv_anim_path_cb_t path_cb)
+{
+    if(path_cb == lv_anim_path_linear) return ANIM_PATH_LINEAR;
+    if(path_cb == lv_anim_path_ease_in) return ANIM_PATH_EASE_IN;
+    if(path_cb == lv_anim_path_ease_out) return ANIM_PATH_EASE_OUT;
+    if(path_cb == lv_anim_path_ease_in_out) return ANIM_PATH_EASE_IN_OUT;
+    if(path_cb == lv_anim_path_overshoot) return ANIM_PATH_OVERSHOOT;
+    return ANIM_PATH_OTHER;
+}
+
+/**
+ * Get the progress of a built-in path.
+ * @param kind      the path, not `ANIM_PATH_OTHER`
+ * @param act_time  current time in the animation
+ * @param time      duration of the animation
+ * @return          the progress in [0..LV_ANIM_RESOLUTION] range (can be out of it e.g. when overshooting)
+ */
+static inline int32_t path_step(anim_path_kind_t kind, int32_t act_time, int32_t time)
+{
+    if(kind == ANIM_PATH_LINEAR) return lv_map(act_time, 0, time, 0, LV_ANIM_RESOLUTION);
+
+    uint32_t t = lv_map(act_time, 0, time, 0, LV_BEZIER_VAL_MAX);
+    return lv_bezier3(t, 0, BEZIER_U(kind)[0], BEZIER_U(kind)[1], LV_BEZIER_VAL_MAX);
+}
+
+/**
+ * Get the value of an animation from the progress of its path
+ * @param a     pointer to an animation
+ * @param step  the progress returned by `path_step()`
+ * @return      the value proportional to `step` between the start and end values
+ */
+static inline int32_t path_value(const lv_anim_t * a, int32_t step)
+{
+    /*LV_ANIM_RES_SHIFT == LV_BEZIER_VAL_SHIFT so it works for all paths*/
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_ANIM_RES_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
@@ -96,6 +96,7 @@ typedef struct _lv_anim_t {
     uint8_t playback_now : 1; /**< Play back is in progress*/
     uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
+    uint8_t changed : 1;      /**< The values, time or path were set since the value was calculated*/
 } lv_anim_t;
 
 /**********************
@@ -148,6 +149,7 @@ static inline void lv_anim_set_exec_cb(lv_anim_t * a, lv_anim_exec_xcb_t exec_cb
 static inline void lv_anim_set_time(lv_anim_t * a, uint32_t duration)
 {
     a->time = duration;
+    a->changed = 1;
 }
 
 /**
@@ -171,6 +173,7 @@ static inline void lv_anim_set_values(lv_anim_t * a, int32_t start, int32_t end)
     a->start_value = start;
     a->current_value = start;
     a->end_value = end;
+    a->changed = 1;
 }
 
 /**
@@ -196,6 +199,7 @@ static inline void lv_anim_set_custom_exec_cb(lv_anim_t * a, lv_anim_custom_exec
 static inline void lv_anim_set_path_cb(lv_anim_t * a, lv_anim_path_cb_t path_cb)
 {
     a->path_cb = path_cb;
+    a->changed = 1;
 }
 
 /**
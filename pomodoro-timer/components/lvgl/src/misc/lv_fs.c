@@ -12,23 +12,84 @@
 #include "lv_ll.h"
 #include <string.h>
 #include "lv_gc.h"
+#include "lv_os.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_FS_BLOCK_CACHE_SIZE
+    #define BLOCK_CNT   (LV_FS_BLOCK_CACHE_SIZE / LV_FS_BLOCK_SIZE)
+    #define BLOCK_NONE  0xFFFF
+
+    #if BLOCK_CNT < 8 || BLOCK_CNT >= BLOCK_NONE
+        #error "LV_FS_BLOCK_CACHE_SIZE must be 8..65534 times LV_FS_BLOCK_SIZE"
+    #endif
+
+    /*Leave most of the cache for the other files*/
+    #define READ_AHEAD  LV_MAX(1, LV_MIN(LV_FS_READ_AHEAD, BLOCK_CNT / 4))
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FS_BLOCK_CACHE_SIZE
+/*A file in the block cache. It's kept while it's opened or has blocks in the cache.*/
+typedef struct _lv_fs_block_src_t {
+    struct _lv_fs_block_src_t * next;
+    uint32_t open_cnt;
+    uint32_t block_cnt;
+    char path[];
+} block_src_t;
+
+typedef struct {
+    block_src_t * src;      /*NULL if the block is free*/
+    uint32_t index;         /*Index of the block in the file*/
+    uint32_t len;           /*Valid bytes. Less than LV_FS_BLOCK_SIZE only at the end of the file*/
+    uint16_t prev;          /*Toward the most recently used block*/
+    uint16_t next;          /*Toward the least recently used block*/
+    uint16_t hash_next;     /*Next block with the same hash*/
+} block_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+static bool is_block_cached(lv_fs_file_t * file_p);
+
+#if LV_FS_BLOCK_CACHE_SIZE
+    static void block_cache_lock(void);
+    static void block_cache_unlock(void);
+    static block_src_t * src_open(const char * path);
+    static void src_close(block_src_t * src);
+    static void src_invalidate(block_src_t * src);
+    static void src_delete_if_unused(block_src_t * src);
+    static uint32_t block_hash(block_src_t * src, uint32_t index);
+    static uint16_t block_find(block_src_t * src, uint32_t index);
+    static void lru_unlink(uint16_t b);
+    static void block_move_to_head(uint16_t b);
+    static void block_move_to_tail(uint16_t b);
+    static void block_add(uint16_t b, block_src_t * src, uint32_t index, uint32_t len);
+    static void block_free(uint16_t b);
+    static uint16_t block_load(lv_fs_file_t * file_p, uint32_t index, lv_fs_res_t * res);
+    static lv_fs_res_t drv_seek_to(lv_fs_file_t * file_p, uint32_t pos);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_FS_BLOCK_CACHE_SIZE
+    static uint8_t block_data[BLOCK_CNT][LV_FS_BLOCK_SIZE];
+    static block_t blocks[BLOCK_CNT];
+    static uint16_t hash_table[BLOCK_CNT];
+    static uint16_t lru_head;               /*The most recently used block*/
+    static uint16_t lru_tail;               /*The least recently used block*/
+    static block_src_t * src_list;
+    static lv_fs_block_cache_stats_t block_stats;
+    #if LV_USE_OS != LV_OS_NONE
+        static lv_mutex_t block_lock;       /*The cache is shared with the threads decoding images*/
+    #endif
+#endif
 
 /**********************
  *      MACROS
@@ -41,6 +102,27 @@ static const char * lv_fs_get_real_path(const char * path);
 void _lv_fs_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_fsdrv_ll), sizeof(lv_fs_drv_t *));
+
+#if LV_FS_BLOCK_CACHE_SIZE
+    /*All blocks are free and linked in the LRU list*/
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        blocks[i].src = NULL;
+        blocks[i].prev = i == 0 ? BLOCK_NONE : i - 1;
+        blocks[i].next = i == BLOCK_CNT - 1 ? BLOCK_NONE : i + 1;
+        hash_table[i] = BLOCK_NONE;
+    }
+    lru_head = 0;
+    lru_tail = BLOCK_CNT - 1;
+    src_list = NULL;
+    lv_memset_00(&block_stats, sizeof(block_stats));
+
+#if LV_USE_OS != LV_OS_NONE
+    if(lv_mutex_init(&block_lock) != LV_RES_OK) {
+        LV_LOG_ERROR("Couldn't create the lock of the block cache");
+    }
+#endif
+#endif
 }
 
 bool lv_fs_is_ready(char letter)
@@ -90,13 +172,40 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     file_p->drv = drv;
     file_p->file_d = file_d;
+    file_p->cache = NULL;
+
+#if LV_FS_BLOCK_CACHE_SIZE
+    /*The cached blocks of the file would be outdated.
+     *The readers can load them again meanwhile so they are dropped on every write and on close too.*/
+    file_p->wr_src = NULL;
+    if(mode & LV_FS_MODE_WR) {
+        lv_fs_block_cache_invalidate(path);
+        file_p->wr_src = src_open(path);
+    }
+#endif
+
+    /*If mapped, the file can be read without the driver*/
+    const void * map = NULL;
+    uint32_t map_size = 0;
+    if(mode == LV_FS_MODE_RD && drv->map_cb) {
+        map = drv->map_cb(drv, file_d, &map_size);
+    }
 
-    if(drv->cache_size) {
+    if(drv->cache_size || map) {
         file_p->cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t));
         LV_ASSERT_MALLOC(file_p->cache);
         lv_memset_00(file_p->cache, sizeof(lv_fs_file_cache_t));
         file_p->cache->start = UINT32_MAX;  /*Set an invalid range by default*/
         file_p->cache->end = UINT32_MAX - 1;
+        file_p->cache->map = map;
+        file_p->cache->map_size = map_size;
+
+#if LV_FS_BLOCK_CACHE_SIZE
+        /*Files opened for writing use the cache window of the driver*/
+        if(map == NULL && mode == LV_FS_MODE_RD) {
+            file_p->cache->src = src_open(path);
+        }
+#endif
     }
 
     return LV_FS_RES_OK;
@@ -112,13 +221,29 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+    if(file_p->cache && file_p->cache->map && file_p->drv->unmap_cb) {
+        file_p->drv->unmap_cb(file_p->drv, file_p->file_d, file_p->cache->map, file_p->cache->map_size);
+    }
+
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
-    if(file_p->drv->cache_size && file_p->cache) {
+#if LV_FS_BLOCK_CACHE_SIZE
+    /*The written data might have been buffered by the driver until now*/
+    if(file_p->wr_src) {
+        src_invalidate(file_p->wr_src);
+        src_close(file_p->wr_src);
+        file_p->wr_src = NULL;
+    }
+#endif
+
+    if(file_p->cache) {
         if(file_p->cache->buffer) {
             lv_mem_free(file_p->cache->buffer);
         }
 
+#if LV_FS_BLOCK_CACHE_SIZE
+        if(file_p->cache->src) src_close(file_p->cache->src);
+#endif
         lv_mem_free(file_p->cache);
     }
 
@@ -202,6 +327,80 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
     return res;
 }
 
+static lv_fs_res_t lv_fs_read_mapped(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache->file_position < cache->map_size) {
+        *br = LV_MIN(btr, cache->map_size - cache->file_position);
+        lv_memcpy(buf, cache->map + cache->file_position, *br);
+        cache->file_position += *br;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+#if LV_FS_BLOCK_CACHE_SIZE
+static lv_fs_res_t lv_fs_read_blocks(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    lv_fs_res_t res = LV_FS_RES_OK;
+
+    block_cache_lock();
+    while(btr > 0) {
+        uint32_t index = cache->file_position / LV_FS_BLOCK_SIZE;
+        uint32_t offset = cache->file_position % LV_FS_BLOCK_SIZE;
+        uint16_t b = block_find(cache->src, index);
+
+        if(b == BLOCK_NONE && offset == 0 && btr >= LV_FS_BLOCK_SIZE) {
+            /*Read the whole blocks of large chunks directly, so that they don't flush the cache*/
+            uint32_t direct_size = btr - btr % LV_FS_BLOCK_SIZE;
+            uint32_t rn = 0;
+            res = drv_seek_to(file_p, cache->file_position);
+            if(res != LV_FS_RES_OK) break;
+            res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, direct_size, &rn);
+            block_stats.read_cnt++;
+            if(res != LV_FS_RES_OK) {
+                cache->drv_position = UINT32_MAX;   /*Unknown*/
+                break;
+            }
+
+            cache->drv_position += rn;
+            cache->file_position += rn;
+            cache->next_block = index + rn / LV_FS_BLOCK_SIZE;
+            buf += rn;
+            btr -= rn;
+            *br += rn;
+            if(rn < direct_size) break;     /*End of the file*/
+            continue;
+        }
+
+        if(b == BLOCK_NONE) {
+            b = block_load(file_p, index, &res);
+            if(b == BLOCK_NONE) break;     /*End of the file or error*/
+        }
+        else {
+            block_stats.hit_cnt++;
+        }
+
+        block_move_to_head(b);
+        if(offset >= blocks[b].len) break;
+
+        uint32_t n = LV_MIN(blocks[b].len - offset, btr);
+        lv_memcpy(buf, block_data[b] + offset, n);
+        cache->file_position += n;
+        buf += n;
+        btr -= n;
+        *br += n;
+
+        /*The last block of the file*/
+        if(blocks[b].len < LV_FS_BLOCK_SIZE && offset + n == blocks[b].len) break;
+    }
+    block_cache_unlock();
+
+    return res;
+}
+#endif
+
 lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
 {
     if(br != NULL) *br = 0;
@@ -211,7 +410,15 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     uint32_t br_tmp = 0;
     lv_fs_res_t res;
 
-    if(file_p->drv->cache_size) {
+    if(file_p->cache && file_p->cache->map) {
+        res = lv_fs_read_mapped(file_p, (char *)buf, btr, &br_tmp);
+    }
+#if LV_FS_BLOCK_CACHE_SIZE
+    else if(is_block_cached(file_p)) {
+        res = lv_fs_read_blocks(file_p, (char *)buf, btr, &br_tmp);
+    }
+#endif
+    else if(file_p->cache) {
         res = lv_fs_read_cached(file_p, (char *)buf, btr, &br_tmp);
     }
     else {
@@ -239,6 +446,10 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
     if(bw != NULL) *bw = bw_tmp;
 
+#if LV_FS_BLOCK_CACHE_SIZE
+    if(file_p->wr_src && bw_tmp) src_invalidate(file_p->wr_src);
+#endif
+
     return res;
 }
 
@@ -253,7 +464,39 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
     }
 
     lv_fs_res_t res = LV_FS_RES_OK;
-    if(file_p->drv->cache_size) {
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache && (cache->map || is_block_cached(file_p))) {
+        /*Only the position is set here, the driver seeks when it needs to read*/
+        switch(whence) {
+            case LV_FS_SEEK_SET:
+                cache->file_position = pos;
+                break;
+            case LV_FS_SEEK_CUR:
+                cache->file_position += pos;
+                break;
+            case LV_FS_SEEK_END:
+                if(cache->map) {
+                    cache->file_position = cache->map_size + pos;
+                }
+#if LV_FS_BLOCK_CACHE_SIZE
+                else {
+                    cache->drv_position = UINT32_MAX;
+                    res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+                    if(res == LV_FS_RES_OK) {
+                        res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, &cache->drv_position);
+                    }
+                    if(res == LV_FS_RES_OK) {
+                        cache->file_position = cache->drv_position;
+                    }
+                    else {
+                        cache->drv_position = UINT32_MAX;
+                    }
+                }
+#endif
+                break;
+        }
+    }
+    else if(cache) {
         switch(whence) {
             case LV_FS_SEEK_SET: {
                     file_p->cache->file_position = pos;
@@ -310,7 +553,7 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     }
 
     lv_fs_res_t res;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         *pos = file_p->cache->file_position;
         res = LV_FS_RES_OK;
     }
@@ -321,6 +564,43 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+const void * lv_fs_get_map(lv_fs_file_t * file_p, uint32_t * size)
+{
+    if(file_p->cache == NULL || file_p->cache->map == NULL) {
+        if(size) *size = 0;
+        return NULL;
+    }
+
+    if(size) *size = file_p->cache->map_size;
+    return file_p->cache->map;
+}
+
+void lv_fs_block_cache_invalidate(const char * path)
+{
+#if LV_FS_BLOCK_CACHE_SIZE
+    block_cache_lock();
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        if(blocks[i].src == NULL) continue;
+        if(path == NULL || strcmp(blocks[i].src->path, path) == 0) block_free(i);
+    }
+    block_cache_unlock();
+#else
+    LV_UNUSED(path);
+#endif
+}
+
+void lv_fs_block_cache_get_stats(lv_fs_block_cache_stats_t * stats)
+{
+#if LV_FS_BLOCK_CACHE_SIZE
+    block_cache_lock();
+    *stats = block_stats;
+    block_cache_unlock();
+#else
+    lv_memset_00(stats, sizeof(lv_fs_block_cache_stats_t));
+#endif
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -516,3 +796,232 @@ static const char * lv_fs_get_real_path(const char * path)
 
     return path;
 }
+
+static bool is_block_cached(lv_fs_file_t * file_p)
+{
+#if LV_FS_BLOCK_CACHE_SIZE
+    return file_p->cache && file_p->cache->src;
+#else
+    LV_UNUSED(file_p);
+    return false;
+#endif
+}
+
+#if LV_FS_BLOCK_CACHE_SIZE
+
+static void block_cache_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_lock(&block_lock);
+#endif
+}
+
+static void block_cache_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_unlock(&block_lock);
+#endif
+}
+
+/**
+ * Find or add the file with the given path in the block cache. The cached blocks are shared by the opened instances.
+ * @param path  path to the file with the driver letter
+ * @return      the file or NULL if there is not enough memory
+ */
+static block_src_t * src_open(const char * path)
+{
+    block_cache_lock();
+    block_src_t * src;
+    for(src = src_list; src; src = src->next) {
+        if(strcmp(src->path, path) == 0) break;
+    }
+
+    if(src == NULL) {
+        size_t len = strlen(path);
+        src = lv_mem_alloc(sizeof(block_src_t) + len + 1);
+        LV_ASSERT_MALLOC(src);
+        if(src) {
+            src->open_cnt = 0;
+            src->block_cnt = 0;
+            lv_memcpy(src->path, path, len + 1);
+            src->next = src_list;
+            src_list = src;
+        }
+    }
+
+    if(src) src->open_cnt++;
+    block_cache_unlock();
+    return src;
+}
+
+static void src_close(block_src_t * src)
+{
+    block_cache_lock();
+    src->open_cnt--;
+    src_delete_if_unused(src);
+    block_cache_unlock();
+}
+
+/**
+ * Drop the cached blocks of a file
+ * @param src   the file in the block cache
+ */
+static void src_invalidate(block_src_t * src)
+{
+    block_cache_lock();
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT && src->block_cnt; i++) {
+        if(blocks[i].src == src) block_free(i);
+    }
+    block_cache_unlock();
+}
+
+static void src_delete_if_unused(block_src_t * src)
+{
+    if(src->open_cnt || src->block_cnt) return;
+
+    block_src_t ** prev = &src_list;
+    while(*prev != src) prev = &(*prev)->next;
+    *prev = src->next;
+    lv_mem_free(src);
+}
+
+static uint32_t block_hash(block_src_t * src, uint32_t index)
+{
+    return (uint32_t)(((lv_uintptr_t)src >> 3) * 31 + index) % BLOCK_CNT;
+}
+
+static uint16_t block_find(block_src_t * src, uint32_t index)
+{
+    uint16_t b = hash_table[block_hash(src, index)];
+    while(b != BLOCK_NONE) {
+        if(blocks[b].src == src && blocks[b].index == index) return b;
+        b = blocks[b].hash_next;
+    }
+
+    return BLOCK_NONE;
+}
+
+static void lru_unlink(uint16_t b)
+{
+    if(blocks[b].prev != BLOCK_NONE) blocks[blocks[b].prev].next = blocks[b].next;
+    else lru_head = blocks[b].next;
+
+    if(blocks[b].next != BLOCK_NONE) blocks[blocks[b].next].prev = blocks[b].prev;
+    else lru_tail = blocks[b].prev;
+}
+
+static void block_move_to_head(uint16_t b)
+{
+    if(lru_head == b) return;
+
+    lru_unlink(b);
+    blocks[b].prev = BLOCK_NONE;
+    blocks[b].next = lru_head;
+    blocks[lru_head].prev = b;
+    lru_head = b;
+}
+
+static void block_move_to_tail(uint16_t b)
+{
+    if(lru_tail == b) return;
+
+    lru_unlink(b);
+    blocks[b].next = BLOCK_NONE;
+    blocks[b].prev = lru_tail;
+    blocks[lru_tail].next = b;
+    lru_tail = b;
+}
+
+static void block_add(uint16_t b, block_src_t * src, uint32_t index, uint32_t len)
+{
+    blocks[b].src = src;
+    blocks[b].index = index;
+    blocks[b].len = len;
+
+    uint16_t * head = &hash_table[block_hash(src, index)];
+    blocks[b].hash_next = *head;
+    *head = b;
+
+    src->block_cnt++;
+    block_move_to_head(b);
+}
+
+/*Free a block and make it the first to reuse*/
+static void block_free(uint16_t b)
+{
+    block_src_t * src = blocks[b].src;
+    if(src == NULL) return;
+
+    uint16_t * p = &hash_table[block_hash(src, blocks[b].index)];
+    while(*p != b) p = &blocks[*p].hash_next;
+    *p = blocks[b].hash_next;
+
+    blocks[b].src = NULL;
+    src->block_cnt--;
+    src_delete_if_unused(src);
+    block_move_to_tail(b);
+}
+
+/**
+ * Load a block of a file into the cache. If the file is read sequentially the next blocks are loaded too.
+ * @param file_p    pointer to a file using the block cache
+ * @param index     index of the block to load
+ * @param res       store the result of the driver here
+ * @return          the loaded block or `BLOCK_NONE` at the end of the file or on error
+ */
+static uint16_t block_load(lv_fs_file_t * file_p, uint32_t index, lv_fs_res_t * res)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+
+    uint32_t cnt = 1;
+    if(index == cache->next_block) {
+        while(cnt < READ_AHEAD && block_find(cache->src, index + cnt) == BLOCK_NONE) cnt++;
+    }
+
+    /*Adjacent blocks are needed to load them with one read,
+     *so replace the group of READ_AHEAD blocks around the least recently used one*/
+    uint32_t first = lru_tail;
+    if(cnt > 1) {
+        first = first - first % READ_AHEAD;
+        if(first + cnt > BLOCK_CNT) first = BLOCK_CNT - cnt;
+    }
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) block_free(first + i);
+
+    *res = drv_seek_to(file_p, index * LV_FS_BLOCK_SIZE);
+    if(*res != LV_FS_RES_OK) return BLOCK_NONE;
+
+    uint32_t rn = 0;
+    *res = file_p->drv->read_cb(file_p->drv, file_p->file_d, block_data[first], cnt * LV_FS_BLOCK_SIZE, &rn);
+    block_stats.read_cnt++;
+    if(*res != LV_FS_RES_OK) {
+        cache->drv_position = UINT32_MAX;   /*Unknown*/
+        return BLOCK_NONE;
+    }
+    cache->drv_position += rn;
+
+    /*Add them backward to make the requested block the most recently used*/
+    cnt = (rn + LV_FS_BLOCK_SIZE - 1) / LV_FS_BLOCK_SIZE;
+    for(i = cnt; i > 0; i--) {
+        uint32_t offset = (i - 1) * LV_FS_BLOCK_SIZE;
+        block_add(first + i - 1, cache->src, index + i - 1, LV_MIN(rn - offset, LV_FS_BLOCK_SIZE));
+    }
+    block_stats.miss_cnt += cnt;
+    cache->next_block = index + cnt;
+
+    return cnt ? first : BLOCK_NONE;
+}
+
+/*Seek with the driver only if it's not at the required position*/
+static lv_fs_res_t drv_seek_to(lv_fs_file_t * file_p, uint32_t pos)
+{
+    if(file_p->cache->drv_position == pos) return LV_FS_RES_OK;
+
+    lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+    file_p->cache->drv_position = res == LV_FS_RES_OK ? pos : UINT32_MAX;
+    return res;
+}
+
+#endif /*LV_FS_BLOCK_CACHE_SIZE*/
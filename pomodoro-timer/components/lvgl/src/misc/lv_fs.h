@@ -79,6 +79,10 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 
+    /*Optional. Map a file opened for reading into the memory and return its address and size, or NULL.*/
+    const void * (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size);
+    void (*unmap_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * map, uint32_t size);
+
     void * (*dir_open_cb)(struct _lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
@@ -93,12 +97,22 @@ typedef struct {
     uint32_t end;
     uint32_t file_position;
     void * buffer;
+    const uint8_t * map;                /*The mapped file or NULL*/
+    uint32_t map_size;
+#if LV_FS_BLOCK_CACHE_SIZE
+    struct _lv_fs_block_src_t * src;    /*The blocks of the file in the block cache*/
+    uint32_t drv_position;              /*Position of the driver's file*/
+    uint32_t next_block;                /*The block after the last loaded ones to detect sequential reading*/
+#endif
 } lv_fs_file_cache_t;
 
 typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
     lv_fs_file_cache_t * cache;
+#if LV_FS_BLOCK_CACHE_SIZE
+    struct _lv_fs_block_src_t * wr_src; /*The file in the block cache if it's opened for writing*/
+#endif
 } lv_fs_file_t;
 
 typedef struct {
@@ -106,6 +120,12 @@ typedef struct {
     lv_fs_drv_t * drv;
 } lv_fs_dir_t;
 
+typedef struct {
+    uint32_t hit_cnt;       /**< Blocks read from the block cache*/
+    uint32_t miss_cnt;      /**< Blocks loaded from the driver*/
+    uint32_t read_cnt;      /**< Calls of the drivers' `read_cb` by the block cache*/
+} lv_fs_block_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -199,6 +219,28 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get the content of a file if the driver mapped it into the memory (see `map_cb`).
+ * The data can be used without copying until the file is closed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param size      store the size of the file here. NULL if unused.
+ * @return          pointer to the content of the file or NULL if it's not mapped
+ */
+const void * lv_fs_get_map(lv_fs_file_t * file_p, uint32_t * size);
+
+/**
+ * Drop the blocks of a file from the block cache.
+ * Needs to be called if a file is modified bypassing `lv_fs`. Opening it for writing drops its blocks too.
+ * @param path      path of the file beginning with the driver letter or NULL to drop all blocks
+ */
+void lv_fs_block_cache_invalidate(const char * path);
+
+/**
+ * Get the statistics of the block cache
+ * @param stats     store the statistics here
+ */
+void lv_fs_block_cache_get_stats(lv_fs_block_cache_stats_t * stats);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "lv_os.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -39,9 +40,37 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if _LV_MEM_SLAB
+    #define SLAB_PAGE_SIZE      512
+    #define SLAB_PAGE_NUM       (LV_MEM_SLAB_SIZE / SLAB_PAGE_SIZE)
+    #define SLAB_CLASS_STEP     16
+    #define SLAB_MAX_SIZE       (_LV_MEM_SLAB_CLASS_NUM * SLAB_CLASS_STEP)
+    #define SLAB_NONE           0xFFFF
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if _LV_MEM_SLAB
+/*A page of the slabs. It's split to equal blocks of its size class.*/
+typedef struct {
+    uint16_t free_head;     /*Index of the first freed block. The free blocks store the index of the next one.*/
+    uint16_t bump;          /*The blocks from this index were never allocated*/
+    uint16_t used_cnt;
+    uint16_t prev;          /*The pages of a class with free blocks are linked*/
+    uint16_t next;          /*Next page with free blocks or the next unused page*/
+    uint8_t cls;
+} slab_page_t;
+
+typedef struct {
+    uint16_t partial;       /*First page with free blocks*/
+    uint16_t block_per_page;
+    uint32_t page_cnt;
+    uint32_t used_cnt;
+    uint32_t alloc_cnt;
+    uint32_t fallback_cnt;
+} slab_class_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -49,6 +78,13 @@
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
+#if _LV_MEM_SLAB
+    static void slab_init(void);
+    static void * slab_alloc(size_t size);
+    static size_t slab_free(void * data);
+    static inline bool slab_owns(const void * data);
+    static inline size_t slab_get_size(const void * data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -59,7 +95,25 @@
     static uint32_t max_used;
 #endif
 
+#if _LV_MEM_SLAB
+    static uint8_t * slab_mem;
+    static slab_page_t slab_pages[SLAB_PAGE_NUM];
+    static slab_class_t slab_classes[_LV_MEM_SLAB_CLASS_NUM];
+    static uint16_t slab_free_pages;    /*First page not used by any class*/
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_USE_OS != LV_OS_NONE
+    static lv_mutex_t mem_lock;
+    static bool mem_lock_init;
+#endif
+
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
+static lv_mem_buf_monitor_t buf_mon;
+static uint32_t buf_frame_peak;         /*The most arena memory needed at the same time since the last frame end*/
+#if LV_MEM_BUF_SHRINK_FRAMES
+    static uint32_t buf_small_peak;     /*The largest peak of the frames which needed less than the arena*/
+    static uint32_t buf_small_cnt;      /*Number of such frames in a row*/
+#endif
 
 /**********************
  *      MACROS
@@ -70,6 +124,15 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+/*Let other threads (e.g. the background image decoder) allocate too*/
+#if LV_MEM_CUSTOM == 0 && LV_USE_OS != LV_OS_NONE
+    #define MEM_LOCK()      lv_mutex_lock(&mem_lock)
+    #define MEM_UNLOCK()    lv_mutex_unlock(&mem_lock)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -86,6 +149,12 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
 void lv_mem_init(void)
 {
 #if LV_MEM_CUSTOM == 0
+#if LV_USE_OS != LV_OS_NONE
+    if(!mem_lock_init) {
+        lv_mutex_init(&mem_lock);
+        mem_lock_init = true;
+    }
+#endif
 
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
@@ -100,6 +169,12 @@ void lv_mem_init(void)
 #endif
 #endif
 
+#if _LV_MEM_SLAB
+    slab_init();
+#endif
+
+    lv_memset_00(&buf_mon, sizeof(buf_mon));
+
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
 #endif
@@ -131,7 +206,19 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
+    MEM_LOCK();
+    void * alloc = NULL;
+#if _LV_MEM_SLAB
+    if(size <= SLAB_MAX_SIZE) alloc = slab_alloc(size);
+    if(alloc == NULL)
+#endif
+        alloc = lv_tlsf_malloc(tlsf, size);
+
+    if(alloc) {
+        cur_used += size;
+        max_used = LV_MAX(cur_used, max_used);
+    }
+    MEM_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -152,13 +239,7 @@ void * lv_mem_alloc(size_t size)
     }
 #endif
 
-    if(alloc) {
-#if LV_MEM_CUSTOM == 0
-        cur_used += size;
-        max_used = LV_MAX(cur_used, max_used);
-#endif
-        MEM_TRACE("allocated at %p", alloc);
-    }
+    if(alloc) MEM_TRACE("allocated at %p", alloc);
     return alloc;
 }
 
@@ -173,12 +254,23 @@ void lv_mem_free(void * data)
     if(data == NULL) return;
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+    size_t size;
+#  if _LV_MEM_SLAB
+    if(slab_owns(data)) {
+        size = slab_free(data);
+    }
+    else
+#  endif
+    {
 #  if LV_MEM_ADD_JUNK
-    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
+        lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
-    size_t size = lv_tlsf_free(tlsf, data);
+        size = lv_tlsf_free(tlsf, data);
+    }
     if(cur_used > size) cur_used -= size;
     else cur_used = 0;
+    MEM_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -202,8 +294,42 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
+#if _LV_MEM_SLAB
+    /*Let the small new allocations go to the slabs*/
+    if(data_p == NULL) return lv_mem_alloc(new_size);
+
+    /*Keep the block if it's still in the right size class, else move it.
+     *The slabs might be changed by an other thread so do everything in one lock.*/
+    MEM_LOCK();
+    if(slab_owns(data_p)) {
+        size_t old_size = slab_get_size(data_p);
+        void * new_slab_p = data_p;
+        if(new_size > old_size || new_size <= old_size - SLAB_CLASS_STEP) {
+            new_slab_p = NULL;
+            if(new_size <= SLAB_MAX_SIZE) new_slab_p = slab_alloc(new_size);
+            if(new_slab_p == NULL) new_slab_p = lv_tlsf_malloc(tlsf, new_size);
+
+            if(new_slab_p) {
+                cur_used += new_size;
+                max_used = LV_MAX(cur_used, max_used);
+                lv_memcpy(new_slab_p, data_p, LV_MIN(old_size, new_size));
+                size_t freed = slab_free(data_p);
+                if(cur_used > freed) cur_used -= freed;
+                else cur_used = 0;
+            }
+        }
+        MEM_UNLOCK();
+
+        if(new_slab_p == NULL) LV_LOG_ERROR("couldn't allocate memory");
+        return new_slab_p;
+    }
+    MEM_UNLOCK();
+#endif
+
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    MEM_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -224,12 +350,17 @@ lv_res_t lv_mem_test(void)
     }
 
 #if LV_MEM_CUSTOM == 0
-    if(lv_tlsf_check(tlsf)) {
+    MEM_LOCK();
+    int tlsf_res = lv_tlsf_check(tlsf);
+    int pool_res = lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf));
+    MEM_UNLOCK();
+
+    if(tlsf_res) {
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
-    if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+    if(pool_res) {
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
@@ -250,10 +381,10 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
 
     mon_p->total_size = LV_MEM_SIZE;
-    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
@@ -262,15 +393,59 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 
+#if _LV_MEM_SLAB
+    /*The slabs are one block in the heap. Count their free blocks as free memory and the allocated blocks as used.
+     *The fragmentation is about the heap only as the slabs can't serve large allocations anyway.*/
+    if(slab_mem) {
+        mon_p->used_cnt--;
+        uint32_t i;
+        for(i = 0; i < _LV_MEM_SLAB_CLASS_NUM; i++) {
+            slab_class_t * c = &slab_classes[i];
+            lv_mem_slab_monitor_t * m = &mon_p->slab[i];
+            m->size = (i + 1) * SLAB_CLASS_STEP;
+            m->page_cnt = c->page_cnt;
+            m->used_cnt = c->used_cnt;
+            m->free_cnt = c->page_cnt * c->block_per_page - c->used_cnt;
+            m->alloc_cnt = c->alloc_cnt;
+            m->fallback_cnt = c->fallback_cnt;
+            mon_p->used_cnt += m->used_cnt;
+            mon_p->free_size += m->free_cnt * m->size;
+            mon_p->free_cnt += m->free_cnt;
+        }
+
+        uint16_t p;
+        for(p = slab_free_pages; p != SLAB_NONE; p = slab_pages[p].next) mon_p->slab_free_page_cnt++;
+        mon_p->free_size += mon_p->slab_free_page_cnt * SLAB_PAGE_SIZE;
+    }
+#endif
+
     mon_p->max_used = max_used;
+    MEM_UNLOCK();
+
+    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
 
     MEM_TRACE("finished");
 #endif
 }
 
+/**
+ * Restart measuring `max_used` of `lv_mem_monitor()` from the current usage.
+ * Useful to get the peak memory usage of an operation.
+ */
+void lv_mem_monitor_reset_max(void)
+{
+#if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+    max_used = cur_used;
+    MEM_UNLOCK();
+#endif
+}
+
 
 /**
  * Get a temporal buffer with the given size.
+ * The buffers are bump allocated from an arena. If it's too small they are allocated from the heap
+ * and the arena is grown at the end of the refresh.
  * @param size the required size
  */
 void * lv_mem_buf_get(uint32_t size)
@@ -278,51 +453,45 @@ void * lv_mem_buf_get(uint32_t size)
     if(size == 0) return NULL;
 
     MEM_TRACE("begin, getting %d bytes", size);
+    buf_mon.get_cnt++;
 
-    /*Try to find a free buffer with suitable size*/
-    int8_t i_guess = -1;
+    /*Find a free slot and the end of the used part of the arena*/
+    int32_t i_free = -1;
+    uint32_t top = 0;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
-        }
+        lv_mem_buf_t * buf = &LV_GC_ROOT(lv_mem_buf[i]);
+        if(buf->used) top = LV_MAX(top, buf->ofs + buf->size);
+        else if(i_free < 0) i_free = i;
     }
 
-    if(i_guess >= 0) {
-        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
-        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
-                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
-        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
+    if(i_free < 0) {
+        LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
+        LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
+        return NULL;
     }
 
-    /*Reallocate a free buffer*/
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
-            LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
-            if(buf == NULL) return NULL;
-
-            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
-            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
-            return LV_GC_ROOT(lv_mem_buf[i]).p;
-        }
+    lv_mem_buf_t * buf = &LV_GC_ROOT(lv_mem_buf[i_free]);
+    buf->size = (size + ALIGN_MASK) & ~ALIGN_MASK;
+    buf->ofs = top;
+    buf_mon.high_water = LV_MAX(buf_mon.high_water, top + buf->size);
+    buf_frame_peak = LV_MAX(buf_frame_peak, top + buf->size);
+
+    if(top + buf->size <= buf_mon.arena_size) {
+        buf->p = LV_GC_ROOT(_lv_mem_buf_arena) + top;
+        buf->heap = 0;
+    }
+    else {
+        /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+        buf->p = lv_mem_alloc(size);
+        buf_mon.alloc_cnt++;
+        LV_ASSERT_MSG(buf->p != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
+        if(buf->p == NULL) return NULL;
+        buf->heap = 1;
     }
 
-    LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
-    LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
-    return NULL;
+    buf->used = 1;
+    MEM_TRACE("returning buffer (buffer id: %d, address: %p)", i_free, buf->p);
+    return buf->p;
 }
 
 /**
@@ -334,8 +503,12 @@ void lv_mem_buf_release(void * p)
     MEM_TRACE("begin (address: %p)", p);
 
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
+        lv_mem_buf_t * buf = &LV_GC_ROOT(lv_mem_buf[i]);
+        if(buf->used && buf->p == p) {
+            if(buf->heap) lv_mem_free(buf->p);
+            buf->used = 0;
+            buf->heap = 0;
+            buf->p = NULL;
             return;
         }
     }
@@ -349,13 +522,79 @@ void lv_mem_buf_release(void * p)
 void lv_mem_buf_free_all(void)
 {
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
-            LV_GC_ROOT(lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(lv_mem_buf[i]).size = 0;
+        lv_mem_buf_t * buf = &LV_GC_ROOT(lv_mem_buf[i]);
+        if(buf->heap) lv_mem_free(buf->p);
+        lv_memset_00(buf, sizeof(lv_mem_buf_t));
+    }
+
+    lv_mem_free(LV_GC_ROOT(_lv_mem_buf_arena));
+    LV_GC_ROOT(_lv_mem_buf_arena) = NULL;
+    buf_mon.arena_size = 0;
+    buf_frame_peak = 0;
+#if LV_MEM_BUF_SHRINK_FRAMES
+    buf_small_peak = 0;
+    buf_small_cnt = 0;
+#endif
+}
+
+/**
+ * Called at the end of a refresh. If no buffers are in use grow the arena to the peak of the frame
+ * so that the next refresh can take all buffers from the arena.
+ * If `LV_MEM_BUF_SHRINK_FRAMES` frames in a row needed less, shrink it to the largest of their peaks.
+ */
+void _lv_mem_buf_frame_end(void)
+{
+    /*Nothing was drawn (it's called on every refresh timer tick) so don't count it*/
+    uint32_t peak = buf_frame_peak;
+    if(peak == 0) return;
+    buf_frame_peak = 0;
+
+    uint32_t new_size;
+    if(peak > buf_mon.arena_size) {
+        new_size = peak;
+    }
+#if LV_MEM_BUF_SHRINK_FRAMES
+    else if(peak < buf_mon.arena_size) {
+        buf_small_peak = LV_MAX(buf_small_peak, peak);
+        buf_small_cnt++;
+        if(buf_small_cnt < LV_MEM_BUF_SHRINK_FRAMES) return;
+        new_size = buf_small_peak;
+    }
+    else {
+        buf_small_peak = 0;
+        buf_small_cnt = 0;
+        return;
+    }
+#else
+    else return;
+#endif
+
+    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(lv_mem_buf[i]).used) {
+            LV_LOG_WARN("a buffer is still in use, not releasing it is probably a bug");
+            return;
         }
     }
+
+#if LV_MEM_BUF_SHRINK_FRAMES
+    buf_small_peak = 0;
+    buf_small_cnt = 0;
+#endif
+
+    /*No need to keep the content so don't realloc*/
+    lv_mem_free(LV_GC_ROOT(_lv_mem_buf_arena));
+    LV_GC_ROOT(_lv_mem_buf_arena) = lv_mem_alloc(new_size);
+    buf_mon.alloc_cnt++;
+    buf_mon.arena_size = LV_GC_ROOT(_lv_mem_buf_arena) ? new_size : 0;
+}
+
+/**
+ * Give information about the temporal buffers
+ * @param mon_p pointer to a `lv_mem_buf_monitor_t` variable, the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p)
+{
+    *mon_p = buf_mon;
 }
 
 #if LV_MEMCPY_MEMSET_STD == 0
@@ -564,3 +803,145 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if _LV_MEM_SLAB
+/**
+ * Reserve the memory of the slabs from the heap and make all pages free.
+ */
+static void slab_init(void)
+{
+    slab_mem = lv_tlsf_malloc(tlsf, SLAB_PAGE_NUM * SLAB_PAGE_SIZE);
+    if(slab_mem == NULL) {
+        LV_LOG_WARN("couldn't allocate the slabs, LV_MEM_SLAB_SIZE is too large");
+    }
+
+    uint32_t i;
+    for(i = 0; i < SLAB_PAGE_NUM; i++) {
+        slab_pages[i].next = i + 1 < SLAB_PAGE_NUM ? i + 1 : SLAB_NONE;
+    }
+    slab_free_pages = slab_mem ? 0 : SLAB_NONE;
+
+    lv_memset_00(slab_classes, sizeof(slab_classes));
+    for(i = 0; i < _LV_MEM_SLAB_CLASS_NUM; i++) {
+        slab_classes[i].partial = SLAB_NONE;
+        slab_classes[i].block_per_page = SLAB_PAGE_SIZE / ((i + 1) * SLAB_CLASS_STEP);
+    }
+}
+
+static void slab_partial_unlink(slab_class_t * c, uint16_t page_id)
+{
+    slab_page_t * page = &slab_pages[page_id];
+    if(page->prev != SLAB_NONE) slab_pages[page->prev].next = page->next;
+    else c->partial = page->next;
+    if(page->next != SLAB_NONE) slab_pages[page->next].prev = page->prev;
+}
+
+static void slab_partial_link(slab_class_t * c, uint16_t page_id)
+{
+    slab_page_t * page = &slab_pages[page_id];
+    page->prev = SLAB_NONE;
+    page->next = c->partial;
+    if(c->partial != SLAB_NONE) slab_pages[c->partial].prev = page_id;
+    c->partial = page_id;
+}
+
+/**
+ * Allocate a block from the slab of the size class of `size`
+ * @param size the required size (<= SLAB_MAX_SIZE)
+ * @return pointer to the block or NULL if the slabs are full
+ */
+static void * slab_alloc(size_t size)
+{
+    uint32_t cls = (uint32_t)(size - 1) / SLAB_CLASS_STEP;
+    slab_class_t * c = &slab_classes[cls];
+
+    uint16_t page_id = c->partial;
+    if(page_id == SLAB_NONE) {
+        /*Take a new page for the class*/
+        page_id = slab_free_pages;
+        if(page_id == SLAB_NONE) {
+            c->fallback_cnt++;
+            return NULL;
+        }
+        slab_free_pages = slab_pages[page_id].next;
+
+        slab_page_t * page = &slab_pages[page_id];
+        page->free_head = SLAB_NONE;
+        page->bump = 0;
+        page->used_cnt = 0;
+        page->cls = cls;
+        slab_partial_link(c, page_id);
+        c->page_cnt++;
+    }
+
+    slab_page_t * page = &slab_pages[page_id];
+    uint32_t block_size = (cls + 1) * SLAB_CLASS_STEP;
+    uint8_t * page_mem = slab_mem + page_id * SLAB_PAGE_SIZE;
+    uint8_t * block;
+    if(page->free_head != SLAB_NONE) {
+        block = page_mem + page->free_head * block_size;
+        page->free_head = *(uint16_t *)block;
+    }
+    else {
+        block = page_mem + page->bump * block_size;
+        page->bump++;
+    }
+
+    page->used_cnt++;
+    if(page->used_cnt == c->block_per_page) slab_partial_unlink(c, page_id);
+
+    c->used_cnt++;
+    c->alloc_cnt++;
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(block, 0xaa, block_size);
+#endif
+    return block;
+}
+
+/**
+ * Give back a block to its slab. Free the page if all of its blocks are free.
+ * @param data pointer to a block allocated by `slab_alloc()`
+ * @return the size of the block
+ */
+static size_t slab_free(void * data)
+{
+    uint32_t ofs = (uint32_t)((uint8_t *)data - slab_mem);
+    uint16_t page_id = ofs / SLAB_PAGE_SIZE;
+    slab_page_t * page = &slab_pages[page_id];
+    slab_class_t * c = &slab_classes[page->cls];
+    uint32_t block_size = (page->cls + 1) * SLAB_CLASS_STEP;
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(data, 0xbb, block_size);
+#endif
+
+    if(page->used_cnt == c->block_per_page) slab_partial_link(c, page_id);
+
+    *(uint16_t *)data = page->free_head;
+    page->free_head = (ofs % SLAB_PAGE_SIZE) / block_size;
+    page->used_cnt--;
+    c->used_cnt--;
+
+    if(page->used_cnt == 0) {
+        slab_partial_unlink(c, page_id);
+        page->next = slab_free_pages;
+        slab_free_pages = page_id;
+        c->page_cnt--;
+    }
+
+    return block_size;
+}
+
+static inline bool slab_owns(const void * data)
+{
+    const uint8_t * d = data;
+    return slab_mem && d >= slab_mem && d < slab_mem + SLAB_PAGE_NUM * SLAB_PAGE_SIZE;
+}
+
+static inline size_t slab_get_size(const void * data)
+{
+    uint32_t page_id = (uint32_t)((const uint8_t *)data - slab_mem) / SLAB_PAGE_SIZE;
+    return (slab_pages[page_id].cls + 1) * SLAB_CLASS_STEP;
+}
+#endif /*_LV_MEM_SLAB*/
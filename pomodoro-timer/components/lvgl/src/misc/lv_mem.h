@@ -24,11 +24,31 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+#define _LV_MEM_SLAB 1
+#define _LV_MEM_SLAB_CLASS_NUM 8    /*Blocks of 16, 32, ... 128 bytes*/
+#else
+#define _LV_MEM_SLAB 0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if _LV_MEM_SLAB
+/**
+ * Information about a size class of the slabs.
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the blocks*/
+    uint32_t page_cnt;      /**< Number of pages used by the class*/
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t free_cnt;      /**< Number of free blocks in the pages of the class*/
+    uint32_t alloc_cnt;     /**< Number of allocations served since `lv_mem_init()`*/
+    uint32_t fallback_cnt;  /**< Number of allocations passed to the heap because the slabs were full*/
+} lv_mem_slab_monitor_t;
+#endif
+
 /**
  * Heap information structure.
  */
@@ -41,16 +61,32 @@ typedef struct {
     uint32_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
+#if _LV_MEM_SLAB
+    uint32_t slab_free_page_cnt;  /**< Number of slab pages not used by any size class*/
+    lv_mem_slab_monitor_t slab[_LV_MEM_SLAB_CLASS_NUM]; /**< Size classes of the slabs*/
+#endif
 } lv_mem_monitor_t;
 
 typedef struct {
     void * p;
-    uint16_t size;
+    uint32_t size;
+    uint32_t ofs;       /**< Offset in the arena (or where it would be if the arena were large enough)*/
     uint8_t used : 1;
+    uint8_t heap : 1;   /**< Allocated separately because it didn't fit into the arena*/
 } lv_mem_buf_t;
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+/**
+ * Information about the temporal buffers of `lv_mem_buf_get()`.
+ */
+typedef struct {
+    uint32_t arena_size;    /**< Size of the arena the buffers are allocated from*/
+    uint32_t high_water;    /**< The most arena memory the buffers have needed at the same time*/
+    uint32_t get_cnt;       /**< Number of `lv_mem_buf_get()` calls*/
+    uint32_t alloc_cnt;     /**< Number of `lv_mem_alloc()` calls because the arena was too small or had to grow*/
+} lv_mem_buf_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -101,6 +137,12 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Restart measuring `max_used` of `lv_mem_monitor()` from the current usage.
+ * Useful to get the peak memory usage of an operation.
+ */
+void lv_mem_monitor_reset_max(void);
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -119,6 +161,19 @@ void lv_mem_buf_release(void * p);
  */
 void lv_mem_buf_free_all(void);
 
+/**
+ * Called at the end of a refresh. If no buffers are in use grow the arena to the peak of the frame
+ * so that the next refresh can take all buffers from the arena.
+ * If `LV_MEM_BUF_SHRINK_FRAMES` frames in a row needed less, shrink it to the largest of their peaks.
+ */
+void _lv_mem_buf_frame_end(void);
+
+/**
+ * Give information about the temporal buffers
+ * @param mon_p pointer to a `lv_mem_buf_monitor_t` variable, the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
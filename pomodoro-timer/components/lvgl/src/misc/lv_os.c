@@ -0,0 +1,241 @@
+/**
+ * @file lv_os.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_os.h"
+#include "lv_log.h"
+
+#if LV_USE_OS != LV_OS_NONE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_thread_cb_t callback;
+    void * user_data;
+    lv_thread_sync_t copied;
+#if LV_USE_OS == LV_OS_FREERTOS
+    SemaphoreHandle_t done;
+#endif
+} thread_start_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_OS == LV_OS_PTHREAD
+    static void * thread_start(void * param);
+#elif LV_USE_OS == LV_OS_FREERTOS
+    static void thread_start(void * param);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data)
+{
+    LV_UNUSED(stack_size);
+
+    /*Wait until the new thread copies the parameters instead of allocating them. Freeing them from the new thread
+     *would change the heap at a random time.*/
+    thread_start_t start;
+    start.callback = callback;
+    start.user_data = user_data;
+    if(lv_thread_sync_init(&start.copied) != LV_RES_OK) return LV_RES_INV;
+
+    lv_res_t res = LV_RES_OK;
+    if(pthread_create(thread, NULL, thread_start, &start) != 0) {
+        LV_LOG_ERROR("pthread_create failed");
+        res = LV_RES_INV;
+    }
+    else {
+        lv_thread_sync_wait(&start.copied);
+    }
+
+    lv_thread_sync_delete(&start.copied);
+    return res;
+}
+
+void lv_thread_join(lv_thread_t * thread)
+{
+    pthread_join(*thread, NULL);
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_mutex_lock(lv_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+void lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+void lv_mutex_delete(lv_mutex_t * mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    sync->signaled = false;
+    if(pthread_mutex_init(&sync->mutex, NULL) != 0) return LV_RES_INV;
+    if(pthread_cond_init(&sync->cond, NULL) != 0) return LV_RES_INV;
+    return LV_RES_OK;
+}
+
+void lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    while(!sync->signaled) pthread_cond_wait(&sync->cond, &sync->mutex);
+    sync->signaled = false;
+    pthread_mutex_unlock(&sync->mutex);
+}
+
+void lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    sync->signaled = true;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->mutex);
+}
+
+void lv_thread_sync_delete(lv_thread_sync_t * sync)
+{
+    pthread_cond_destroy(&sync->cond);
+    pthread_mutex_destroy(&sync->mutex);
+}
+
+#elif LV_USE_OS == LV_OS_FREERTOS
+
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data)
+{
+    /*A task can't return so start it through `thread_start()` which signals `done` and deletes the task*/
+    thread->done = xSemaphoreCreateBinary();
+    if(thread->done == NULL) return LV_RES_INV;
+
+    thread_start_t start;
+    start.callback = callback;
+    start.user_data = user_data;
+    start.done = thread->done;
+    if(lv_thread_sync_init(&start.copied) != LV_RES_OK) {
+        vSemaphoreDelete(thread->done);
+        return LV_RES_INV;
+    }
+
+    /*Below the usual priority of the task running `lv_timer_handler()`*/
+    BaseType_t res = xTaskCreate(thread_start, "lvgl", (configSTACK_DEPTH_TYPE)(stack_size / sizeof(StackType_t)),
+                                 &start, tskIDLE_PRIORITY + 1, &thread->task);
+    if(res == pdPASS) lv_thread_sync_wait(&start.copied);
+    lv_thread_sync_delete(&start.copied);
+
+    if(res != pdPASS) {
+        LV_LOG_ERROR("xTaskCreate failed");
+        vSemaphoreDelete(thread->done);
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+
+void lv_thread_join(lv_thread_t * thread)
+{
+    xSemaphoreTake(thread->done, portMAX_DELAY);
+    vSemaphoreDelete(thread->done);
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_mutex_lock(lv_mutex_t * mutex)
+{
+    xSemaphoreTake(*mutex, portMAX_DELAY);
+}
+
+void lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    xSemaphoreGive(*mutex);
+}
+
+void lv_mutex_delete(lv_mutex_t * mutex)
+{
+    vSemaphoreDelete(*mutex);
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    *sync = xSemaphoreCreateBinary();
+    return *sync ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    xSemaphoreTake(*sync, portMAX_DELAY);
+}
+
+void lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    xSemaphoreGive(*sync);
+}
+
+void lv_thread_sync_delete(lv_thread_sync_t * sync)
+{
+    vSemaphoreDelete(*sync);
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+static void * thread_start(void * param)
+{
+    thread_start_t * start = param;
+    lv_thread_cb_t callback = start->callback;
+    void * user_data = start->user_data;
+    lv_thread_sync_signal(&start->copied);
+    callback(user_data);
+    return NULL;
+}
+#elif LV_USE_OS == LV_OS_FREERTOS
+static void thread_start(void * param)
+{
+    thread_start_t * start = param;
+    lv_thread_cb_t callback = start->callback;
+    void * user_data = start->user_data;
+    SemaphoreHandle_t done = start->done;
+    lv_thread_sync_signal(&start->copied);
+    callback(user_data);
+    xSemaphoreGive(done);
+    vTaskDelete(NULL);
+}
+#endif
+
+#endif /*LV_USE_OS != LV_OS_NONE*/
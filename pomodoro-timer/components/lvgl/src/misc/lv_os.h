@@ -0,0 +1,146 @@
+/**
+ * @file lv_os.h
+ * Minimal abstraction of the threads and locks of an operating system
+ */
+
+#ifndef LV_OS_H
+#define LV_OS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*`LV_OS_NONE`, `LV_OS_PTHREAD` and `LV_OS_FREERTOS` are defined in lv_conf_internal.h*/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+#include <pthread.h>
+#elif LV_USE_OS == LV_OS_FREERTOS
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+typedef pthread_t lv_thread_t;
+typedef pthread_mutex_t lv_mutex_t;
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool signaled;
+} lv_thread_sync_t;
+#elif LV_USE_OS == LV_OS_FREERTOS
+typedef struct {
+    TaskHandle_t task;
+    SemaphoreHandle_t done;     /*Given when the callback of the thread returned*/
+} lv_thread_t;
+typedef SemaphoreHandle_t lv_mutex_t;
+typedef SemaphoreHandle_t lv_thread_sync_t;
+#endif
+
+typedef void (*lv_thread_cb_t)(void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_USE_OS != LV_OS_NONE
+
+/**
+ * Create a new thread
+ * @param thread        pointer to a variable to store the thread's handle
+ * @param callback      the function to run in the thread
+ * @param stack_size    stack size in bytes (ignored with pthread)
+ * @param user_data     parameter of `callback`
+ * @return              LV_RES_OK: success; LV_RES_INV: the thread couldn't be created
+ */
+lv_res_t lv_thread_init(lv_thread_t * thread, lv_thread_cb_t callback, size_t stack_size, void * user_data);
+
+/**
+ * Wait until the callback of a thread returns and free the thread's resources
+ * @param thread    pointer to a thread created by `lv_thread_init()`
+ */
+void lv_thread_join(lv_thread_t * thread);
+
+/**
+ * Create a mutex
+ * @param mutex     pointer to a mutex variable to initialize
+ * @return          LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_mutex_init(lv_mutex_t * mutex);
+
+/**
+ * Lock a mutex. Wait until it's unlocked by the other thread if needed.
+ * @param mutex     pointer to a mutex
+ */
+void lv_mutex_lock(lv_mutex_t * mutex);
+
+/**
+ * Unlock a mutex
+ * @param mutex     pointer to a mutex
+ */
+void lv_mutex_unlock(lv_mutex_t * mutex);
+
+/**
+ * Delete a mutex created by `lv_mutex_init()`
+ * @param mutex     pointer to an unlocked mutex
+ */
+void lv_mutex_delete(lv_mutex_t * mutex);
+
+/**
+ * Create an object to make a thread wait until an other one signals it
+ * @param sync      pointer to a sync variable to initialize
+ * @return          LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync);
+
+/**
+ * Wait until an other thread calls `lv_thread_sync_signal()`. Return immediately if it was signaled already.
+ * @param sync      pointer to a sync variable
+ */
+void lv_thread_sync_wait(lv_thread_sync_t * sync);
+
+/**
+ * Wake up the thread waiting in `lv_thread_sync_wait()`
+ * @param sync      pointer to a sync variable
+ */
+void lv_thread_sync_signal(lv_thread_sync_t * sync);
+
+/**
+ * Delete a sync variable created by `lv_thread_sync_init()`
+ * @param sync      pointer to a sync variable no thread waits for
+ */
+void lv_thread_sync_delete(lv_thread_sync_t * sync);
+
+#endif /*LV_USE_OS != LV_OS_NONE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OS_H*/
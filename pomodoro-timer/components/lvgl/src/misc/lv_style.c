@@ -95,6 +95,8 @@ const uint8_t _lv_style_builtin_prop_flag_lookup_table[_LV_STYLE_NUM_BUILT_IN_PR
     [LV_STYLE_IMG_OPA] = 0,
     [LV_STYLE_IMG_RECOLOR] = 0,
     [LV_STYLE_IMG_RECOLOR_OPA] = 0,
+    [LV_STYLE_IMG_PLACEHOLDER_COLOR] = 0,
+    [LV_STYLE_IMG_PLACEHOLDER_OPA] = 0,
 
     [LV_STYLE_LINE_WIDTH] =                LV_STYLE_PROP_EXT_DRAW,
     [LV_STYLE_LINE_DASH_WIDTH] = 0,
@@ -138,6 +140,7 @@ uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
 static uint16_t last_custom_prop_id = (uint16_t)_LV_STYLE_LAST_BUILT_IN_PROP;
 static const lv_style_value_t null_style_value = { .num = 0 };
+static void (*change_cb)(const lv_style_t * style);
 
 /**********************
  *      MACROS
@@ -159,6 +162,7 @@ void lv_style_init(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    if(change_cb) change_cb(style);
 }
 
 void lv_style_reset(lv_style_t * style)
@@ -175,6 +179,7 @@ void lv_style_reset(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    if(change_cb) change_cb(style);
 }
 
 lv_style_prop_t lv_style_register_prop(uint8_t flag)
@@ -229,6 +234,8 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    if(change_cb) change_cb(style);
+
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
@@ -376,6 +383,11 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop)
     return (uint8_t)group;
 }
 
+void _lv_style_set_change_cb(void (*cb)(const lv_style_t * style))
+{
+    change_cb = cb;
+}
+
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop)
 {
     extern const uint8_t _lv_style_builtin_prop_flag_lookup_table[];
@@ -420,6 +432,8 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    if(change_cb) change_cb(style);
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
@@ -243,6 +243,7 @@ typedef enum {
     LV_STYLE_LINE_ROUNDED           = 76,
     LV_STYLE_LINE_COLOR             = 77,
     LV_STYLE_LINE_OPA               = 78,
+    LV_STYLE_IMG_PLACEHOLDER_COLOR  = 79,
 
     /*Group 5*/
     LV_STYLE_ARC_WIDTH              = 80,
@@ -257,6 +258,7 @@ typedef enum {
     LV_STYLE_TEXT_LINE_SPACE        = 89,
     LV_STYLE_TEXT_DECOR             = 90,
     LV_STYLE_TEXT_ALIGN             = 91,
+    LV_STYLE_IMG_PLACEHOLDER_OPA    = 92,
 
     /*Group 6*/
     LV_STYLE_OPA                    = 96,
@@ -518,6 +520,13 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
  */
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop);
 
+/**
+ * Set a function to call whenever a style is initialized or reset or a property is set or removed in it.
+ * Used to drop the cached style properties of the objects which use the style.
+ * @param cb the function to call with the changed style or NULL to not call anything
+ */
+void _lv_style_set_change_cb(void (*cb)(const lv_style_t * style));
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_size(lv_style_t * style, lv_coord_t value)
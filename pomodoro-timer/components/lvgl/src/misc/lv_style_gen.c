@@ -432,6 +432,22 @@ void lv_style_set_img_recolor_opa(lv_style_t * style, lv_opa_t value)
     lv_style_set_prop(style, LV_STYLE_IMG_RECOLOR_OPA, v);
 }
 
+void lv_style_set_img_placeholder_color(lv_style_t * style, lv_color_t value)
+{
+    lv_style_value_t v = {
+        .color = value
+    };
+    lv_style_set_prop(style, LV_STYLE_IMG_PLACEHOLDER_COLOR, v);
+}
+
+void lv_style_set_img_placeholder_opa(lv_style_t * style, lv_opa_t value)
+{
+    lv_style_value_t v = {
+        .num = (int32_t)value
+    };
+    lv_style_set_prop(style, LV_STYLE_IMG_PLACEHOLDER_OPA, v);
+}
+
 void lv_style_set_line_width(lv_style_t * style, lv_coord_t value)
 {
     lv_style_value_t v = {
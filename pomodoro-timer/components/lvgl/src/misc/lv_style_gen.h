@@ -52,6 +52,8 @@ void lv_style_set_shadow_opa(lv_style_t * style, lv_opa_t value);
 void lv_style_set_img_opa(lv_style_t * style, lv_opa_t value);
 void lv_style_set_img_recolor(lv_style_t * style, lv_color_t value);
 void lv_style_set_img_recolor_opa(lv_style_t * style, lv_opa_t value);
+void lv_style_set_img_placeholder_color(lv_style_t * style, lv_color_t value);
+void lv_style_set_img_placeholder_opa(lv_style_t * style, lv_opa_t value);
 void lv_style_set_line_width(lv_style_t * style, lv_coord_t value);
 void lv_style_set_line_dash_width(lv_style_t * style, lv_coord_t value);
 void lv_style_set_line_dash_gap(lv_style_t * style, lv_coord_t value);
@@ -353,6 +355,16 @@ void lv_style_set_base_dir(lv_style_t * style, lv_base_dir_t value);
         .prop = LV_STYLE_IMG_RECOLOR_OPA, .value = { .num = (int32_t)val } \
     }
 
+#define LV_STYLE_CONST_IMG_PLACEHOLDER_COLOR(val) \
+    { \
+        .prop = LV_STYLE_IMG_PLACEHOLDER_COLOR, .value = { .color = val } \
+    }
+
+#define LV_STYLE_CONST_IMG_PLACEHOLDER_OPA(val) \
+    { \
+        .prop = LV_STYLE_IMG_PLACEHOLDER_OPA, .value = { .num = (int32_t)val } \
+    }
+
 #define LV_STYLE_CONST_LINE_WIDTH(val) \
     { \
         .prop = LV_STYLE_LINE_WIDTH, .value = { .num = (int32_t)val } \
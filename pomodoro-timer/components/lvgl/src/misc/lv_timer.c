@@ -17,16 +17,34 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_DEF_CAP 8
+#define NOT_IN_HEAP 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*An element of the binary min-heap which orders the timers by their deadline*/
+typedef struct {
+    uint64_t deadline;  /*The 64 bit tick when the timer needs to run*/
+    lv_timer_t * timer;
+    uint32_t round;     /*The handler round in which the timer has run last*/
+} timer_heap_entry_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint64_t tick_get64(void);
+static uint64_t timer_deadline(lv_timer_t * timer);
+static bool heap_reserve(uint32_t cnt);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_set_deadline(lv_timer_t * timer, uint64_t deadline);
+static void heap_sift_up(uint32_t idx);
+static void heap_sift_down(uint32_t idx);
+static void wakeup_if_needed(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -34,7 +52,16 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
 static bool timer_deleted;
-static bool timer_created;
+static bool handler_running;
+static uint32_t timer_cnt;
+static uint32_t heap_cnt;
+static uint32_t heap_cap;
+static uint32_t handler_round;
+static uint64_t tick64;
+static uint32_t tick_last;
+static uint64_t sleep_deadline;
+static lv_timer_wakeup_cb_t wakeup_cb;
+static void * wakeup_user_data;
 
 /**********************
  *      MACROS
@@ -45,6 +72,8 @@ static bool timer_created;
     #define TIMER_TRACE(...)
 #endif
 
+#define HEAP ((timer_heap_entry_t *)LV_GC_ROOT(_lv_timer_heap))
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -55,11 +84,32 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_cnt = 0;
+    heap_cnt = 0;
+    heap_cap = 0;
+    handler_round = 0;
+
+    /*Start from a high value so that ticks in the past can be expressed too*/
+    tick64 = (uint64_t)1 << 32;
+    tick_last = lv_tick_get();
+    sleep_deadline = UINT64_MAX;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
 }
 
+/**
+ * Free the heap of the timers. Called by `lv_deinit()`.
+ */
+void _lv_timer_core_deinit(void)
+{
+    lv_mem_free(LV_GC_ROOT(_lv_timer_heap));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    heap_cnt = 0;
+    heap_cap = 0;
+}
+
 /**
  * Call it periodically to handle lv_timers.
  * @return the time after which it must be called again
@@ -69,15 +119,14 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
     TIMER_TRACE("begin");
 
     /*Avoid concurrent running of the timer handler*/
-    static bool already_running = false;
-    if(already_running) {
+    if(handler_running) {
         TIMER_TRACE("already running, concurrent calls are not allow, returning");
         return 1;
     }
-    already_running = true;
+    handler_running = true;
 
     if(lv_timer_run == false) {
-        already_running = false; /*Release mutex*/
+        handler_running = false; /*Release mutex*/
         return 1;
     }
 
@@ -95,40 +144,29 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
+    /*Run the due timers in the order of their deadlines. The timers which have already run in this round
+     *(e.g. with 0 period) are sorted after the others with the same deadline and are not run again.*/
+    handler_round++;
+    if(handler_round == 0) handler_round = 1;   /*0 is for the timers which have not run yet*/
+    uint64_t now = tick_get64();
+    while(heap_cnt > 0) {
+        timer_heap_entry_t * top = &HEAP[0];
+        if(top->deadline > now || top->round == handler_round) break;
+
+        lv_timer_t * timer = top->timer;
+        if(timer->repeat_count != 0 && lv_timer_time_remaining(timer) != 0) {
+            /*Not ready yet, e.g. the tick has wrapped around. Fix its position.*/
+            heap_set_deadline(timer, timer_deadline(timer));
+            continue;
         }
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        lv_timer_exec(timer);
     }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+
+    uint32_t time_till_next = lv_timer_get_time_till_next();
+    sleep_deadline = time_till_next == LV_NO_TIMER_READY ? UINT64_MAX : tick64 + time_till_next;
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -139,7 +177,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         idle_period_start = lv_tick_get();
     }
 
-    already_running = false; /*Release the mutex*/
+    handler_running = false; /*Release the mutex*/
 
     TIMER_TRACE("finished (%d ms until the next timer call)", time_till_next);
     return time_till_next;
@@ -168,6 +206,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve a place in the heap for every timer so pausing and resuming never need to allocate*/
+    if(!heap_reserve(timer_cnt + 1)) return NULL;
+
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +219,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_idx = NOT_IN_HEAP;
 
-    timer_created = true;
+    timer_cnt++;
+    heap_insert(new_timer);
+    wakeup_if_needed();
 
     return new_timer;
 }
@@ -200,8 +244,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    timer_cnt--;
+    if(timer == LV_GC_ROOT(_lv_timer_act)) timer_deleted = true;
 
     lv_mem_free(timer);
 }
@@ -213,11 +259,14 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     timer->paused = false;
+    if(timer->heap_idx == NOT_IN_HEAP) heap_insert(timer);
+    wakeup_if_needed();
 }
 
 /**
@@ -228,6 +277,8 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_set_deadline(timer, timer_deadline(timer));
+    wakeup_if_needed();
 }
 
 /**
@@ -237,6 +288,8 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_set_deadline(timer, timer_deadline(timer));
+    wakeup_if_needed();
 }
 
 /**
@@ -247,6 +300,12 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+
+    /*Let the handler delete a stopped timer right away*/
+    if(repeat_count == 0) {
+        heap_set_deadline(timer, 0);
+        wakeup_if_needed();
+    }
 }
 
 /**
@@ -257,6 +316,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_set_deadline(timer, timer_deadline(timer));
 }
 
 /**
@@ -266,6 +326,7 @@ void lv_timer_reset(lv_timer_t * timer)
 void lv_timer_enable(bool en)
 {
     lv_timer_run = en;
+    if(en) wakeup_if_needed();
 }
 
 /**
@@ -277,6 +338,32 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time remaining until the first timer needs to run, without running any timers.
+ * @return time till `lv_timer_handler()` needs to be called (in ms) or `LV_NO_TIMER_READY` if there is no timer
+ */
+uint32_t lv_timer_get_time_till_next(void)
+{
+    if(heap_cnt == 0) return LV_NO_TIMER_READY;
+
+    uint64_t now = tick_get64();
+    uint64_t deadline = HEAP[0].deadline;
+    if(deadline <= now) return 0;
+    if(deadline - now >= LV_NO_TIMER_READY) return LV_NO_TIMER_READY - 1;
+    return (uint32_t)(deadline - now);
+}
+
+/**
+ * Set a callback to wake up a task which sleeps for the time returned by `lv_timer_handler()`.
+ * @param wakeup_cb the callback or NULL to disable
+ * @param user_data custom parameter passed to `wakeup_cb`
+ */
+void lv_timer_set_wakeup_cb(lv_timer_wakeup_cb_t cb, void * user_data)
+{
+    wakeup_cb = cb;
+    wakeup_user_data = user_data;
+}
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -293,28 +380,27 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a timer which is ready and schedule its next run
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below
+     * but at least the repeat count is zero and the timer can be deleted in the next round*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+
+    /*Schedule the next run before the callback as it might modify the timer*/
+    HEAP[timer->heap_idx].round = handler_round;
+    heap_set_deadline(timer, timer_deadline(timer));
+
+    timer_deleted = false;
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
 
     if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
@@ -322,8 +408,6 @@ static bool lv_timer_exec(lv_timer_t * timer)
             lv_timer_del(timer);
         }
     }
-
-    return exec;
 }
 
 /**
@@ -339,3 +423,132 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Get the tick extended to 64 bit so that the deadlines in the heap never wrap around.
+ * @return the current tick
+ */
+static uint64_t tick_get64(void)
+{
+    uint32_t t = lv_tick_get();
+    tick64 += (uint32_t)(t - tick_last);
+    tick_last = t;
+    return tick64;
+}
+
+/**
+ * Get the 64 bit tick when a timer needs to run next.
+ * @param timer pointer to lv_timer
+ * @return the deadline of the timer
+ */
+static uint64_t timer_deadline(lv_timer_t * timer)
+{
+    return tick_get64() - lv_tick_elaps(timer->last_run) + timer->period;
+}
+
+/**
+ * Make sure the heap can store a given number of timers.
+ * @param cnt number of timers
+ * @return true: success; false: out of memory
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= heap_cap) return true;
+
+    uint32_t new_cap = heap_cap == 0 ? HEAP_DEF_CAP : heap_cap * 2;
+    timer_heap_entry_t * new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_cap * sizeof(timer_heap_entry_t));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = new_heap;
+    heap_cap = new_cap;
+    return true;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    uint32_t idx = heap_cnt;
+    heap_cnt++;
+    HEAP[idx].timer = timer;
+    HEAP[idx].deadline = timer_deadline(timer);
+    HEAP[idx].round = 0;
+    timer->heap_idx = idx;
+    heap_sift_up(idx);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == NOT_IN_HEAP) return;
+
+    timer->heap_idx = NOT_IN_HEAP;
+    heap_cnt--;
+    if(idx == heap_cnt) return;
+
+    /*Fill the gap with the last element and move it to its place*/
+    lv_timer_t * moved = HEAP[heap_cnt].timer;
+    HEAP[idx] = HEAP[heap_cnt];
+    moved->heap_idx = idx;
+    heap_sift_up(idx);
+    heap_sift_down(moved->heap_idx);
+}
+
+static void heap_set_deadline(lv_timer_t * timer, uint64_t deadline)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == NOT_IN_HEAP) return;
+
+    HEAP[idx].deadline = deadline;
+    heap_sift_up(idx);
+    heap_sift_down(timer->heap_idx);
+}
+
+static inline bool heap_less(const timer_heap_entry_t * a, const timer_heap_entry_t * b)
+{
+    if(a->deadline != b->deadline) return a->deadline < b->deadline;
+    return a->round < b->round;
+}
+
+static void heap_sift_up(uint32_t idx)
+{
+    timer_heap_entry_t * heap = HEAP;
+    timer_heap_entry_t e = heap[idx];
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!heap_less(&e, &heap[parent])) break;
+        heap[idx] = heap[parent];
+        heap[idx].timer->heap_idx = idx;
+        idx = parent;
+    }
+    heap[idx] = e;
+    e.timer->heap_idx = idx;
+}
+
+static void heap_sift_down(uint32_t idx)
+{
+    timer_heap_entry_t * heap = HEAP;
+    timer_heap_entry_t e = heap[idx];
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && heap_less(&heap[child + 1], &heap[child])) child++;
+        if(!heap_less(&heap[child], &e)) break;
+        heap[idx] = heap[child];
+        heap[idx].timer->heap_idx = idx;
+        idx = child;
+    }
+    heap[idx] = e;
+    e.timer->heap_idx = idx;
+}
+
+/**
+ * Call the wakeup callback if a timer needs to run before the time returned by the last `lv_timer_handler()`
+ */
+static void wakeup_if_needed(void)
+{
+    if(wakeup_cb == NULL || handler_running || heap_cnt == 0) return;
+    if(HEAP[0].deadline >= sleep_deadline) return;
+
+    sleep_deadline = HEAP[0].deadline;  /*Notify only once*/
+    wakeup_cb(wakeup_user_data);
+}
@@ -48,8 +48,14 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+    uint32_t heap_idx; /**< Position in the deadline heap (internal)*/
 } lv_timer_t;
 
+/**
+ * Called when a timer becomes due earlier than the time `lv_timer_handler()` has last returned.
+ */
+typedef void (*lv_timer_wakeup_cb_t)(void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +65,11 @@ typedef struct _lv_timer_t {
  */
 void _lv_timer_core_init(void);
 
+/**
+ * Free the heap of the timers. Called by `lv_deinit()`.
+ */
+void _lv_timer_core_deinit(void);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -165,6 +176,21 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time remaining until the first timer needs to run, without running any timers.
+ * @return time till `lv_timer_handler()` needs to be called (in ms) or `LV_NO_TIMER_READY` if there is no timer
+ */
+uint32_t lv_timer_get_time_till_next(void);
+
+/**
+ * Set a callback to wake up a task which sleeps for the time returned by `lv_timer_handler()`.
+ * It's called when a timer is created, resumed, made ready, etc. and needs to run before that time elapses.
+ * E.g. call `xTaskNotifyGive()` or `pthread_cond_signal()` from it.
+ * @param wakeup_cb the callback or NULL to disable
+ * @param user_data custom parameter passed to `wakeup_cb`
+ */
+void lv_timer_set_wakeup_cb(lv_timer_wakeup_cb_t wakeup_cb, void * user_data);
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
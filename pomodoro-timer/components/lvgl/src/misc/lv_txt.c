@@ -136,6 +136,108 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
         size_res->y -= line_space;
 }
 
+bool _lv_txt_lines_update(lv_txt_lines_t * lines, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t max_width, lv_text_flag_t flag)
+{
+    if(text == NULL || font == NULL) return false;
+    if(_lv_txt_lines_match(lines, font, letter_space, max_width, flag)) return true;
+
+    lines->valid = 0;
+    lines->line_cnt = 0;
+
+    uint32_t line_start = 0;
+    while(text[line_start] != '\0') {
+        if(lines->line_cnt == lines->line_cap) {
+            if(lines->line_cap == 0) {
+                /*Most texts have only one line, store it without allocation*/
+                lines->lines = &lines->line1;
+                lines->line_cap = 1;
+            }
+            else if(lines->lines == &lines->line1) {
+                lv_txt_line_t * new_lines = lv_mem_alloc(4 * sizeof(lv_txt_line_t));
+                if(new_lines == NULL) return false;
+                new_lines[0] = lines->line1;
+                lines->lines = new_lines;
+                lines->line_cap = 4;
+            }
+            else {
+                uint32_t new_cap = lines->line_cap * 2;
+                lv_txt_line_t * new_lines = lv_mem_realloc(lines->lines, new_cap * sizeof(lv_txt_line_t));
+                if(new_lines == NULL) return false;
+                lines->lines = new_lines;
+                lines->line_cap = new_cap;
+            }
+        }
+
+        lv_txt_line_t * line = &lines->lines[lines->line_cnt];
+        line->end = line_start + _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+        line->w = lv_txt_get_width(&text[line_start], line->end - line_start, font, letter_space, flag);
+        lines->line_cnt++;
+        line_start = line->end;
+    }
+
+    lines->font = font;
+    lines->letter_space = letter_space;
+    lines->max_width = max_width;
+    lines->flag = flag;
+    lines->valid = 1;
+    return true;
+}
+
+bool _lv_txt_lines_match(const lv_txt_lines_t * lines, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t max_width, lv_text_flag_t flag)
+{
+    if(!lines->valid) return false;
+    if(lines->font != font || lines->letter_space != letter_space) return false;
+
+    /*The max. width doesn't matter if only the new line characters break the lines*/
+    lv_text_flag_t no_wrap = LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT;
+    if((lines->flag & LV_TEXT_FLAG_RECOLOR) != (flag & LV_TEXT_FLAG_RECOLOR)) return false;
+    if((lines->flag & no_wrap) && (flag & no_wrap)) return true;
+    return lines->flag == flag && lines->max_width == max_width;
+}
+
+void _lv_txt_lines_get_size(const lv_txt_lines_t * lines, const char * text, lv_coord_t line_space,
+                            lv_point_t * size_res)
+{
+    lv_coord_t letter_height = lv_font_get_line_height(lines->font);
+    uint32_t line_cnt = lines->line_cnt;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(line_cnt != 0) {
+        uint32_t last = lines->lines[line_cnt - 1].end - 1;
+        if(text[last] == '\n' || text[last] == '\r') line_cnt++;
+    }
+
+    int64_t h = (int64_t)line_cnt * (letter_height + line_space);
+    if(h > (int64_t)LV_MAX_OF(lv_coord_t)) {
+        /*Let `lv_txt_get_size` handle the overflow*/
+        lv_txt_get_size(size_res, text, lines->font, lines->letter_space, line_space, lines->max_width, lines->flag);
+        return;
+    }
+
+    size_res->x = 0;
+    uint32_t i;
+    for(i = 0; i < lines->line_cnt; i++) {
+        size_res->x = LV_MAX(lines->lines[i].w, size_res->x);
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(h == 0) size_res->y = letter_height;
+    else size_res->y = (lv_coord_t)h - line_space;
+}
+
+void _lv_txt_lines_invalidate(lv_txt_lines_t * lines)
+{
+    lines->valid = 0;
+}
+
+void _lv_txt_lines_free(lv_txt_lines_t * lines)
+{
+    if(lines->lines != &lines->line1) lv_mem_free(lines->lines);
+    lv_memset_00(lines, sizeof(lv_txt_lines_t));
+}
+
 /**
  * Get the next word of text. A word is delimited by break characters.
  *
@@ -65,6 +65,26 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/** A line of a text broken into lines*/
+typedef struct {
+    uint32_t end;       /**< Byte index after the last character of the line (start of the next line)*/
+    lv_coord_t w;       /**< Width of the line*/
+} lv_txt_line_t;
+
+/** The line breaks of a text calculated once by `_lv_txt_lines_update()` to not break the text
+ * into lines again on every size query and redraw*/
+typedef struct _lv_txt_lines_t {
+    lv_txt_line_t * lines;      /**< Points to `line1` while there is only one line*/
+    lv_txt_line_t line1;
+    uint32_t line_cnt;
+    uint32_t line_cap;          /**< Number of allocated lines*/
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+    uint8_t valid : 1;
+} lv_txt_lines_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -83,6 +103,54 @@ typedef uint8_t lv_text_align_t;
 void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                      lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
 
+/**
+ * Break a text into lines and save the line ends and widths if the lines are not valid for the given parameters.
+ * @param lines pointer to an `lv_txt_lines_t` variable, initialized to zero
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid
+ * line breaks
+ * @param flag settings for the text from ::lv_text_flag_t
+ * @return true: `lines` are valid; false: out of memory
+ */
+bool _lv_txt_lines_update(lv_txt_lines_t * lines, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Tell whether the lines were calculated with the given parameters.
+ * @param lines pointer to the lines
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text
+ * @param flag settings for the text from ::lv_text_flag_t
+ * @return true: the lines can be used
+ */
+bool _lv_txt_lines_match(const lv_txt_lines_t * lines, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of a text from its lines. Gives the same result as `lv_txt_get_size()`.
+ * @param lines pointer to valid lines of `text`
+ * @param text pointer to the text
+ * @param line_space line space of the text
+ * @param size_res pointer to a 'point_t' variable to store the result
+ */
+void _lv_txt_lines_get_size(const lv_txt_lines_t * lines, const char * text, lv_coord_t line_space,
+                            lv_point_t * size_res);
+
+/**
+ * Mark the lines invalid, e.g. because the text has changed. The allocated memory is kept.
+ * @param lines pointer to the lines
+ */
+void _lv_txt_lines_invalidate(lv_txt_lines_t * lines);
+
+/**
+ * Free the memory allocated for the lines.
+ * @param lines pointer to the lines
+ */
+void _lv_txt_lines_free(lv_txt_lines_t * lines);
+
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
@@ -93,8 +93,7 @@ void lv_arc_set_start_angle(lv_obj_t * obj, uint16_t start)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, arc->indic_angle_start, start, LV_PART_INDICATOR);
+    if(new_delta < old_delta) inv_arc_area(obj, arc->indic_angle_start, start, LV_PART_INDICATOR);
     else if(old_delta < new_delta) inv_arc_area(obj, start, arc->indic_angle_start, LV_PART_INDICATOR);
 
     inv_knob_area(obj);
@@ -116,8 +115,7 @@ void lv_arc_set_end_angle(lv_obj_t * obj, uint16_t end)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, end, arc->indic_angle_end, LV_PART_INDICATOR);
+    if(new_delta < old_delta) inv_arc_area(obj, end, arc->indic_angle_end, LV_PART_INDICATOR);
     else if(old_delta < new_delta) inv_arc_area(obj, arc->indic_angle_end, end, LV_PART_INDICATOR);
 
     inv_knob_area(obj);
@@ -146,8 +144,7 @@ void lv_arc_set_bg_start_angle(lv_obj_t * obj, uint16_t start)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, arc->bg_angle_start, start, LV_PART_MAIN);
+    if(new_delta < old_delta) inv_arc_area(obj, arc->bg_angle_start, start, LV_PART_MAIN);
     else if(old_delta < new_delta) inv_arc_area(obj, start, arc->bg_angle_start, LV_PART_MAIN);
 
     arc->bg_angle_start = start;
@@ -168,8 +165,7 @@ void lv_arc_set_bg_end_angle(lv_obj_t * obj, uint16_t end)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, end, arc->bg_angle_end, LV_PART_MAIN);
+    if(new_delta < old_delta) inv_arc_area(obj, end, arc->bg_angle_end, LV_PART_MAIN);
     else if(old_delta < new_delta) inv_arc_area(obj, arc->bg_angle_end, end, LV_PART_MAIN);
 
     arc->bg_angle_end = end;
@@ -705,23 +701,44 @@ static void inv_arc_area(lv_obj_t * obj, uint16_t start_angle, uint16_t end_angl
     if(start_angle > 360) start_angle -= 360;
     if(end_angle > 360) end_angle -= 360;
 
-    start_angle += arc->rotation;
-    end_angle += arc->rotation;
+    int32_t span = end_angle - start_angle;
+    if(span <= 0) span += 360;
 
-    if(start_angle > 360) start_angle -= 360;
-    if(end_angle > 360) end_angle -= 360;
+    int32_t angle = (start_angle + arc->rotation) % 360;
 
     lv_coord_t r;
     lv_point_t c;
     get_center(obj, &c, &r);
 
+    /*The indicator is drawn with a smaller radius if it has padding*/
+    if(part == LV_PART_INDICATOR) {
+        lv_coord_t left = lv_obj_get_style_pad_left(obj, LV_PART_INDICATOR);
+        lv_coord_t right = lv_obj_get_style_pad_right(obj, LV_PART_INDICATOR);
+        lv_coord_t top = lv_obj_get_style_pad_top(obj, LV_PART_INDICATOR);
+        lv_coord_t bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_INDICATOR);
+        r -= LV_MAX4(left, right, top, bottom);
+    }
+    if(r <= 0) return;
+
     lv_coord_t w = lv_obj_get_style_arc_width(obj, part);
+    if(w > r) w = r;
     lv_coord_t rounded = lv_obj_get_style_arc_rounded(obj, part);
 
-    lv_area_t inv_area;
-    lv_draw_arc_get_area(c.x, c.y, r, start_angle, end_angle, w, rounded, &inv_area);
+    /*Invalidate the changed sector quarter by quarter. The bounding box of a sector crossing
+     *an axis would contain the center and the inside of the ring too.
+     *The areas contain the rounded ends as they are increased by the half of the width.*/
+    while(span > 0) {
+        int32_t seg = 90 - angle % 90;
+        if(seg > span) seg = span;
+
+        lv_area_t inv_area;
+        lv_draw_arc_get_area(c.x, c.y, r, angle, angle + seg, w, rounded, &inv_area);
+        lv_obj_invalidate_area(obj, &inv_area);
 
-    lv_obj_invalidate_area(obj, &inv_area);
+        angle += seg;
+        if(angle >= 360) angle -= 360;
+        span -= seg;
+    }
 }
 
 static void inv_knob_area(lv_obj_t * obj)
@@ -42,6 +42,9 @@ static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void get_txt_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+static void invalidate_lines(lv_obj_t * obj);
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
@@ -729,6 +732,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_lines_free(&label->lines);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -773,10 +780,14 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
 
         lv_coord_t w = lv_obj_get_content_width(obj);
-        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
+        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) {
+            /*Only the new line characters break the lines*/
+            w = LV_COORD_MAX;
+            flag |= LV_TEXT_FLAG_FIT;
+        }
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_txt_size(obj, &size, font, letter_space, line_space, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -824,8 +835,8 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -844,6 +855,13 @@ static void draw_main(lv_event_t * e)
     bool is_common = _lv_area_intersect(&txt_clip, &txt_coords, draw_ctx->clip_area);
     if(!is_common) return;
 
+#if LV_LABEL_LINE_CACHE
+    if(_lv_txt_lines_update(&label->lines, label->text, label_draw_dsc.font, label_draw_dsc.letter_space,
+                            lv_area_get_width(&txt_coords), flag)) {
+        label_draw_dsc.lines = &label->lines;
+    }
+#endif
+
     if(label->long_mode == LV_LABEL_LONG_WRAP) {
         lv_coord_t s = lv_obj_get_scroll_top(obj);
         lv_area_move(&txt_coords, 0, -s);
@@ -864,8 +882,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -899,6 +917,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+    invalidate_lines(obj);
 
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
@@ -914,7 +933,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    get_txt_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1158,6 +1177,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+                invalidate_lines(obj);
             }
         }
     }
@@ -1190,6 +1210,44 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
+    invalidate_lines(obj);
+}
+
+/**
+ * Get the size of the label's text. Use and update the cached lines if enabled.
+ * @param obj           pointer to a label object
+ * @param size          store the result here
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param line_space    line space of the text
+ * @param max_w         max width of the text
+ * @param flag          settings for the text from ::lv_text_flag_t
+ */
+static void get_txt_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    if(_lv_txt_lines_update(&label->lines, label->text, font, letter_space, max_w, flag)) {
+        _lv_txt_lines_get_size(&label->lines, label->text, line_space, size);
+        return;
+    }
+#endif
+    lv_txt_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+/**
+ * Mark the cached lines invalid. Needs to be called if the text has changed.
+ * @param obj           pointer to a label object
+ */
+static void invalidate_lines(lv_obj_t * obj)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    _lv_txt_lines_invalidate(&label->lines);
+#else
+    LV_UNUSED(obj);
+#endif
 }
 
 /**
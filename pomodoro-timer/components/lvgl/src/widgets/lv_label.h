@@ -68,6 +68,10 @@ typedef struct {
     uint32_t sel_end;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_txt_lines_t lines;   /*Line breaks of the text to not calculate them on every size query and redraw*/
+#endif
+
     lv_point_t offset; /*Text draw position offset*/
     lv_label_long_mode_t long_mode : 3; /*Determine what to do with the long texts*/
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
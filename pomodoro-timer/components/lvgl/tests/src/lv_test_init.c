@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../unity/unity.h"
+#include "../../src/draw/sw/lv_draw_sw.h"
 
 #define HOR_RES 800
 #define VER_RES 480
@@ -43,6 +44,10 @@ static void hal_init(void)
     disp_drv.flush_cb = dummy_flush_cb;
     disp_drv.hor_res = HOR_RES;
     disp_drv.ver_res = VER_RES;
+    /*Draw with the CPU even if a GPU is enabled to build its code. Its tests set up its draw context.*/
+    disp_drv.draw_ctx_init = lv_draw_sw_init_ctx;
+    disp_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    disp_drv.draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
     lv_disp_drv_register(&disp_drv);
 
     static lv_indev_drv_t indev_mouse_drv;
@@ -0,0 +1,242 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define MANY_ANIMS      2000
+
+static int32_t vars[MANY_ANIMS];
+static uint32_t ready_cnt;
+static uint32_t deleted_cnt;
+
+static const lv_anim_path_cb_t paths[] = {
+    lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out, lv_anim_path_ease_in_out,
+    lv_anim_path_overshoot, lv_anim_path_bounce, lv_anim_path_step,
+};
+
+#define PATH_NUM    (sizeof(paths) / sizeof(paths[0]))
+
+static void set_int(void * var, int32_t v)
+{
+    *(int32_t *)var = v;
+}
+
+/*Not known by the animation engine so it's called for each animation*/
+static int32_t custom_ease_in_out(const lv_anim_t * a)
+{
+    return lv_anim_path_ease_in_out(a);
+}
+
+static void deleted_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    deleted_cnt++;
+}
+
+static void start_int_anim(int32_t * var, lv_anim_path_cb_t path, uint32_t time)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, set_int);
+    lv_anim_set_values(&a, -100, 1000);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_path_cb(&a, path);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_start(&a);
+}
+
+/*Move the time forward and run the animations*/
+static void step(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    lv_anim_refr_now();
+}
+
+void setUp(void)
+{
+    ready_cnt = 0;
+    deleted_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_anim_del_all();
+}
+
+void test_anim_values_match_the_paths(void)
+{
+    uint32_t i;
+    for(i = 0; i < PATH_NUM; i++) start_int_anim(&vars[i], paths[i], 1000);
+    TEST_ASSERT_EQUAL(PATH_NUM, lv_anim_count_running());
+
+    int32_t t;
+    for(t = 37; t < 1000; t += 37) {
+        step(37);
+        for(i = 0; i < PATH_NUM; i++) {
+            lv_anim_t ref;
+            lv_anim_init(&ref);
+            lv_anim_set_values(&ref, -100, 1000);
+            lv_anim_set_time(&ref, 1000);
+            ref.act_time = t;
+            TEST_ASSERT_EQUAL(paths[i](&ref), vars[i]);
+        }
+    }
+
+    /*All of them end at the end value and get deleted*/
+    step(100);
+    for(i = 0; i < PATH_NUM; i++) TEST_ASSERT_EQUAL(1000, vars[i]);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(PATH_NUM, deleted_cnt);
+}
+
+static void restart_ready_cb(lv_anim_t * a)
+{
+    ready_cnt++;
+
+    /*The handles of the other animations stay valid*/
+    lv_anim_t * other = lv_anim_get(&vars[1], set_int);
+    TEST_ASSERT_NOT_NULL(other);
+    TEST_ASSERT_EQUAL_PTR(&vars[1], other->var);
+
+    lv_anim_del(&vars[2], set_int);
+    TEST_ASSERT_NULL(lv_anim_get(&vars[2], set_int));
+    start_int_anim(a->var, lv_anim_path_linear, 500);
+}
+
+void test_anim_changed_in_callbacks(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_exec_cb(&a, set_int);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_ready_cb(&a, restart_ready_cb);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_t * first = lv_anim_start(&a);
+    start_int_anim(&vars[1], lv_anim_path_ease_out, 1000);
+    start_int_anim(&vars[2], lv_anim_path_ease_out, 1000);
+
+    step(100);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL(2, deleted_cnt);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    /*The new animation runs from the next round*/
+    lv_anim_t * restarted = lv_anim_get(&vars[0], set_int);
+    TEST_ASSERT_NOT_NULL(restarted);
+    TEST_ASSERT_EQUAL(0, restarted->act_time);
+    TEST_ASSERT_NULL(restarted->ready_cb);
+    LV_UNUSED(first);
+
+    step(500);
+    TEST_ASSERT_EQUAL(1000, vars[0]);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+}
+
+static int32_t events[8];
+static uint32_t event_cnt;
+
+static void log_start_cb(lv_anim_t * a)
+{
+    events[event_cnt++] = -*(int32_t *)a->var;
+}
+
+static void log_exec_cb(void * var, int32_t v)
+{
+    LV_UNUSED(v);
+    events[event_cnt++] = *(int32_t *)var;
+}
+
+/*`start_cb` of each animation is called right before its first `exec_cb`, the newer animations first*/
+void test_anim_start_cb_before_exec_cb(void)
+{
+    vars[0] = 1;
+    vars[1] = 2;
+    event_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_set_exec_cb(&a, log_exec_cb);
+        lv_anim_set_start_cb(&a, log_start_cb);
+        lv_anim_set_values(&a, 0, 100);
+        lv_anim_set_time(&a, 100);
+        lv_anim_set_early_apply(&a, false);
+        lv_anim_start(&a);
+    }
+
+    step(10);
+    int32_t expected[] = {-2, 2, -1, 1};
+    TEST_ASSERT_EQUAL(4, event_cnt);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, events, 4);
+}
+
+static void set_other_end(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    LV_UNUSED(v);
+    lv_anim_t * other = lv_anim_get(&vars[0], set_int);
+    lv_anim_set_values(other, 0, 2000);
+}
+
+/*An animation changed by the callbacks of an other one in the same round gets the value of its new settings*/
+void test_anim_values_set_in_callbacks(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_exec_cb(&a, set_int);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_start(&a);
+
+    /*The newer animation runs first*/
+    lv_anim_set_var(&a, &vars[1]);
+    lv_anim_set_exec_cb(&a, set_other_end);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_start(&a);
+
+    step(500);
+    TEST_ASSERT_EQUAL(1000, vars[0]);
+}
+
+void test_anim_many_with_playback(void)
+{
+    uint32_t i;
+    for(i = 0; i < MANY_ANIMS; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_set_exec_cb(&a, set_int);
+        lv_anim_set_values(&a, 0, 100);
+        lv_anim_set_time(&a, 100 + i % 7);
+        lv_anim_set_playback_time(&a, 100);
+        lv_anim_set_path_cb(&a, paths[i % PATH_NUM]);
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL(MANY_ANIMS, lv_anim_count_running());
+
+    step(110);
+    step(110);
+    for(i = 0; i < MANY_ANIMS; i++) TEST_ASSERT_EQUAL(0, vars[i]);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+/*The built-in paths are calculated together, but must give the same values as called one by one*/
+void test_anim_builtin_path_matches_custom(void)
+{
+    uint32_t i;
+    for(i = 0; i < MANY_ANIMS; i++) {
+        start_int_anim(&vars[i], i % 2 ? lv_anim_path_ease_in_out : custom_ease_in_out, 1000 + (i / 2) % 100);
+    }
+
+    uint32_t f;
+    for(f = 0; f < 40; f++) {
+        step(LV_DISP_DEF_REFR_PERIOD);
+        for(i = 0; i < MANY_ANIMS; i += 2) TEST_ASSERT_EQUAL(vars[i], vars[i + 1]);
+    }
+}
+
+#endif
@@ -14,12 +14,16 @@ void test_arc_should_update_value_after_updating_range(void);
 void test_arc_should_update_angles_when_changing_to_symmetrical_mode(void);
 void test_arc_should_update_angles_when_changing_to_symmetrical_mode_value_more_than_middle_range(void);
 void test_arc_angles_when_reversed(void);
+void test_arc_click_area_with_adv_hittest(void);
+void test_arc_value_change_invalidates_only_the_changed_sector(void);
 
 static lv_obj_t * active_screen = NULL;
 static lv_obj_t * arc = NULL;
 static uint32_t event_cnt;
 
 static void dummy_event_cb(lv_event_t * e);
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
 void setUp(void)
 {
@@ -158,6 +162,96 @@ void test_arc_click_area_with_adv_hittest(void)
     TEST_ASSERT_EQUAL_UINT32(0, event_cnt);
 }
 
+#define FB_W    800
+#define FB_H    480
+
+static lv_color_t fb[FB_W * FB_H];
+static lv_color_t fb_inv[FB_W * FB_H];
+static uint32_t refr_px;
+
+/**
+ * Count down a 480x480 rounded progress ring and measure the redrawn pixels per step.
+ * After every step the screen is compared with a full redraw to see that the whole change was invalidated.
+ * @return the largest number of redrawn pixels in a step
+ */
+static uint32_t countdown(uint16_t rotation, lv_arc_mode_t mode, int16_t steps, lv_coord_t indic_pad)
+{
+    lv_obj_clean(lv_scr_act());
+    arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(arc, 480, 480);
+    lv_obj_center(arc);
+    lv_obj_set_style_arc_width(arc, 30, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(arc, 30, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_rounded(arc, true, LV_PART_MAIN);
+    lv_obj_set_style_arc_rounded(arc, true, LV_PART_INDICATOR);
+    lv_obj_set_style_pad_all(arc, indic_pad, LV_PART_INDICATOR);
+    lv_arc_set_rotation(arc, rotation);
+    lv_arc_set_bg_angles(arc, 0, 360);
+    lv_arc_set_mode(arc, mode);
+    lv_arc_set_range(arc, 0, steps);
+    lv_arc_set_value(arc, steps);
+
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    void (*flush_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = drv->flush_cb;
+    drv->flush_cb = flush_cb;
+    drv->monitor_cb = monitor_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t max_px = 0;
+    int16_t v;
+    for(v = steps - 1; v >= 0; v--) {
+        refr_px = 0;
+        lv_arc_set_value(arc, v);
+        lv_refr_now(NULL);
+        max_px = LV_MAX(max_px, refr_px);
+
+        lv_memcpy(fb_inv, fb, sizeof(fb));
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(fb, fb_inv, sizeof(fb));
+    }
+
+    drv->flush_cb = flush_ori;
+    drv->monitor_cb = NULL;
+    lv_obj_del(arc);
+    return max_px;
+}
+
+void test_arc_value_change_invalidates_only_the_changed_sector(void)
+{
+    TEST_ASSERT_EQUAL(FB_W, lv_disp_get_hor_res(NULL));
+    TEST_ASSERT_EQUAL(FB_H, lv_disp_get_ver_res(NULL));
+
+    /*A minute countdown with 6 deg steps and the knob moving with the end*/
+    TEST_ASSERT_LESS_THAN(480 * 480 / 20, countdown(270, LV_ARC_MODE_NORMAL, 60, 0));
+
+    /*90 deg steps crossing the axes*/
+    TEST_ASSERT_LESS_THAN(480 * 480 / 2, countdown(270, LV_ARC_MODE_NORMAL, 4, 0));
+
+    /*The indicator is smaller than the background and both of its ends move*/
+    countdown(0, LV_ARC_MODE_SYMMETRICAL, 7, 10);
+    countdown(135, LV_ARC_MODE_REVERSE, 12, 10);
+}
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * FB_W + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(time);
+    refr_px += px;
+}
+
 static void dummy_event_cb(lv_event_t * e)
 {
     LV_UNUSED(e);
@@ -0,0 +1,174 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../src/draw/sw/lv_draw_sw.h"
+
+#define MAX_RES         480
+
+static lv_disp_t * disp;
+static lv_disp_t * disp_ori;
+static lv_disp_drv_t disp_drv;
+static lv_disp_draw_buf_t draw_buf;
+static lv_color_t buf[MAX_RES * MAX_RES];
+static lv_color_t fb[MAX_RES * MAX_RES];
+static lv_color_t img_map[MAX_RES * MAX_RES];
+static lv_img_dsc_t img_dsc;
+
+void setUp(void)
+{
+    disp_ori = lv_disp_get_default();
+}
+
+static void disp_remove(void)
+{
+    lv_disp_remove(disp);
+    disp = NULL;
+    /*The draw context created for the display is freed with it*/
+    TEST_ASSERT_NULL(disp_drv.draw_ctx);
+}
+
+void tearDown(void)
+{
+    if(disp) disp_remove();
+    lv_disp_set_default(disp_ori);
+}
+
+/*Copy the rotated areas to their place in the frame buffer of the native orientation*/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+/*A display with `hor_res` x `ver_res` pixels in its native orientation rotated by the CPU*/
+static void disp_create(lv_coord_t hor_res, lv_coord_t ver_res, uint32_t buf_px_cnt)
+{
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, buf_px_cnt);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.hor_res = hor_res;
+    disp_drv.ver_res = ver_res;
+    disp_drv.sw_rotate = 1;
+    disp_drv.draw_ctx_init = lv_draw_sw_init_ctx;
+    disp_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    disp_drv.draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+    disp = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_default(disp);
+}
+
+/*An image with a different color on every pixel*/
+static lv_color_t img_px(lv_coord_t x, lv_coord_t y)
+{
+    return lv_color_make(x & 0xFF, y & 0xFF, ((x >> 8) << 4) | (y >> 8));
+}
+
+static void img_create(void)
+{
+    lv_coord_t y;
+    for(y = 0; y < MAX_RES; y++) {
+        lv_coord_t x;
+        for(x = 0; x < MAX_RES; x++) {
+            img_map[y * MAX_RES + x] = img_px(x, y);
+        }
+    }
+
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.w = MAX_RES;
+    img_dsc.header.h = MAX_RES;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = (const uint8_t *)img_map;
+
+    /*The image is larger than the screen but it shouldn't be covered by a scrollbar*/
+    lv_obj_set_scrollbar_mode(lv_scr_act(), LV_SCROLLBAR_MODE_OFF);
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 0, 0);
+}
+
+/*Check that every pixel of the screen got to its rotated place*/
+static void check_rotation(lv_disp_rot_t rot)
+{
+    lv_disp_set_rotation(disp, rot);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+
+    lv_coord_t hor_res = disp_drv.hor_res;
+    lv_coord_t ver_res = disp_drv.ver_res;
+    lv_coord_t y;
+    for(y = 0; y < ver_res; y++) {
+        lv_coord_t x;
+        for(x = 0; x < hor_res; x++) {
+            lv_coord_t img_x;
+            lv_coord_t img_y;
+            switch(rot) {
+                case LV_DISP_ROT_90:
+                    img_x = ver_res - 1 - y;
+                    img_y = x;
+                    break;
+                case LV_DISP_ROT_180:
+                    img_x = hor_res - 1 - x;
+                    img_y = ver_res - 1 - y;
+                    break;
+                case LV_DISP_ROT_270:
+                    img_x = y;
+                    img_y = hor_res - 1 - x;
+                    break;
+                default:
+                    img_x = x;
+                    img_y = y;
+                    break;
+            }
+            lv_color_t c = fb[y * hor_res + x];
+            if(lv_color_to32(c) != lv_color_to32(img_px(img_x, img_y))) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "rotation %d: wrong pixel at %d;%d", rot * 90, x, y);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+void test_disp_rotate_square(void)
+{
+    disp_create(MAX_RES, MAX_RES, MAX_RES * MAX_RES);
+    img_create();
+
+    check_rotation(LV_DISP_ROT_NONE);
+    check_rotation(LV_DISP_ROT_90);
+    check_rotation(LV_DISP_ROT_180);
+    check_rotation(LV_DISP_ROT_270);
+}
+
+/*With 90 and 270 degrees a square is rotated in place and the rest in chunks*/
+void test_disp_rotate_not_square(void)
+{
+    disp_create(MAX_RES, 317, MAX_RES * MAX_RES);
+    img_create();
+
+    check_rotation(LV_DISP_ROT_NONE);
+    check_rotation(LV_DISP_ROT_90);
+    check_rotation(LV_DISP_ROT_180);
+    check_rotation(LV_DISP_ROT_270);
+}
+
+/*Smaller draw buffer than the screen*/
+void test_disp_rotate_partial(void)
+{
+    disp_create(301, 203, 301 * 45);
+    img_create();
+
+    check_rotation(LV_DISP_ROT_NONE);
+    check_rotation(LV_DISP_ROT_90);
+    check_rotation(LV_DISP_ROT_180);
+    check_rotation(LV_DISP_ROT_270);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_COLOR_DEPTH == 32 && LV_USE_PNG
+
+typedef struct {
+    lv_coord_t size;
+    lv_coord_t width;
+    uint16_t start_angle;
+    uint16_t end_angle;
+    bool rounded;
+    lv_opa_t opa;
+} arc_param_t;
+
+static const arc_param_t arcs[] = {
+    {140, 20, 0, 360, false, LV_OPA_COVER},
+    {140, 20, 135, 45, true, LV_OPA_COVER},
+    {140, 10, 270, 90, false, LV_OPA_COVER},
+    {140, 30, 30, 200, true, LV_OPA_COVER},
+    {140, 1, 0, 300, false, LV_OPA_COVER},
+    {100, 2, 10, 350, false, LV_OPA_COVER},
+    {100, 3, 200, 10, true, LV_OPA_COVER},
+    {100, 50, 0, 90, false, LV_OPA_COVER},
+    {100, 50, 45, 225, true, LV_OPA_COVER},
+    {60, 8, 90, 91, true, LV_OPA_COVER},
+    {20, 4, 0, 270, true, LV_OPA_COVER},
+    {10, 5, 0, 180, false, LV_OPA_COVER},
+    {140, 20, 0, 359, false, LV_OPA_50},
+    {140, 20, 300, 60, false, LV_OPA_50},
+    {140, 70, 100, 80, false, LV_OPA_COVER},
+};
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * arc_create(lv_obj_t * parent, const arc_param_t * p)
+{
+    lv_obj_t * arc = lv_arc_create(parent);
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+    lv_obj_set_size(arc, p->size, p->size);
+    lv_obj_set_style_pad_all(arc, 0, 0);
+    lv_obj_set_style_arc_width(arc, p->width, 0);
+    lv_obj_set_style_arc_rounded(arc, p->rounded, 0);
+    lv_obj_set_style_arc_opa(arc, p->opa, 0);
+    lv_obj_set_style_arc_color(arc, lv_palette_darken(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_INDICATOR);
+    lv_arc_set_bg_angles(arc, p->start_angle, p->end_angle);
+    return arc;
+}
+
+static void create_scene(uint32_t scene)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_clean(scr);
+    lv_obj_set_style_pad_all(scr, 0, 0);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+
+    if(scene == 0) {
+        uint32_t i;
+        for(i = 0; i < sizeof(arcs) / sizeof(arcs[0]); i++) {
+            lv_obj_t * arc = arc_create(scr, &arcs[i]);
+            lv_coord_t ofs = 5 + (140 - arcs[i].size) / 2;
+            lv_obj_set_pos(arc, (i % 5) * 160 + ofs, (i / 5) * 160 + ofs);
+        }
+    }
+    else {
+        /*A large ring partly out of the screen*/
+        arc_param_t p = {600, 40, 120, 60, true, LV_OPA_COVER};
+        lv_obj_t * arc = arc_create(scr, &p);
+        lv_obj_set_pos(arc, 250, -40);
+    }
+}
+
+/**
+ * Compare the screen with a reference image drawn with the mask based arc drawing.
+ * Count the pixels which differ more than the half of the contrast between the arcs and the background.
+ */
+static uint32_t compare_to_golden(const char * name)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    char path[64];
+    lv_snprintf(path, sizeof(path), "A:ref_imgs/%s", name);
+    lv_png_set_stream_min_px(1);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, path, lv_color_black(), 0));
+    lv_png_set_stream_min_px(LV_PNG_STREAM_MIN_PX);
+    TEST_ASSERT_EQUAL(LV_HOR_RES, dsc.header.w);
+    TEST_ASSERT_EQUAL(LV_VER_RES, dsc.header.h);
+
+    lv_color_t * line = lv_mem_alloc(LV_HOR_RES * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(line);
+    uint32_t diff_cnt = 0;
+    lv_coord_t x, y;
+    for(y = 0; y < LV_VER_RES; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, LV_HOR_RES, (uint8_t *)line));
+        for(x = 0; x < LV_HOR_RES; x++) {
+            lv_color_t ref = line[x];
+            lv_color_t act = test_fb[y * LV_HOR_RES + x];
+            uint32_t diff = LV_MAX(LV_ABS(ref.ch.red - act.ch.red), LV_ABS(ref.ch.blue - act.ch.blue));
+            diff = LV_MAX(diff, (uint32_t)LV_ABS(ref.ch.green - act.ch.green));
+            if(diff > 128) diff_cnt++;
+        }
+    }
+    lv_mem_free(line);
+    lv_img_decoder_close(&dsc);
+    return diff_cnt;
+}
+
+#endif
+
+void test_draw_arc_golden(void)
+{
+#if LV_COLOR_DEPTH == 32 && LV_USE_PNG
+    uint32_t scene;
+    for(scene = 0; scene < 2; scene++) {
+        create_scene(scene);
+        char name[32];
+        lv_snprintf(name, sizeof(name), "arc_golden_%d.png", scene + 1);
+
+        /*The edges can be shifted by a fraction of a pixel and the rounded ends are placed a little differently*/
+        TEST_ASSERT_LESS_THAN(64, compare_to_golden(name));
+    }
+#endif
+}
+
+/*The rounded ends are not blended again on the arc*/
+void test_draw_arc_rounded_translucent(void)
+{
+#if LV_COLOR_DEPTH == 32 && LV_USE_PNG
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    arc_param_t p = {140, 20, 0, 90, true, LV_OPA_50};
+    lv_obj_t * arc = arc_create(lv_scr_act(), &p);
+    lv_obj_set_pos(arc, 100, 100);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    /*On the middle of the arc, on the rounded end out of the arc and on the rounded end over the arc*/
+    lv_coord_t cx = 170;
+    lv_coord_t cy = 170;
+    lv_color_t c_mid = test_fb[(cy + 42) * LV_HOR_RES + cx + 42];
+    lv_color_t c_out = test_fb[(cy - 3) * LV_HOR_RES + cx + 60];
+    lv_color_t c_over = test_fb[(cy + 3) * LV_HOR_RES + cx + 60];
+    TEST_ASSERT_NOT_EQUAL(lv_color_to32(lv_color_white()), lv_color_to32(c_mid));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(c_mid), lv_color_to32(c_out));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(c_mid), lv_color_to32(c_over));
+#endif
+}
+
+#endif
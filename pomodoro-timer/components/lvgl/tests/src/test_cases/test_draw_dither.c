@@ -0,0 +1,169 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../src/draw/sw/lv_draw_sw_dither.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#if LV_DITHER_BLEND
+
+#define BUF_W           256
+#define BUF_H           64
+#define BLUR_R          2       /*Size of the box blur which models how the eye averages the neighbor pixels*/
+
+static uint16_t dest[BUF_H][BUF_W];
+static uint16_t plain[BUF_H][BUF_W];
+static uint16_t src[BUF_W];
+static lv_opa_t mask[BUF_W];
+static float ref[BUF_H][BUF_W][3];
+
+static uint16_t rgb565(uint32_t r, uint32_t g, uint32_t b)
+{
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+/*A channel of an RGB565 color in the 0..255 range*/
+static float ch8(uint16_t c, uint32_t ch)
+{
+    if(ch == 0) return (float)(c >> 11) * 255.0f / 31.0f;
+    if(ch == 1) return (float)((c >> 5) & 0x3F) * 255.0f / 63.0f;
+    return (float)(c & 0x1F) * 255.0f / 31.0f;
+}
+
+/*`lv_color_mix()` of LV_COLOR_DEPTH 16*/
+static uint16_t mix_565(uint16_t c1, uint16_t c2, uint32_t mix)
+{
+    mix = (mix + 4) >> 3;
+    uint32_t bg = ((uint32_t)c2 | ((uint32_t)c2 << 16)) & 0x7E0F81F;
+    uint32_t fg = ((uint32_t)c1 | ((uint32_t)c1 << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+    return (uint16_t)((result >> 16) | result);
+}
+
+/*Blend `color` or `src` with the opacity of `mask` and `opa` to `bg` with both methods
+ *and store the exact result in `ref`*/
+static void blend_both(uint16_t bg, const uint16_t * src_row, uint16_t color, const lv_opa_t * mask_row, lv_opa_t opa)
+{
+    uint32_t y;
+    for(y = 0; y < BUF_H; y++) {
+        uint32_t x;
+        for(x = 0; x < BUF_W; x++) dest[y][x] = bg;
+        lv_dither_blend_565(dest[y], src_row, color, mask_row, opa, 0, (lv_coord_t)y, BUF_W);
+
+        for(x = 0; x < BUF_W; x++) {
+            uint16_t fg = src_row ? src_row[x] : color;
+            uint32_t a = mask_row ? (opa >= LV_OPA_MAX ? mask_row[x] : (mask_row[x] * opa) >> 8) : opa;
+            plain[y][x] = mix_565(fg, bg, a);
+
+            uint32_t ch;
+            for(ch = 0; ch < 3; ch++) {
+                ref[y][x][ch] = (ch8(fg, ch) * (float)a + ch8(bg, ch) * (float)(255 - a)) / 255.0f;
+            }
+        }
+    }
+}
+
+/*The average difference from the exact result after blurring both images in 1/100 units of the 0..255 range*/
+static uint32_t blurred_error(uint16_t buf[BUF_H][BUF_W])
+{
+    float err = 0;
+    uint32_t cnt = 0;
+    int32_t y;
+    for(y = BLUR_R; y < BUF_H - BLUR_R; y++) {
+        int32_t x;
+        for(x = BLUR_R; x < BUF_W - BLUR_R; x++) {
+            uint32_t ch;
+            for(ch = 0; ch < 3; ch++) {
+                float sum_buf = 0;
+                float sum_ref = 0;
+                int32_t i;
+                int32_t j;
+                for(i = -BLUR_R; i <= BLUR_R; i++) {
+                    for(j = -BLUR_R; j <= BLUR_R; j++) {
+                        sum_buf += ch8(buf[y + i][x + j], ch);
+                        sum_ref += ref[y + i][x + j][ch];
+                    }
+                }
+                float d = (sum_buf - sum_ref) / ((2 * BLUR_R + 1) * (2 * BLUR_R + 1));
+                err += d < 0 ? -d : d;
+                cnt++;
+            }
+        }
+    }
+    return (uint32_t)(err * 100.0f / (float)cnt);
+}
+
+static void check_error(const char * name)
+{
+    uint32_t err_dither = blurred_error(dest);
+    uint32_t err_plain = blurred_error(plain);
+    TEST_ASSERT_LESS_THAN_MESSAGE(100, err_dither, name);
+    TEST_ASSERT_LESS_THAN_MESSAGE(err_plain / 2, err_dither, name);
+}
+
+#endif
+
+/*Edge of a soft shadow: black faded to a white background*/
+void test_draw_dither_fill_mask(void)
+{
+#if LV_DITHER_BLEND
+    uint32_t x;
+    for(x = 0; x < BUF_W; x++) mask[x] = (lv_opa_t)x;
+
+    blend_both(0xFFFF, NULL, 0x0000, mask, LV_OPA_COVER);
+    check_error("shadow edge");
+
+    blend_both(rgb565(40, 40, 40), NULL, rgb565(240, 120, 20), mask, LV_OPA_70);
+    check_error("orange fade with opacity");
+#endif
+}
+
+/*A gradient image with opacity*/
+void test_draw_dither_map_opa(void)
+{
+#if LV_DITHER_BLEND
+    uint32_t x;
+    for(x = 0; x < BUF_W; x++) src[x] = rgb565(x, 255 - x, x / 2);
+
+    blend_both(rgb565(20, 40, 200), src, 0, NULL, LV_OPA_30);
+    check_error("image with 30% opacity");
+#endif
+}
+
+void test_draw_dither_exact_ends(void)
+{
+#if LV_DITHER_BLEND
+    uint16_t row[BUF_W];
+    uint32_t x;
+    for(x = 0; x < BUF_W; x++) {
+        src[x] = (uint16_t)(x * 257);
+        mask[x] = x % 2 ? LV_OPA_COVER : LV_OPA_TRANSP;
+        row[x] = (uint16_t)(0xFFFF - x * 3);
+    }
+
+    /*Covered pixels get the source color and the transparent ones remain unchanged*/
+    lv_memcpy(dest[0], row, sizeof(row));
+    lv_dither_blend_565(dest[0], src, 0, mask, LV_OPA_COVER, 5, 3, BUF_W);
+    for(x = 0; x < BUF_W; x++) {
+        TEST_ASSERT_EQUAL_HEX16(x % 2 ? src[x] : row[x], dest[0][x]);
+    }
+
+    /*The pattern depends only on the screen coordinates, not on where a row is split*/
+    for(x = 0; x < BUF_W; x++) mask[x] = (lv_opa_t)(x * 7);
+    lv_memcpy(dest[0], row, sizeof(row));
+    lv_memcpy(dest[1], row, sizeof(row));
+    lv_dither_blend_565(dest[0], src, 0, mask, LV_OPA_80, 10, 7, BUF_W);
+    lv_dither_blend_565(dest[1], src, 0, mask, LV_OPA_80, 10, 7, 13);
+    lv_dither_blend_565(&dest[1][13], &src[13], 0, &mask[13], LV_OPA_80, 10 + 13, 7, BUF_W - 13);
+    TEST_ASSERT_EQUAL_MEMORY(dest[0], dest[1], sizeof(row));
+#endif
+}
+
+#endif
@@ -0,0 +1,246 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../src/draw/esp/lv_gpu_esp_gdma.h"
+
+#if LV_USE_GPU_ESP_GDMA
+
+#define FB_W            800
+#define FB_H            480
+#define IMG_W           200
+#define IMG_H           120
+
+extern lv_color_t test_fb[];
+
+static lv_draw_esp_gdma_ctx_t * draw_ctx;
+static lv_draw_ctx_t * draw_ctx_ori;
+static bool (*copy_ori)(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size);
+static uint32_t copy_call_cnt;
+static lv_color_t img_map[IMG_W * IMG_H];
+static lv_img_dsc_t img_dsc;
+
+/*Draw with the CPU only or start the large fills and copies in the background*/
+static void use_dma(bool en)
+{
+    lv_draw_sw_ctx_t * sw_ctx = &draw_ctx->base_sw_ctx;
+    sw_ctx->blend = en ? lv_draw_esp_gdma_blend : lv_draw_sw_blend_basic;
+    sw_ctx->base_draw.wait_for_finish = en ? lv_draw_esp_gdma_wait_for_finish : lv_draw_sw_wait_for_finish;
+    sw_ctx->blend_sync = NULL;
+    if(en) {
+        lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+        lv_draw_esp_gdma_ctx_deinit(drv, &sw_ctx->base_draw);
+        lv_draw_esp_gdma_ctx_init(drv, &sw_ctx->base_draw);
+        copy_ori = draw_ctx->dev.copy_cb;
+    }
+}
+
+/*Refuse every second copy to make the CPU copy them*/
+static bool copy_refuse_cb(lv_gpu_esp_gdma_dev_t * dev, void * dest, const void * src, size_t size)
+{
+    copy_call_cnt++;
+    if(copy_call_cnt % 2) return false;
+    return copy_ori(dev, dest, src, size);
+}
+
+static void img_init(void)
+{
+    uint32_t y;
+    for(y = 0; y < IMG_H; y++) {
+        uint32_t x;
+        for(x = 0; x < IMG_W; x++) {
+            img_map[y * IMG_W + x] = lv_color_make(x, y * 2, (x + y) / 2);
+        }
+    }
+
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.w = IMG_W;
+    img_dsc.header.h = IMG_H;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = (const uint8_t *)img_map;
+}
+
+/*Large fills and images with everything drawn over and next to them*/
+static void create_scene(void)
+{
+    img_init();
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+
+    lv_obj_t * panel = lv_obj_create(scr);
+    lv_obj_set_pos(panel, 20, 20);
+    lv_obj_set_size(panel, 360, 260);
+    lv_obj_set_style_radius(panel, 0, 0);
+    lv_obj_set_style_bg_color(panel, lv_palette_lighten(LV_PALETTE_BLUE, 4), 0);
+
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "Text on a filled panel");
+
+    lv_obj_t * btn = lv_btn_create(panel);
+    lv_obj_set_size(btn, 200, 60);
+    lv_obj_align(btn, LV_ALIGN_CENTER, 0, 0);
+
+    label = lv_label_create(panel);
+#if LV_FONT_MONTSERRAT_12_SUBPX
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_12_subpx, 0);
+#endif
+    lv_label_set_text(label, "Sub-pixel rendered text over a fill");
+    lv_obj_align(label, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+
+    lv_obj_t * img = lv_img_create(scr);
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 420, 20);
+
+    /*Partly out of the screen and covered by an other image*/
+    img = lv_img_create(scr);
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 700, 100);
+
+    img = lv_img_create(scr);
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 560, 60);
+    lv_obj_set_style_img_opa(img, LV_OPA_50, 0);
+
+    label = lv_label_create(scr);
+    lv_label_set_text(label, "Text on an image");
+    lv_obj_set_pos(label, 430, 60);
+
+    /*Drawn on a layer*/
+    lv_obj_t * rect = lv_obj_create(scr);
+    lv_obj_set_pos(rect, 420, 300);
+    lv_obj_set_size(rect, 340, 150);
+    lv_obj_set_style_radius(rect, 0, 0);
+    lv_obj_set_style_opa(rect, LV_OPA_70, 0);
+    lv_obj_set_style_bg_color(rect, lv_palette_main(LV_PALETTE_RED), 0);
+    label = lv_label_create(rect);
+    lv_label_set_text(label, "Semi-transparent layer");
+
+    rect = lv_obj_create(scr);
+    lv_obj_set_pos(rect, 20, 300);
+    lv_obj_set_size(rect, 360, 150);
+    lv_obj_set_style_radius(rect, 30, 0);
+    lv_obj_set_style_bg_color(rect, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_shadow_width(rect, 20, 0);
+}
+
+static void refr_all(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_USE_GPU_ESP_GDMA
+    /*The test display draws with the CPU so replace its draw context*/
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    draw_ctx_ori = drv->draw_ctx;
+    draw_ctx = lv_mem_alloc(sizeof(lv_draw_esp_gdma_ctx_t));
+    TEST_ASSERT_NOT_NULL(draw_ctx);
+    lv_draw_esp_gdma_ctx_init(drv, &draw_ctx->base_sw_ctx.base_draw);
+    drv->draw_ctx = &draw_ctx->base_sw_ctx.base_draw;
+
+    copy_ori = draw_ctx->dev.copy_cb;
+    lv_draw_esp_gdma_reset_stats(&draw_ctx->base_sw_ctx.base_draw);
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_GPU_ESP_GDMA
+    lv_obj_clean(lv_scr_act());
+    draw_ctx->dev.copy_cb = copy_ori;
+
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->draw_ctx = draw_ctx_ori;
+    lv_draw_esp_gdma_ctx_deinit(drv, &draw_ctx->base_sw_ctx.base_draw);
+    lv_mem_free(draw_ctx);
+    draw_ctx = NULL;
+#endif
+}
+
+/*The background fills and copies result the same image as drawing everything with the CPU*/
+void test_draw_esp_gdma_same_as_sw(void)
+{
+#if LV_USE_GPU_ESP_GDMA
+    static lv_color_t ref[FB_W * FB_H];
+    create_scene();
+
+    use_dma(false);
+    refr_all();
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    use_dma(true);
+    refr_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_esp_gdma_1.png");
+
+    /*The engine can refuse some copies*/
+    draw_ctx->dev.copy_cb = copy_refuse_cb;
+    copy_call_cnt = 0;
+    refr_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+    TEST_ASSERT_NOT_EQUAL(0, copy_call_cnt);
+#endif
+}
+
+/*Recolored images are converted in a temporary buffer which is refilled and released while it might be copied*/
+void test_draw_esp_gdma_recolor_same_as_sw(void)
+{
+#if LV_USE_GPU_ESP_GDMA
+    static lv_color_t ref[FB_W * FB_H];
+    img_init();
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 10, 10);
+    lv_obj_set_style_img_recolor(img, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_img_recolor_opa(img, LV_OPA_50, 0);
+
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, 300, 200);
+    lv_obj_set_style_img_recolor(img, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_img_recolor_opa(img, LV_OPA_30, 0);
+
+    use_dma(false);
+    refr_all();
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    use_dma(true);
+    refr_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+#endif
+}
+
+void test_draw_esp_gdma_stats(void)
+{
+#if LV_USE_GPU_ESP_GDMA
+    create_scene();
+    refr_all();
+
+    lv_gpu_esp_gdma_stats_t stats;
+    lv_draw_esp_gdma_get_stats(&draw_ctx->base_sw_ctx.base_draw, &stats);
+
+    /*The backgrounds of the screen and the panel and the opaque images*/
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.fill_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.copy_cnt);
+    TEST_ASSERT_GREATER_THAN(stats.fill_cnt + stats.copy_cnt, stats.dma_copy_cnt);
+
+    /*Texts, rounded corners, shadows and semi-transparent things are drawn by the CPU,
+     *some of them while a fill or copy is in progress*/
+    TEST_ASSERT_GREATER_THAN(50, stats.sw_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stats.overlap_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stats.wait_cnt);
+
+    /*Everything is copied when the refresh is ready*/
+    TEST_ASSERT_EQUAL(draw_ctx->dev.start_cnt, draw_ctx->dev.ready_cnt);
+    TEST_ASSERT_EQUAL(0, draw_ctx->op_cnt);
+#endif
+}
+
+#endif
@@ -0,0 +1,193 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../src/draw/sw/lv_draw_sw.h"
+
+#define FB_W            800
+#define FB_H            480
+#define MULTI_LINE_TXT  "hello world\nit is a multi line text to test\nthe performance of text rendering"
+
+/*The default font is used for the sizes which are not enabled*/
+#if LV_FONT_MONTSERRAT_24
+    #define FONT_MEDIUM   &lv_font_montserrat_24
+#else
+    #define FONT_MEDIUM   LV_FONT_DEFAULT
+#endif
+
+#if LV_FONT_MONTSERRAT_48
+    #define FONT_LARGE    &lv_font_montserrat_48
+#else
+    #define FONT_LARGE    LV_FONT_DEFAULT
+#endif
+
+extern lv_color_t test_fb[];
+
+static lv_draw_sw_ctx_t * draw_ctx;
+static void (*blend_ori)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static uint32_t blend_cnt;
+
+static void blend_count_cb(lv_draw_ctx_t * ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    blend_cnt++;
+    blend_ori(ctx, dsc);
+}
+
+void setUp(void)
+{
+    draw_ctx = (lv_draw_sw_ctx_t *)lv_disp_get_default()->driver->draw_ctx;
+    blend_ori = draw_ctx->blend;
+    draw_ctx->blend = blend_count_cb;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    draw_ctx->blend = blend_ori;
+    draw_ctx->base_draw.draw_letter_line = lv_draw_sw_letter_line;
+}
+
+static lv_obj_t * label_create(lv_obj_t * parent, const lv_font_t * font, const char * txt, lv_coord_t x,
+                               lv_coord_t y)
+{
+    lv_obj_t * label = lv_label_create(parent);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, txt);
+    lv_obj_set_pos(label, x, y);
+    return label;
+}
+
+/*Texts with every kind of fonts and features drawn by the line path*/
+static void create_scene(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    label_create(scr, &lv_font_montserrat_14, "Kerning: AVAWAY Ta To LT", 10, 10);
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+    label_create(scr, &lv_font_montserrat_28_compressed, "Compressed font", 10, 35);
+#endif
+#if LV_FONT_UNSCII_8
+    label_create(scr, &lv_font_unscii_8, "1 bpp font with unscii 8", 10, 75);
+#endif
+#if LV_FONT_MONTSERRAT_12_SUBPX
+    label_create(scr, &lv_font_montserrat_12_subpx, "Sub-pixel rendered font", 10, 95);
+#endif
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    label_create(scr, &lv_font_dejavu_16_persian_hebrew, "מעבד, או בשמו המלא יחידת עיבוד מרכזית", 10, 115);
+#endif
+#if LV_FONT_SIMSUN_16_CJK
+    label_create(scr, &lv_font_simsun_16_cjk, "嵌入式系统", 10, 145);
+#endif
+
+    lv_obj_t * label;
+#if LV_FONT_MONTSERRAT_24
+    label = label_create(scr, &lv_font_montserrat_24, "Re-color #ff0000 red# and #0000ff blue# words", 10, 170);
+    lv_label_set_recolor(label, true);
+
+    label = label_create(scr, &lv_font_montserrat_24, "Overlapping letters", 10, 240);
+    lv_obj_set_style_text_letter_space(label, -4, 0);
+#endif
+
+#if LV_FONT_MONTSERRAT_18
+    label = label_create(scr, &lv_font_montserrat_18, "Selected part of the text", 10, 210);
+    lv_label_set_text_sel_start(label, 5);
+    lv_label_set_text_sel_end(label, 12);
+#endif
+
+#if LV_FONT_MONTSERRAT_16
+    label = label_create(scr, &lv_font_montserrat_16, "Semi-transparent and underlined", 10, 280);
+    lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+    lv_obj_set_style_text_decor(label, LV_TEXT_DECOR_UNDERLINE, 0);
+#endif
+
+    /*Clipped and masked by a rounded parent*/
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_set_pos(cont, 420, 10);
+    lv_obj_set_size(cont, 360, 300);
+    lv_obj_set_style_radius(cont, 80, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+#if LV_FONT_MONTSERRAT_48
+    label = label_create(cont, &lv_font_montserrat_48, "A long text\nclipped by\nthe rounded\ncorners", -10, -10);
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_GREEN), 0);
+
+    label = label_create(scr, &lv_font_montserrat_48, "Large text to split into strips", 10, 320);
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_ORANGE), 0);
+#endif
+    LV_UNUSED(label);   /*If none of its fonts are enabled*/
+}
+
+/*The largest difference of a color channel*/
+static uint32_t max_diff(const lv_color_t * ref, const lv_color_t * act)
+{
+    uint32_t max = 0;
+    uint32_t i;
+    for(i = 0; i < FB_W * FB_H; i++) {
+        uint32_t diff = LV_MAX(LV_ABS(LV_COLOR_GET_R(ref[i]) - LV_COLOR_GET_R(act[i])),
+                               LV_ABS(LV_COLOR_GET_B(ref[i]) - LV_COLOR_GET_B(act[i])));
+        diff = LV_MAX(diff, (uint32_t)LV_ABS(LV_COLOR_GET_G(ref[i]) - LV_COLOR_GET_G(act[i])));
+        if(diff > max) max = diff;
+    }
+    return max;
+}
+
+static void refr_all(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_draw_label_line_same_as_letters(void)
+{
+    static lv_color_t ref[FB_W * FB_H];
+    create_scene();
+
+    /*Draw each letter with its own blending*/
+    draw_ctx->base_draw.draw_letter_line = NULL;
+    refr_all();
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    draw_ctx->base_draw.draw_letter_line = lv_draw_sw_letter_line;
+    refr_all();
+    /*Only the overlapping pixels of the letters can be rounded differently*/
+    TEST_ASSERT_LESS_OR_EQUAL(1, max_diff(ref, test_fb));
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_label_1.png");
+}
+
+/*The text scenes of the benchmark demo*/
+static void txt_scene_create(const lv_font_t * font, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * label = lv_label_create(lv_scr_act());
+        lv_obj_remove_style_all(label);
+        lv_obj_set_style_text_font(label, font, 0);
+        lv_obj_set_style_text_opa(label, opa, 0);
+        lv_obj_set_style_text_color(label, lv_color_hex(0x102030 * (i + 1)), 0);
+        lv_label_set_text(label, MULTI_LINE_TXT);
+        lv_obj_set_pos(label, (i % 2) * 400 + 10, (i / 2) * 115 - 20);
+    }
+}
+
+/*The letters of a line are blended together*/
+void test_draw_label_line_blend_cnt(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, FONT_MEDIUM, FONT_LARGE};
+
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_clean(lv_scr_act());
+        txt_scene_create(fonts[i / 2], i % 2 ? LV_OPA_50 : LV_OPA_COVER);
+
+        draw_ctx->base_draw.draw_letter_line = NULL;
+        blend_cnt = 0;
+        refr_all();
+        uint32_t letter_blend_cnt = blend_cnt;
+
+        draw_ctx->base_draw.draw_letter_line = lv_draw_sw_letter_line;
+        blend_cnt = 0;
+        refr_all();
+        TEST_ASSERT_LESS_THAN(letter_blend_cnt / 4, blend_cnt);
+    }
+}
+
+#endif
@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../src/draw/sw/lv_draw_sw.h"
+
+#if LV_DRAW_COMPLEX && LV_LAYER_POOL_CNT
+
+#define FB_W            800
+#define FB_H            480
+
+extern lv_color_t test_fb[];
+
+static lv_draw_ctx_t * draw_ctx;
+
+static lv_obj_t * card_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, uint32_t i)
+{
+    lv_obj_t * card = lv_obj_create(parent);
+    lv_obj_set_pos(card, x, y);
+    lv_obj_set_size(card, 180, 120);
+    lv_obj_set_style_bg_color(card, lv_palette_main((i * 2) % _LV_PALETTE_LAST), 0);
+    /*Cover the layer fully so it works without LV_COLOR_SCREEN_TRANSP too*/
+    lv_obj_set_style_radius(card, 0, 0);
+    lv_obj_set_scrollbar_mode(card, LV_SCROLLBAR_MODE_OFF);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text_fmt(label, "Card %d", i);
+    lv_obj_center(label);
+    return card;
+}
+
+/*Semi-transparent and transformed cards, some of them nested into each other*/
+static void create_scene(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * card = card_create(scr, (i % 4) * 200 + 10, (i / 4) * 160 + 20, i);
+        switch(i % 3) {
+            case 0:
+                lv_obj_set_style_opa(card, LV_OPA_60, 0);
+                break;
+            case 1:
+                lv_obj_set_style_transform_angle(card, i * 70, 0);
+                lv_obj_set_style_transform_zoom(card, 200 + i * 10, 0);
+                lv_obj_set_style_transform_pivot_x(card, 90, 0);
+                lv_obj_set_style_transform_pivot_y(card, 60, 0);
+                break;
+            default: {
+                    lv_obj_set_style_opa(card, LV_OPA_70, 0);
+                    lv_obj_t * inner = card_create(card, 0, 0, i + 1);
+                    lv_obj_set_size(inner, 90, 50);
+                    lv_obj_set_style_transform_angle(inner, 150, 0);
+                    lv_obj_set_style_opa(inner, LV_OPA_80, 0);
+                    break;
+                }
+        }
+    }
+}
+
+/*The largest difference of a color channel*/
+static uint32_t max_diff(const lv_color_t * ref, const lv_color_t * act)
+{
+    uint32_t max = 0;
+    uint32_t i;
+    for(i = 0; i < FB_W * FB_H; i++) {
+        uint32_t diff = LV_MAX(LV_ABS(LV_COLOR_GET_R(ref[i]) - LV_COLOR_GET_R(act[i])),
+                               LV_ABS(LV_COLOR_GET_B(ref[i]) - LV_COLOR_GET_B(act[i])));
+        diff = LV_MAX(diff, (uint32_t)LV_ABS(LV_COLOR_GET_G(ref[i]) - LV_COLOR_GET_G(act[i])));
+        if(diff > max) max = diff;
+    }
+    return max;
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_DRAW_COMPLEX && LV_LAYER_POOL_CNT
+    draw_ctx = lv_disp_get_default()->driver->draw_ctx;
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_DRAW_COMPLEX && LV_LAYER_POOL_CNT
+    lv_draw_sw_layer_pool_set_budget(draw_ctx, 0);
+#endif
+}
+
+/*The kept buffers give the same result in every refresh and they are reused without allocation after the first one*/
+void test_draw_layer_pool_no_alloc_in_steady_state(void)
+{
+#if LV_DRAW_COMPLEX && LV_LAYER_POOL_CNT
+    static lv_color_t ref[FB_W * FB_H];
+    create_scene();
+
+    /*Allocate every buffer only for its layer*/
+    lv_draw_sw_layer_pool_set_budget(draw_ctx, 1);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(draw_ctx, &stats);
+    TEST_ASSERT_EQUAL(0, stats.kept_size);
+
+    lv_draw_sw_layer_pool_set_budget(draw_ctx, 0);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    /*Fewer strips are needed now so only the transformed layers nested into the strips can differ a little*/
+    TEST_ASSERT_LESS_OR_EQUAL(2, max_diff(ref, test_fb));
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    lv_draw_sw_layer_pool_stats_t stats_start;
+    lv_mem_buf_monitor_t buf_mon_start;
+    lv_draw_sw_layer_pool_get_stats(draw_ctx, &stats_start);
+    lv_mem_buf_monitor(&buf_mon_start);
+    TEST_ASSERT_NOT_EQUAL(0, stats_start.kept_size);
+    TEST_ASSERT_LESS_OR_EQUAL(stats_start.budget, stats_start.kept_size);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+    }
+
+    lv_mem_buf_monitor_t buf_mon;
+    lv_draw_sw_layer_pool_get_stats(draw_ctx, &stats);
+    lv_mem_buf_monitor(&buf_mon);
+    TEST_ASSERT_EQUAL(stats_start.alloc_cnt, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL(buf_mon_start.alloc_cnt, buf_mon.alloc_cnt);
+    TEST_ASSERT_EQUAL(stats.layer_cnt - stats_start.layer_cnt, stats.hit_cnt - stats_start.hit_cnt);
+    TEST_ASSERT_EQUAL(stats_start.kept_size, stats.kept_size);
+
+    /*Reducing the budget frees the kept buffers*/
+    lv_draw_sw_layer_pool_set_budget(draw_ctx, 1);
+    lv_draw_sw_layer_pool_get_stats(draw_ctx, &stats);
+    TEST_ASSERT_EQUAL(0, stats.kept_size);
+#endif
+}
+
+#endif
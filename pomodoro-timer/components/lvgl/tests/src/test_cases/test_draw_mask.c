@@ -0,0 +1,260 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_COMPLEX
+
+#define MASK_CNT_MAX    5
+#define NEST_CNT        4
+#define FB_W            800
+#define FB_H            480
+
+typedef union {
+    _lv_draw_mask_common_dsc_t dsc;
+    lv_draw_mask_radius_param_t radius;
+    lv_draw_mask_line_param_t line;
+    lv_draw_mask_angle_param_t angle;
+    lv_draw_mask_fade_param_t fade;
+} mask_param_t;
+
+extern lv_color_t test_fb[];
+
+static mask_param_t params[MASK_CNT_MAX];
+static int16_t ids[MASK_CNT_MAX];
+static uint32_t param_cnt;
+static uint32_t seed;
+
+static void remove_masks(void)
+{
+    uint32_t i;
+    for(i = 0; i < param_cnt; i++) {
+        lv_draw_mask_remove_id(ids[i]);
+        lv_draw_mask_free_param(&params[i]);
+    }
+    param_cnt = 0;
+}
+
+static int32_t rnd(int32_t min, int32_t max)
+{
+    seed = seed * 1103515245 + 12345;
+    return min + (int32_t)((seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static void add_mask(mask_param_t * p)
+{
+    ids[param_cnt] = lv_draw_mask_add(p, NULL);
+    TEST_ASSERT_NOT_EQUAL(LV_MASK_ID_INV, ids[param_cnt]);
+    param_cnt++;
+}
+
+static void add_random_mask(bool runs_only)
+{
+    mask_param_t * p = &params[param_cnt];
+    lv_area_t a;
+    /*Only radius and fade masks or any masks*/
+    switch(runs_only ? rnd(0, 3) / 2 * 3 : rnd(0, 4)) {
+        case 0:
+        case 1:
+            a.x1 = rnd(-20, 600);
+            a.y1 = rnd(-20, 300);
+            a.x2 = a.x1 + rnd(0, 400);
+            a.y2 = a.y1 + rnd(0, 300);
+            lv_draw_mask_radius_init(&p->radius, &a, rnd(0, 3) ? rnd(0, 200) : LV_RADIUS_CIRCLE, rnd(0, 3) == 0);
+            break;
+        case 2:
+            lv_draw_mask_line_points_init(&p->line, rnd(-100, 900), rnd(-100, 600), rnd(-100, 900), rnd(-100, 600),
+                                          rnd(0, 3));
+            break;
+        case 3:
+            a.x1 = rnd(-20, 600);
+            a.y1 = rnd(-20, 300);
+            a.x2 = a.x1 + rnd(0, 400);
+            a.y2 = a.y1 + rnd(0, 300);
+            lv_draw_mask_fade_init(&p->fade, &a, rnd(0, 255), a.y1 + rnd(0, 100), rnd(0, 255), a.y2 - rnd(0, 100));
+            break;
+        default:
+            lv_draw_mask_angle_init(&p->angle, rnd(0, 800), rnd(0, 480), rnd(0, 359), rnd(0, 359));
+            break;
+    }
+    add_mask(p);
+}
+
+/*Apply the masks on the whole line one by one*/
+static lv_draw_mask_res_t apply_ref(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len)
+{
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < param_cnt; i++) {
+        lv_draw_mask_res_t res = params[i].dsc.cb(mask_buf, abs_x, abs_y, len, &params[i]);
+        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+    }
+
+    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+static void check_line(lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, const lv_opa_t * init)
+{
+    static lv_opa_t ref[1024];
+    static lv_opa_t act[1024];
+    lv_memcpy(ref, init, len);
+    lv_memcpy(act, init, len);
+    lv_draw_mask_res_t ref_res = apply_ref(ref, abs_x, abs_y, len);
+    lv_draw_mask_span_t span;
+    lv_draw_mask_res_t act_res = lv_draw_mask_apply_span(act, abs_x, abs_y, len, &span);
+
+    if(ref_res == LV_DRAW_MASK_RES_TRANSP || act_res == LV_DRAW_MASK_RES_TRANSP) {
+        if(ref_res != LV_DRAW_MASK_RES_TRANSP) {
+            lv_coord_t i;
+            for(i = 0; i < len; i++) TEST_ASSERT_EQUAL_HEX8(0, ref[i]);
+        }
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, act_res);
+        return;
+    }
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, act, len);
+    if(act_res == LV_DRAW_MASK_RES_FULL_COVER) TEST_ASSERT_EQUAL_HEX8_ARRAY(init, act, len);
+
+    /*Transparent out of the span and not changed on the covered run*/
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        lv_coord_t x = abs_x + i;
+        if(x < span.x1 || x > span.x2) TEST_ASSERT_EQUAL_HEX8(0, act[i]);
+        if(x >= span.cover_x1 && x <= span.cover_x2) TEST_ASSERT_EQUAL_HEX8(init[i], act[i]);
+    }
+}
+
+static void fade_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    static int16_t fade_id = LV_MASK_ID_INV;
+    static lv_draw_mask_fade_param_t fade;
+
+    if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        lv_area_t a;
+        lv_obj_get_coords(obj, &a);
+        lv_draw_mask_fade_init(&fade, &a, LV_OPA_COVER, a.y1 + lv_area_get_height(&a) / 2, LV_OPA_TRANSP, a.y2);
+        fade_id = lv_draw_mask_add(&fade, NULL);
+    }
+    else if(code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_free_param(&fade);
+        lv_draw_mask_remove_id(fade_id);
+        fade_id = LV_MASK_ID_INV;
+    }
+}
+
+/*Rounded containers clipping their rounded children and optionally a fade over all of them*/
+static void create_nested(bool fade)
+{
+    lv_obj_t * parent = lv_scr_act();
+    lv_obj_t * outer = NULL;
+    uint32_t i;
+    for(i = 0; i < NEST_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(parent);
+        lv_obj_set_size(obj, lv_pct(100), lv_pct(100));
+        lv_obj_set_style_radius(obj, 60 - i * 10, 0);
+        lv_obj_set_style_clip_corner(obj, true, 0);
+        lv_obj_set_style_pad_all(obj, 20, 0);
+        lv_obj_set_style_border_width(obj, 0, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED + i * 3), 0);
+        lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+        if(outer == NULL) outer = obj;
+        parent = obj;
+    }
+
+    /*Some content in the innermost container*/
+    lv_obj_t * label = lv_label_create(parent);
+    lv_label_set_text(label, "Nested rounded containers");
+    lv_obj_center(label);
+
+    if(fade) lv_obj_add_event_cb(outer, fade_event_cb, LV_EVENT_ALL, NULL);
+}
+
+/*A custom mask which doesn't change anything but makes all the masks calculated on the whole line*/
+static lv_draw_mask_res_t pass_mask_cb(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len,
+                                       void * param)
+{
+    LV_UNUSED(mask_buf);
+    LV_UNUSED(abs_x);
+    LV_UNUSED(abs_y);
+    LV_UNUSED(len);
+    LV_UNUSED(param);
+    return LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+static void refr_all(bool callbacks_only)
+{
+    static _lv_draw_mask_common_dsc_t pass_mask;
+    pass_mask.cb = pass_mask_cb;
+    int16_t id = callbacks_only ? lv_draw_mask_add(&pass_mask, NULL) : LV_MASK_ID_INV;
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_draw_mask_remove_id(id);
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_DRAW_COMPLEX
+    seed = 1;
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_DRAW_COMPLEX
+    remove_masks();
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+/*The runs have to give the same result as calling the masks on the whole line*/
+void test_draw_mask_span_matches_callbacks(void)
+{
+#if LV_DRAW_COMPLEX
+    static lv_opa_t init[1024];
+    uint32_t set;
+    for(set = 0; set < 300; set++) {
+        uint32_t cnt = rnd(1, MASK_CNT_MAX);
+        uint32_t i;
+        for(i = 0; i < cnt; i++) add_random_mask(set % 2 == 0);
+
+        for(i = 0; i < 200; i++) {
+            lv_coord_t abs_x = rnd(-50, 850);
+            lv_coord_t len = rnd(1, 1000);
+            lv_coord_t abs_y = rnd(-30, 620);
+            lv_coord_t j;
+            /*Full, translucent and random initial values*/
+            int32_t init_type = rnd(0, 2);
+            lv_opa_t opa = init_type == 0 ? LV_OPA_COVER : rnd(1, 254);
+            for(j = 0; j < len; j++) init[j] = init_type == 2 ? rnd(0, 255) : opa;
+            check_line(abs_x, abs_y, len, init);
+        }
+        remove_masks();
+    }
+#endif
+}
+
+/*The runs of the nested rounded masks are drawn like the masks calculated on the whole lines*/
+void test_draw_mask_nested_rounded(void)
+{
+#if LV_DRAW_COMPLEX
+    static lv_color_t ref[FB_W * FB_H];
+    uint32_t fade;
+    for(fade = 0; fade < 2; fade++) {
+        create_nested(fade);
+        refr_all(true);
+        lv_memcpy(ref, test_fb, sizeof(ref));
+        refr_all(false);
+        TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+        lv_obj_clean(lv_scr_act());
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,85 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_lighten(LV_PALETTE_GREY, 2), 0);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+}
+
+#if LV_COLOR_DEPTH == 32 && LV_DRAW_COMPLEX
+
+extern const lv_img_dsc_t img_cogwheel_argb;
+extern const lv_img_dsc_t img_cogwheel_rgb;
+extern const lv_img_dsc_t img_cogwheel_chroma_keyed;
+
+typedef struct {
+    const lv_img_dsc_t * src;
+    int16_t angle;
+    uint16_t zoom;
+    bool aa;
+    lv_opa_t opa;
+} transform_param_t;
+
+static const transform_param_t imgs[] = {
+    {&img_cogwheel_argb, 300, 256, true, LV_OPA_COVER},
+    {&img_cogwheel_argb, 450, 256, false, LV_OPA_COVER},
+    {&img_cogwheel_argb, 0, 180, true, LV_OPA_COVER},
+    {&img_cogwheel_argb, 0, 400, false, LV_OPA_COVER},
+    {&img_cogwheel_argb, 1234, 300, true, LV_OPA_COVER},
+    {&img_cogwheel_argb, 3500, 256, true, LV_OPA_50},
+    {&img_cogwheel_argb, 2700, 256, true, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 300, 256, true, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 450, 256, false, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 0, 180, true, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 0, 400, false, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 1234, 300, true, LV_OPA_COVER},
+    {&img_cogwheel_rgb, 3500, 256, true, LV_OPA_50},
+    {&img_cogwheel_rgb, 1800, 256, true, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 300, 256, true, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 450, 256, false, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 0, 180, true, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 0, 400, false, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 1234, 300, true, LV_OPA_COVER},
+    {&img_cogwheel_chroma_keyed, 3500, 256, true, LV_OPA_50},
+    {&img_cogwheel_chroma_keyed, 900, 256, true, LV_OPA_COVER},
+};
+
+static lv_obj_t * img_create(const transform_param_t * p)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, p->src);
+    lv_img_set_angle(img, p->angle);
+    lv_img_set_zoom(img, p->zoom);
+    lv_img_set_antialias(img, p->aa);
+    lv_obj_set_style_img_opa(img, p->opa, 0);
+    return img;
+}
+
+#endif
+
+/*Rotated and zoomed images with and without anti-aliasing and some of them partly out of the screen*/
+void test_draw_transform_screenshot(void)
+{
+#if LV_COLOR_DEPTH == 32 && LV_DRAW_COMPLEX
+    uint32_t i;
+    for(i = 0; i < sizeof(imgs) / sizeof(imgs[0]); i++) {
+        lv_obj_t * img = img_create(&imgs[i]);
+        lv_obj_set_pos(img, (i % 7) * 115 - 10 + (i / 7) * 20, (i / 7) * 160 + 10 + (i % 7 == 6 ? 350 : 0));
+    }
+
+    transform_param_t big = {&img_cogwheel_argb, 200, 900, true, LV_OPA_COVER};
+    lv_obj_set_pos(img_create(&big), 700, 380);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_transform_1.png");
+#endif
+}
+
+#endif
@@ -0,0 +1,178 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+extern lv_color_t test_fb[];
+
+void setUp(void)
+{
+#if LV_USE_FONT_COMPRESSED
+    lv_font_fmt_txt_set_cache_size(0);
+    lv_font_fmt_txt_set_cache_size(LV_FONT_COMPR_CACHE_DEF_SIZE);
+    lv_font_fmt_txt_reset_cache_stats();
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_FONT_COMPRESSED
+    lv_font_fmt_txt_set_cache_size(LV_FONT_COMPR_CACHE_DEF_SIZE);
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+
+#define LABEL_FRAMES    5
+
+static const char * test_letters = "0123456789:ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+static uint32_t get_bitmap_size(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, letter, 0);
+    return (g.box_w * g.box_h * (g.bpp == 3 ? 4 : g.bpp) + 7) / 8;
+}
+
+/*Draw a few frames of a label and keep the last one in `fb`*/
+static void render_label_frames(lv_color_t * fb)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_obj_set_width(label, 700);
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog. 0123456789 "
+                      "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG.");
+
+    uint32_t i;
+    for(i = 0; i < LABEL_FRAMES; i++) {
+        /*Flush the whole screen to `test_fb`*/
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    lv_memcpy(fb, test_fb, LV_HOR_RES * LV_VER_RES * sizeof(lv_color_t));
+
+    lv_obj_del(label);
+}
+
+#endif
+
+void test_font_glyph_cache_matches_decompressed(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    static uint8_t ref[64 * 64];
+    const char * c;
+
+    for(c = test_letters; *c; c++) {
+        uint32_t size = get_bitmap_size(font, *c);
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref), size);
+
+        lv_font_fmt_txt_set_cache_size(0);
+        const uint8_t * bmp = lv_font_get_glyph_bitmap(font, *c);
+        TEST_ASSERT_NOT_NULL(bmp);
+        lv_memcpy(ref, bmp, size);
+
+        lv_font_fmt_txt_set_cache_size(LV_FONT_COMPR_CACHE_DEF_SIZE);
+        bmp = lv_font_get_glyph_bitmap(font, *c);   /*Decompressed into the cache*/
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, bmp, size);
+        bmp = lv_font_get_glyph_bitmap(font, *c);   /*Served from the cache*/
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, bmp, size);
+    }
+#endif
+}
+
+void test_font_glyph_cache_hit(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    lv_font_fmt_txt_cache_stats_t stats;
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+
+    lv_font_get_glyph_bitmap(font, 'A');
+    lv_font_get_glyph_bitmap(font, 'B');
+    lv_font_get_glyph_bitmap(font, 'A');
+    lv_font_get_glyph_bitmap(font, 'B');
+
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.misses);
+    TEST_ASSERT_EQUAL(2, stats.hits);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+#endif
+}
+
+void test_font_glyph_cache_respects_budget(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    lv_font_fmt_txt_cache_stats_t stats;
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    const char * c;
+
+    lv_font_fmt_txt_set_cache_size(1024);
+    for(c = test_letters; *c; c++) {
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, *c));
+    }
+
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL(1024, stats.used_bytes);
+    TEST_ASSERT_GREATER_THAN(0, stats.evicted_bytes);
+
+    /*The most recent one is still there*/
+    lv_font_fmt_txt_reset_cache_stats();
+    lv_font_get_glyph_bitmap(font, 'z');
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+
+    /*Dropping the font removes all of its glyphs*/
+    lv_font_fmt_txt_cache_drop(font);
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.used_bytes);
+#endif
+}
+
+void test_font_glyph_cache_freed_on_deinit(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    lv_font_fmt_txt_cache_stats_t stats;
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+
+    /*The cache survives the refreshes*/
+    lv_font_get_glyph_bitmap(font, 'A');
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+
+    _lv_font_deinit_fmt_txt();
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.used_bytes);
+
+    /*And it's created again when needed*/
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, 'A'));
+    lv_font_fmt_txt_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+#endif
+}
+
+/*The glyphs served from the cache are drawn like the decompressed ones*/
+void test_font_glyph_cache_compressed_label(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    static lv_color_t ref_fb[800 * 480];
+    static lv_color_t cache_fb[800 * 480];
+    lv_font_fmt_txt_cache_stats_t stats;
+
+    lv_font_fmt_txt_set_cache_size(0);
+    render_label_frames(ref_fb);
+
+    lv_font_fmt_txt_set_cache_size(64 * 1024);
+    lv_font_fmt_txt_reset_cache_stats();
+    render_label_frames(cache_fb);
+    lv_font_fmt_txt_get_cache_stats(&stats);
+
+    TEST_ASSERT_GREATER_THAN(stats.misses, stats.hits);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, cache_fb, sizeof(ref_fb));
+#endif
+}
+
+#endif
@@ -0,0 +1,312 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_FS_BLOCK_CACHE_SIZE && LV_USE_FS_STDIO && LV_USE_FS_POSIX && LV_FS_POSIX_MMAP && LV_COLOR_DEPTH == 32
+    #define FS_CACHE_TEST   1
+#else
+    #define FS_CACHE_TEST   0
+#endif
+
+#if FS_CACHE_TEST
+
+#include <stdio.h>
+
+#define FONT_PATH       "src/test_fonts/font_1.fnt"
+#define TMP_PATH        "/tmp/lv_test_fs_cache.bin"
+#define LOAD_REPEAT     10
+
+/*'A' (stdio) uses the block cache, 'B' (posix) maps the files*/
+static lv_fs_drv_t * drv_a;
+static lv_fs_drv_t * drv_b;
+static uint16_t cache_size_a;
+static uint16_t cache_size_b;
+static const void * (*map_cb_b)(lv_fs_drv_t *, void *, uint32_t *);
+static lv_fs_res_t (*read_cb_a)(lv_fs_drv_t *, void *, void *, uint32_t, uint32_t *);
+static lv_fs_res_t (*read_cb_b)(lv_fs_drv_t *, void *, void *, uint32_t, uint32_t *);
+static uint32_t drv_read_cnt;
+
+static lv_fs_res_t read_counter_a(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    drv_read_cnt++;
+    return read_cb_a(drv, file_p, buf, btr, br);
+}
+
+static lv_fs_res_t read_counter_b(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    drv_read_cnt++;
+    return read_cb_b(drv, file_p, buf, btr, br);
+}
+
+/*Read a whole file without any caching*/
+static uint8_t * load_uncached(const char * path, uint32_t * size)
+{
+    drv_a->cache_size = 0;
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    TEST_ASSERT_NULL(f.cache);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    uint8_t * data = lv_mem_alloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    uint32_t rn;
+    lv_fs_read(&f, data, *size, &rn);
+    TEST_ASSERT_EQUAL(*size, rn);
+    lv_fs_close(&f);
+    drv_a->cache_size = cache_size_a;
+    return data;
+}
+
+static void check_read(lv_fs_file_t * f, const uint8_t * ref, uint32_t size, uint32_t btr)
+{
+    static uint8_t buf[3 * LV_FS_BLOCK_SIZE + 1];
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(f, &pos));
+
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(f, buf, btr, &br));
+    uint32_t exp_br = pos < size ? LV_MIN(btr, size - pos) : 0;
+    TEST_ASSERT_EQUAL(exp_br, br);
+    if(br) TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + pos, buf, br);
+}
+
+static void write_file(const char * path, uint8_t value, uint32_t size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        uint8_t v = (uint8_t)(value + i);
+        lv_fs_write(&f, &v, 1, NULL);
+    }
+    lv_fs_close(&f);
+}
+
+typedef enum {
+    MODE_NO_CACHE,
+    MODE_BLOCK_CACHE_COLD,
+    MODE_BLOCK_CACHE,
+    MODE_MMAP,
+    _MODE_LAST
+} load_mode_t;
+
+static void decode_img(const char * path)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, path, lv_color_black(), 0));
+    if(dsc.img_data == NULL) {
+        uint8_t * line = lv_mem_alloc(dsc.header.w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+        TEST_ASSERT_NOT_NULL(line);
+        lv_coord_t y;
+        for(y = 0; y < dsc.header.h; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, dsc.header.w, line));
+        }
+        lv_mem_free(line);
+    }
+    lv_img_decoder_close(&dsc);
+}
+
+/**
+ * Load a file a few times from the posix driver, which makes a system call in every read like the drivers of
+ * real storages, and return the average number of driver reads.
+ */
+static uint32_t load_reads(load_mode_t mode, const char * path, bool font)
+{
+    char full_path[64];
+    lv_snprintf(full_path, sizeof(full_path), "B:%s", path);
+    drv_b->cache_size = mode == MODE_BLOCK_CACHE_COLD || mode == MODE_BLOCK_CACHE ? 1 : 0;
+    drv_b->map_cb = mode == MODE_MMAP ? map_cb_b : NULL;
+    lv_fs_block_cache_invalidate(NULL);
+
+    drv_read_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < LOAD_REPEAT; i++) {
+        if(mode == MODE_BLOCK_CACHE_COLD) lv_fs_block_cache_invalidate(NULL);
+        if(font) {
+            lv_font_t * f = lv_font_load(full_path);
+            TEST_ASSERT_NOT_NULL(f);
+            lv_font_free(f);
+        }
+        else {
+            decode_img(full_path);
+        }
+    }
+
+    return drv_read_cnt / LOAD_REPEAT;
+}
+
+static void load_all(const char * path, bool font, uint32_t * reads)
+{
+    uint32_t m;
+    for(m = 0; m < _MODE_LAST; m++) {
+        reads[m] = load_reads(m, path, font);
+    }
+
+    TEST_ASSERT_EQUAL(0, reads[MODE_MMAP]);
+}
+
+#endif
+
+void setUp(void)
+{
+#if FS_CACHE_TEST
+    drv_a = lv_fs_get_drv('A');
+    drv_b = lv_fs_get_drv('B');
+    cache_size_a = drv_a->cache_size;
+    cache_size_b = drv_b->cache_size;
+    map_cb_b = drv_b->map_cb;
+    read_cb_a = drv_a->read_cb;
+    read_cb_b = drv_b->read_cb;
+    drv_a->read_cb = read_counter_a;
+    drv_b->read_cb = read_counter_b;
+    lv_fs_block_cache_invalidate(NULL);
+#endif
+}
+
+void tearDown(void)
+{
+#if FS_CACHE_TEST
+    drv_a->cache_size = cache_size_a;
+    drv_b->cache_size = cache_size_b;
+    drv_b->map_cb = map_cb_b;
+    drv_a->read_cb = read_cb_a;
+    drv_b->read_cb = read_cb_b;
+    lv_img_cache_invalidate_src(NULL);
+#endif
+}
+
+/*Read with random seeks and sizes from cached, mapped and simultaneously opened files*/
+void test_fs_cache_random_read(void)
+{
+#if FS_CACHE_TEST
+    uint32_t size;
+    uint8_t * ref = load_uncached("A:" FONT_PATH, &size);
+
+    lv_fs_file_t f[3];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[0], "A:" FONT_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[1], "A:" FONT_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[2], "B:" FONT_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_NULL(lv_fs_get_map(&f[0], NULL));
+    TEST_ASSERT_NOT_NULL(lv_fs_get_map(&f[2], NULL));
+
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 3000; i++) {
+        seed = seed * 1103515245 + 12345;
+        lv_fs_file_t * fp = &f[(seed >> 8) % 3];
+        uint32_t r = seed >> 12;
+        uint32_t pos;
+        switch(r % 8) {
+            case 0:
+                lv_fs_seek(fp, (r >> 3) % (size + 10), LV_FS_SEEK_SET);
+                break;
+            case 1:
+                lv_fs_seek(fp, 0, LV_FS_SEEK_END);
+                TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(fp, &pos));
+                TEST_ASSERT_EQUAL(size, pos);
+                lv_fs_seek(fp, size - (r >> 3) % size, LV_FS_SEEK_SET);
+                break;
+            case 2:
+                lv_fs_seek(fp, (r >> 3) % 100, LV_FS_SEEK_CUR);
+                break;
+        }
+
+        /*Mostly small reads like the font loader's, sometimes over several blocks*/
+        uint32_t btr = (r >> 5) % 4 == 0 ? (r >> 7) % (3 * LV_FS_BLOCK_SIZE + 1) : (r >> 7) % 16;
+        check_read(fp, ref, size, btr);
+    }
+
+    for(i = 0; i < 3; i++) lv_fs_close(&f[i]);
+    lv_mem_free(ref);
+
+    lv_fs_block_cache_stats_t stats;
+    lv_fs_block_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats.miss_cnt, stats.hit_cnt);
+#endif
+}
+
+/*Writing a file drops its cached blocks*/
+void test_fs_cache_write_invalidates(void)
+{
+#if FS_CACHE_TEST
+    uint32_t size = LV_FS_BLOCK_SIZE * 2 + 10;
+    uint8_t buf[LV_FS_BLOCK_SIZE * 2 + 10];
+    uint32_t pass;
+    for(pass = 0; pass < 2; pass++) {
+        write_file("A:" TMP_PATH, pass * 100, size);
+
+        lv_fs_file_t f;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "A:" TMP_PATH, LV_FS_MODE_RD));
+        uint32_t i;
+        for(i = 0; i < size; i += 7) {
+            uint32_t br;
+            lv_fs_read(&f, buf, 7, &br);
+            TEST_ASSERT_EQUAL(LV_MIN(7, size - i), br);
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)(pass * 100 + i), buf[0]);
+        }
+        lv_fs_close(&f);
+    }
+
+    remove(TMP_PATH);
+#endif
+}
+
+/*Blocks loaded by a reader while the file is opened for writing are dropped on the next write too*/
+void test_fs_cache_write_while_reading(void)
+{
+#if FS_CACHE_TEST
+    static uint8_t buf[8192];   /*Large enough for stdio to write it without buffering*/
+    uint32_t size = sizeof(buf);
+    uint32_t i;
+    lv_fs_file_t rd;
+    lv_fs_file_t wr;
+    uint32_t br;
+    uint32_t pass;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&wr, "A:" TMP_PATH, LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&rd, "A:" TMP_PATH, LV_FS_MODE_RD));
+    for(pass = 0; pass < 2; pass++) {
+        for(i = 0; i < size; i++) buf[i] = (uint8_t)(pass * 100 + i);
+        lv_fs_seek(&wr, 0, LV_FS_SEEK_SET);
+        lv_fs_write(&wr, buf, size, NULL);
+
+        /*Small reads to go through the block cache*/
+        lv_fs_seek(&rd, 0, LV_FS_SEEK_SET);
+        for(i = 0; i < size; i += 16) {
+            uint8_t part[16];
+            lv_fs_read(&rd, part, 16, &br);
+            TEST_ASSERT_EQUAL(16, br);
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)(pass * 100 + i), part[0]);
+        }
+    }
+    lv_fs_close(&wr);
+    lv_fs_close(&rd);
+
+    remove(TMP_PATH);
+#endif
+}
+
+void test_fs_cache_font_loading(void)
+{
+#if FS_CACHE_TEST
+    uint32_t reads[_MODE_LAST];
+    load_all(FONT_PATH, true, reads);
+
+    /*The font loader reads a few bytes at a time. The whole font fits into the cache.*/
+    TEST_ASSERT_LESS_THAN(reads[MODE_NO_CACHE] / 100, reads[MODE_BLOCK_CACHE_COLD]);
+    TEST_ASSERT_LESS_OR_EQUAL(1, reads[MODE_BLOCK_CACHE]);
+#endif
+}
+
+void test_fs_cache_img_decoding(void)
+{
+#if FS_CACHE_TEST
+    uint32_t reads[_MODE_LAST];
+    load_all("../examples/libs/png/wink.png", false, reads);
+    load_all("../examples/libs/bmp/example_32bit.bmp", false, reads);
+    load_all("../examples/libs/sjpg/small_image.sjpg", false, reads);
+#endif
+}
+
+#endif
@@ -0,0 +1,110 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+extern const lv_img_dsc_t img_bulb_gif;
+
+static uint32_t refr_px;
+static uint32_t refr_cnt;
+
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(time);
+    refr_px += px;
+    refr_cnt++;
+}
+
+/*Play the GIF for a while and check that less pixels are redrawn in a refresh than the whole image*/
+static void play(const void * src, const char * name)
+{
+    lv_obj_t * obj = lv_gif_create(lv_scr_act());
+    lv_gif_set_src(obj, src);
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    TEST_ASSERT_NOT_NULL(gifobj->gif);
+    lv_refr_now(NULL);
+
+    refr_px = 0;
+    refr_cnt = 0;
+    uint32_t t;
+    for(t = 0; t < 3000; t += 10) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+
+    uint32_t img_px = gifobj->gif->width * gifobj->gif->height;
+    TEST_ASSERT_GREATER_THAN_MESSAGE(0, refr_cnt, name);
+    TEST_ASSERT_LESS_THAN_MESSAGE(img_px, refr_px / refr_cnt, name);
+
+    lv_obj_del(obj);
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_USE_GIF
+    lv_disp_get_default()->driver->monitor_cb = monitor_cb;
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_GIF
+    lv_disp_get_default()->driver->monitor_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+#endif
+}
+
+/*Every pixel changed by a frame has to be in the dirty area*/
+void test_gif_dirty_area_covers_the_changes(void)
+{
+#if LV_USE_GIF
+    gd_GIF * gif = gd_open_gif_data(img_bulb_gif.data);
+    TEST_ASSERT_NOT_NULL(gif);
+
+    uint32_t px_cnt = gif->width * gif->height;
+    uint8_t * prev = lv_mem_alloc(px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    TEST_ASSERT_NOT_NULL(prev);
+    lv_memcpy(prev, gif->canvas, px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    uint32_t dirty_sum = 0;
+    uint32_t frame;
+    for(frame = 0; frame < 40; frame++) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+        gd_render_frame(gif, gif->canvas);
+
+        int32_t x, y;
+        for(y = 0; y < gif->height; y++) {
+            for(x = 0; x < gif->width; x++) {
+                uint32_t i = (y * gif->width + x) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                if(memcmp(&prev[i], &gif->canvas[i], LV_IMG_PX_SIZE_ALPHA_BYTE) == 0) continue;
+                TEST_ASSERT_TRUE(x >= gif->dirty_x1 && x <= gif->dirty_x2);
+                TEST_ASSERT_TRUE(y >= gif->dirty_y1 && y <= gif->dirty_y2);
+            }
+        }
+        if(gif->dirty_x2 >= gif->dirty_x1) {
+            dirty_sum += (gif->dirty_x2 - gif->dirty_x1 + 1) * (gif->dirty_y2 - gif->dirty_y1 + 1);
+        }
+        lv_memcpy(prev, gif->canvas, px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    }
+
+    TEST_ASSERT_LESS_THAN(px_cnt * 40, dirty_sum);
+
+    lv_mem_free(prev);
+    gd_close_gif(gif);
+#endif
+}
+
+void test_gif_redraws_only_the_changes(void)
+{
+#if LV_USE_GIF
+    play(&img_bulb_gif, "img_bulb_gif");
+    play("A:../examples/libs/gif/bulb.gif", "bulb.gif");
+#endif
+}
+
+#endif
@@ -0,0 +1,120 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define GRAD_CNT        64
+#define ROUNDS          200
+
+static lv_grad_dsc_t grads[GRAD_CNT];
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < GRAD_CNT; i++) {
+        lv_memset_00(&grads[i], sizeof(grads[i]));
+        grads[i].dir = LV_GRAD_DIR_VER;
+        grads[i].stops_count = 2;
+        grads[i].stops[0].color = lv_color_hex(0x000000 + i);
+        grads[i].stops[0].frac = 0;
+        grads[i].stops[1].color = lv_color_hex(0xffffff - i);
+        grads[i].stops[1].frac = 255;
+    }
+
+    lv_gradient_set_cache_size(8 * 1024);
+    lv_gradient_reset_cache_stats();
+}
+
+void tearDown(void)
+{
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+}
+
+void test_grad_cache_hit(void)
+{
+    lv_grad_cache_stats_t stats;
+
+    lv_grad_t * g1 = lv_gradient_get(&grads[0], 10, 20);
+    lv_grad_t * g2 = lv_gradient_get(&grads[0], 10, 20);
+    TEST_ASSERT_NOT_NULL(g1);
+    TEST_ASSERT_EQUAL_PTR(g1, g2);
+    TEST_ASSERT_EQUAL(20, g1->size);
+
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(1, stats.item_cnt);
+}
+
+void test_grad_cache_evicts_least_recently_used(void)
+{
+    lv_grad_cache_stats_t stats;
+    uint32_t i;
+
+    /*Fill the cache well beyond its size while keeping the first gradient in use*/
+    for(i = 0; i < GRAD_CNT; i++) {
+        lv_gradient_get(&grads[0], 10, 40);
+        lv_grad_t * g = lv_gradient_get(&grads[i], 10, 40);
+        TEST_ASSERT_NOT_NULL(g);
+        TEST_ASSERT_FALSE(g->not_cached);
+    }
+
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.evicted_items);
+    TEST_ASSERT_GREATER_THAN(0, stats.evicted_bytes);
+    TEST_ASSERT_LESS_OR_EQUAL(8 * 1024, stats.used_bytes);
+
+    /*The recently used ones survived and were moved correctly by the compaction*/
+    lv_gradient_reset_cache_stats();
+    lv_grad_t * g0 = lv_gradient_get(&grads[0], 10, 40);
+    lv_grad_t * gl = lv_gradient_get(&grads[GRAD_CNT - 1], 10, 40);
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hits);
+#if _DITHER_GRADIENT
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(grads[0].stops[1].color), g0->hmap[39].full);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(grads[GRAD_CNT - 1].stops[1].color), gl->hmap[39].full);
+#else
+    TEST_ASSERT_EQUAL_COLOR(grads[0].stops[1].color, g0->map[39]);
+    TEST_ASSERT_EQUAL_COLOR(grads[GRAD_CNT - 1].stops[1].color, gl->map[39]);
+#endif
+
+    /*An old one was evicted*/
+    lv_gradient_get(&grads[1], 10, 40);
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+}
+
+void test_grad_cache_too_large_item(void)
+{
+    lv_grad_cache_stats_t stats;
+
+    lv_grad_t * g = lv_gradient_get(&grads[0], 10, 4000);
+    TEST_ASSERT_NOT_NULL(g);
+    TEST_ASSERT_TRUE(g->not_cached);
+    lv_gradient_cleanup(g);
+
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.item_cnt);
+}
+
+void test_grad_cache_mixed_working_set(void)
+{
+    lv_grad_cache_stats_t stats;
+    uint32_t r, i;
+
+    for(r = 0; r < ROUNDS; r++) {
+        for(i = 0; i < GRAD_CNT; i++) {
+            /*Most lookups hit a small working set, every 4th one is a new gradient*/
+            lv_coord_t h = (i & 0x3) ? 20 : 20 + (lv_coord_t)(r % 50);
+            lv_grad_t * g = lv_gradient_get(&grads[i & 0xF], 10, h);
+            TEST_ASSERT_NOT_NULL(g);
+        }
+    }
+
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(ROUNDS * GRAD_CNT, stats.hits + stats.misses);
+    /*The 3 of 4 lookups of the working set are all hits*/
+    TEST_ASSERT_GREATER_OR_EQUAL(ROUNDS * GRAD_CNT * 3 / 4, stats.hits);
+}
+
+#endif
@@ -0,0 +1,184 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define PNG_SIZE        (50 * 50 * LV_IMG_PX_SIZE_ALPHA_BYTE)
+#define GALLERY_SHOWN   2
+#define GALLERY_ROUNDS  30
+
+#define PNG_SRC         "A:../examples/libs/png/wink.png"
+
+static const void * gallery[] = {
+    PNG_SRC,
+    "A:../examples/libs/sjpg/small_image.sjpg",
+    "A:../examples/libs/bmp/example_24bit.bmp",
+    "A:../examples/libs/bmp/example_32bit.bmp",
+};
+
+#define GALLERY_NUM     (sizeof(gallery) / sizeof(gallery[0]))
+
+static uint8_t px_map[4][4 * 4 * LV_COLOR_SIZE / 8];
+static lv_img_dsc_t imgs[4];
+static uint16_t entry_cnt_in_draw;
+
+static lv_img_cache_stats_t get_stats(void)
+{
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    return stats;
+}
+
+static void draw_post_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    entry_cnt_in_draw = get_stats().entry_cnt;
+}
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        imgs[i].header.cf = LV_IMG_CF_TRUE_COLOR;
+        imgs[i].header.w = 4;
+        imgs[i].header.h = 4;
+        imgs[i].data = px_map[i];
+        imgs[i].data_size = sizeof(px_map[i]);
+    }
+    lv_img_cache_set_size(3);
+    lv_img_cache_set_max_size(0);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_max_size(LV_IMG_CACHE_MAX_BYTES);
+}
+
+void test_img_cache_least_recently_used_is_closed(void)
+{
+    lv_img_cache_stats_t start = get_stats();
+
+    _lv_img_cache_entry_t * e0 = _lv_img_cache_open(&imgs[0], lv_color_black(), 0);
+    _lv_img_cache_open(&imgs[1], lv_color_black(), 0);
+    _lv_img_cache_open(&imgs[2], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL_PTR(e0, _lv_img_cache_open(&imgs[0], lv_color_black(), 0));
+
+    /*imgs[1] is the oldest now*/
+    _lv_img_cache_open(&imgs[3], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL_PTR(e0, _lv_img_cache_open(&imgs[0], lv_color_black(), 0));
+    _lv_img_cache_open(&imgs[2], lv_color_black(), 0);
+
+    lv_img_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(4, stats.miss_cnt - start.miss_cnt);
+    TEST_ASSERT_EQUAL(3, stats.hit_cnt - start.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt - start.evict_cnt);
+    TEST_ASSERT_EQUAL(3, stats.entry_cnt);
+
+    /*The images are drawn from their source so they take no space*/
+    TEST_ASSERT_EQUAL(0, stats.used_size);
+
+    _lv_img_cache_open(&imgs[1], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL(5, get_stats().miss_cnt - start.miss_cnt);
+
+    /*Different color or frame is a different entry*/
+    _lv_img_cache_open(&imgs[1], lv_color_white(), 0);
+    _lv_img_cache_open(&imgs[1], lv_color_black(), 1);
+    TEST_ASSERT_EQUAL(7, get_stats().miss_cnt - start.miss_cnt);
+
+    /*Closes imgs[1] with black color*/
+    _lv_img_cache_open(&imgs[0], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL(8, get_stats().miss_cnt - start.miss_cnt);
+
+    lv_img_cache_invalidate_src(&imgs[1]);
+    TEST_ASSERT_EQUAL(1, get_stats().entry_cnt);
+    lv_img_cache_invalidate_src(NULL);
+    TEST_ASSERT_EQUAL(0, get_stats().entry_cnt);
+}
+
+void test_img_cache_size_limit(void)
+{
+    lv_img_cache_set_max_size(2 * PNG_SIZE);
+
+    _lv_img_cache_open(PNG_SRC, lv_color_black(), 0);
+    _lv_img_cache_open(PNG_SRC, lv_color_white(), 0);
+    lv_img_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(2 * PNG_SIZE, stats.used_size);
+
+    /*Opening a 3rd decoded image closes the oldest even if there is a free entry*/
+    uint32_t evict_start = stats.evict_cnt;
+    _lv_img_cache_open(PNG_SRC, lv_palette_main(LV_PALETTE_RED), 0);
+    stats = get_stats();
+    TEST_ASSERT_EQUAL(2 * PNG_SIZE, stats.used_size);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(evict_start + 1, stats.evict_cnt);
+
+    /*Lowering the limit closes the images right away*/
+    lv_img_cache_set_max_size(PNG_SIZE);
+    TEST_ASSERT_EQUAL(PNG_SIZE, get_stats().used_size);
+}
+
+void test_img_cache_images_on_screen_are_kept(void)
+{
+    lv_img_cache_set_max_size(PNG_SIZE);
+    lv_obj_add_event_cb(lv_scr_act(), draw_post_cb, LV_EVENT_DRAW_POST_END, NULL);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * img = lv_img_create(lv_scr_act());
+        lv_img_set_src(img, PNG_SRC);
+        lv_obj_set_pos(img, i * 60, 0);
+        lv_obj_set_style_img_recolor(img, lv_palette_main(i), 0);
+        lv_obj_set_style_img_recolor_opa(img, LV_OPA_50, 0);
+    }
+
+    lv_img_cache_stats_t start = get_stats();
+    lv_refr_now(NULL);
+
+    /*All 3 were kept while drawing and the limit was applied only at the end*/
+    TEST_ASSERT_EQUAL(3, entry_cnt_in_draw);
+    lv_img_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(3, stats.miss_cnt - start.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(PNG_SIZE, stats.used_size);
+
+    lv_obj_remove_event_cb(lv_scr_act(), draw_post_cb);
+}
+
+/*Return the number of cache misses*/
+static uint32_t show_gallery(uint16_t entry_cnt)
+{
+    lv_img_cache_set_size(entry_cnt);
+
+    lv_obj_t * imgs_shown[GALLERY_SHOWN];
+    uint32_t i;
+    for(i = 0; i < GALLERY_SHOWN; i++) {
+        imgs_shown[i] = lv_img_create(lv_scr_act());
+        lv_obj_set_pos(imgs_shown[i], i * 120, 0);
+    }
+
+    lv_img_cache_stats_t start = get_stats();
+    uint32_t r;
+    for(r = 0; r < GALLERY_ROUNDS; r++) {
+        for(i = 0; i < GALLERY_SHOWN; i++) lv_img_set_src(imgs_shown[i], gallery[(r + i) % GALLERY_NUM]);
+        lv_refr_now(NULL);
+    }
+
+    lv_obj_clean(lv_scr_act());
+    return get_stats().miss_cnt - start.miss_cnt;
+}
+
+/*Show 2 images of a gallery of PNG, BMP and SJPG files and step it by one image in every frame*/
+void test_img_cache_gallery(void)
+{
+    /*Only the images on the screen fit into the cache so they are opened again and again*/
+    uint32_t miss_small = show_gallery(GALLERY_SHOWN);
+
+    /*With all images cached only the first round needs to open them*/
+    uint32_t miss_all = show_gallery(GALLERY_NUM);
+    TEST_ASSERT_EQUAL(GALLERY_NUM, miss_all);
+    TEST_ASSERT_GREATER_THAN(miss_all, miss_small);
+}
+
+#endif
@@ -0,0 +1,201 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+
+#include <unistd.h>
+#include "../../src/extra/libs/png/lodepng.h"
+#include "../../src/draw/sw/lv_draw_sw.h"
+
+/*Large enough to exceed LV_IMG_DECODE_ASYNC_MIN_PX*/
+#define IMG_W   300
+#define IMG_H   200
+
+extern lv_color_t test_fb[];
+
+static uint8_t * png_data;
+static lv_img_dsc_t png_dsc;
+
+static lv_img_cache_stats_t get_stats(void)
+{
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    return stats;
+}
+
+/*Let the decoder thread finish and the timers store its results*/
+static void wait_decoding(void)
+{
+    uint32_t i;
+    for(i = 0; get_stats().decoding_cnt && i < 5000; i++) {
+        usleep(1000);
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL(0, get_stats().decoding_cnt);
+}
+
+static lv_color_t get_center_px(void)
+{
+    /*Redraw the whole screen to have all the pixels in `test_fb`*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    return test_fb[(IMG_H / 2) * LV_HOR_RES + IMG_W / 2];
+}
+
+static void dummy_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    /*Blue with some noise to make the compressed data realistic*/
+    uint8_t * px = lv_mem_alloc(IMG_W * IMG_H * 4);
+    TEST_ASSERT_NOT_NULL(px);
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        seed = seed * 1103515245 + 12345;
+        px[i * 4 + 0] = (seed >> 16) & 0x0f;
+        px[i * 4 + 1] = (seed >> 20) & 0x0f;
+        px[i * 4 + 2] = 0xff - ((seed >> 24) & 0x0f);
+        px[i * 4 + 3] = 0xff;
+    }
+
+    size_t png_size;
+    TEST_ASSERT_EQUAL(0, lodepng_encode32(&png_data, &png_size, px, IMG_W, IMG_H));
+    lv_mem_free(px);
+
+    png_dsc.header.cf = LV_IMG_CF_RAW_ALPHA;
+    png_dsc.header.w = IMG_W;
+    png_dsc.header.h = IMG_H;
+    png_dsc.data_size = png_size;
+    png_dsc.data = png_data;
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    /*The decoder thread might still read the data*/
+    wait_decoding();
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_mem_free(png_data);
+#endif
+}
+
+void test_img_decode_async_placeholder(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    lv_refr_now(NULL);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &png_dsc);
+    lv_obj_set_style_img_placeholder_color(img, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_img_placeholder_opa(img, LV_OPA_COVER, 0);
+
+    lv_img_cache_stats_t stats_start = get_stats();
+
+    /*The first frame doesn't wait for the decoder and shows the placeholder*/
+    lv_refr_now(NULL);
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(&png_dsc, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    if(entry->decoding) {
+        TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), get_center_px());
+    }
+
+    /*The image is stored in the cache and redrawn by the timers*/
+    wait_decoding();
+    TEST_ASSERT_FALSE(entry->decoding);
+    TEST_ASSERT_NULL(entry->dec_dsc.error_msg);
+    TEST_ASSERT_EQUAL(stats_start.used_size + IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE, get_stats().used_size);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000f0), lv_color_hex(lv_color_to32(get_center_px()) & 0xf0f0f0));
+#endif
+}
+
+void test_img_decode_async_close_while_decoding(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &png_dsc);
+    lv_refr_now(NULL);
+
+    /*The result of the decoder is dropped*/
+    lv_img_cache_invalidate_src(&png_dsc);
+    lv_obj_del(img);
+
+    lv_img_cache_stats_t stats_start = get_stats();
+    TEST_ASSERT_EQUAL(1, stats_start.decoding_cnt);
+    wait_decoding();
+
+    lv_img_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(stats_start.used_size, stats.used_size);
+    TEST_ASSERT_EQUAL(stats_start.entry_cnt, stats.entry_cnt);
+#endif
+}
+
+/*The display of the placeholder is removed before the image is decoded*/
+void test_img_decode_async_disp_removed(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    static lv_color_t buf[IMG_W * 20];
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, IMG_W * 20);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = dummy_flush_cb;
+    disp_drv.hor_res = IMG_W;
+    disp_drv.ver_res = IMG_H;
+    disp_drv.draw_ctx_init = lv_draw_sw_init_ctx;
+    disp_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    disp_drv.draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+    lv_disp_t * disp_ori = lv_disp_get_default();
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+
+    lv_obj_t * img = lv_img_create(lv_disp_get_scr_act(disp));
+    lv_img_set_src(img, &png_dsc);
+    lv_refr_now(disp);
+
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(&png_dsc, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_disp_remove(disp);
+    lv_disp_set_default(disp_ori);
+
+    /*The image is stored in the cache but nothing is redrawn on the removed display*/
+    wait_decoding();
+    TEST_ASSERT_FALSE(entry->decoding);
+    TEST_ASSERT_NULL(entry->redraw_disp);
+#endif
+}
+
+/*The decoder thread is stopped and started again while an image is decoded*/
+void test_img_decode_async_deinit_while_decoding(void)
+{
+#if LV_USE_PNG && _LV_IMG_DECODE_ASYNC
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &png_dsc);
+    lv_refr_now(NULL);
+
+    _lv_img_cache_deinit();
+    TEST_ASSERT_EQUAL(0, get_stats().decoding_cnt);
+    TEST_ASSERT_EQUAL(0, get_stats().entry_cnt);
+
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    wait_decoding();
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000f0), lv_color_hex(lv_color_to32(get_center_px()) & 0xf0f0f0));
+#endif
+}
+
+#endif
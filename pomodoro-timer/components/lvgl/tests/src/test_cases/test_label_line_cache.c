@@ -0,0 +1,139 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W        300
+#define CANVAS_H        400
+
+static const char * long_txt =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore "
+    "et dolore magna aliqua.\nUt enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+    "aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum "
+    "dolore eu fugiat nulla pariatur.\n\nExcepteur sint occaecat cupidatat non proident, sunt in culpa qui "
+    "officia deserunt mollit anim id est laborum. Árvíztűrő tükörfúrógép.\n";
+
+static lv_obj_t * label;
+
+void setUp(void)
+{
+    label = lv_label_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_LABEL_LINE_CACHE
+static void assert_size_as_lv_txt(const char * txt, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_txt_lines_t lines;
+    lv_memset_00(&lines, sizeof(lines));
+    lv_point_t ref;
+    lv_point_t res;
+
+    lv_txt_get_size(&ref, txt, &lv_font_montserrat_14, 2, 3, max_w, flag);
+    TEST_ASSERT_TRUE(_lv_txt_lines_update(&lines, txt, &lv_font_montserrat_14, 2, max_w, flag));
+    _lv_txt_lines_get_size(&lines, txt, 3, &res);
+    TEST_ASSERT_EQUAL(ref.x, res.x);
+    TEST_ASSERT_EQUAL(ref.y, res.y);
+    _lv_txt_lines_free(&lines);
+}
+#endif
+
+void test_label_line_cache_size(void)
+{
+#if LV_LABEL_LINE_CACHE
+    assert_size_as_lv_txt("", 100, LV_TEXT_FLAG_NONE);
+    assert_size_as_lv_txt("A", 100, LV_TEXT_FLAG_NONE);
+    assert_size_as_lv_txt("A\n", 100, LV_TEXT_FLAG_NONE);
+    assert_size_as_lv_txt("#ff0000 red# text\nsecond line", 60, LV_TEXT_FLAG_RECOLOR);
+    assert_size_as_lv_txt(long_txt, 150, LV_TEXT_FLAG_NONE);
+    assert_size_as_lv_txt(long_txt, LV_COORD_MAX, LV_TEXT_FLAG_FIT);
+    assert_size_as_lv_txt(long_txt, 150, LV_TEXT_FLAG_EXPAND);
+#endif
+}
+
+void test_label_line_cache_follows_changes(void)
+{
+    lv_point_t ref;
+#if LV_FONT_MONTSERRAT_18
+    const lv_font_t * font = &lv_font_montserrat_18;
+#else
+    const lv_font_t * font = LV_FONT_DEFAULT;
+#endif
+    lv_obj_set_width(label, 200);
+    lv_label_set_text(label, long_txt);
+    lv_obj_update_layout(label);
+    lv_txt_get_size(&ref, long_txt, &lv_font_montserrat_14, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.y, lv_obj_get_height(label));
+
+    /*Width change*/
+    lv_obj_set_width(label, 120);
+    lv_obj_update_layout(label);
+    lv_txt_get_size(&ref, long_txt, &lv_font_montserrat_14, 0, 0, 120, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.y, lv_obj_get_height(label));
+
+    /*Letter space and font change*/
+    lv_obj_set_style_text_letter_space(label, 3, 0);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_update_layout(label);
+    lv_txt_get_size(&ref, long_txt, font, 3, 0, 120, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.y, lv_obj_get_height(label));
+
+    /*Text change*/
+    lv_label_set_text(label, "Short");
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL(lv_font_get_line_height(font), lv_obj_get_height(label));
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "\nlines");
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL(2 * lv_font_get_line_height(font), lv_obj_get_height(label));
+
+    /*Content sized label*/
+    lv_obj_set_width(label, LV_SIZE_CONTENT);
+    lv_obj_update_layout(label);
+    lv_txt_get_size(&ref, "Short\nlines", font, 3, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.x, lv_obj_get_width(label));
+}
+
+void test_label_line_cache_draws_the_same(void)
+{
+#if LV_LABEL_LINE_CACHE
+    static lv_color_t buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR(CANVAS_W, CANVAS_H)];
+    static lv_color_t ref_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR(CANVAS_W, CANVAS_H)];
+    lv_text_align_t aligns[] = {LV_TEXT_ALIGN_LEFT, LV_TEXT_ALIGN_CENTER, LV_TEXT_ALIGN_RIGHT};
+    lv_coord_t ofs_y[] = {0, -100};
+
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+    lv_txt_lines_t lines;
+    lv_memset_00(&lines, sizeof(lines));
+    TEST_ASSERT_TRUE(_lv_txt_lines_update(&lines, long_txt, &lv_font_montserrat_14, 0, CANVAS_W - 20,
+                                          LV_TEXT_FLAG_NONE));
+
+    uint32_t a, o;
+    for(a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+        for(o = 0; o < sizeof(ofs_y) / sizeof(ofs_y[0]); o++) {
+            lv_draw_label_dsc_t dsc;
+            lv_draw_label_dsc_init(&dsc);
+            dsc.align = aligns[a];
+            dsc.ofs_y = ofs_y[o];
+
+            lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+            lv_canvas_draw_text(canvas, 10, 10, CANVAS_W - 20, &dsc, long_txt);
+            lv_memcpy(ref_buf, buf, sizeof(buf));
+
+            dsc.lines = &lines;
+            lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+            lv_canvas_draw_text(canvas, 10, 10, CANVAS_W - 20, &dsc, long_txt);
+            TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf, sizeof(buf));
+        }
+    }
+
+    _lv_txt_lines_free(&lines);
+#endif
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "unity/unity.h"
 
+#define CHURN_ROUNDS    50
+#define CHURN_OBJS      40
+#define BUF_FRAMES      50
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -23,4 +27,280 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+#if _LV_MEM_SLAB
+
+static uint32_t slab_used_cnt(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < _LV_MEM_SLAB_CLASS_NUM; i++) cnt += mon.slab[i].used_cnt;
+    return cnt;
+}
+
+#endif
+
+void test_mem_slab_alloc_free(void)
+{
+#if _LV_MEM_SLAB
+    static uint8_t * bufs[128];
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    uint32_t used_start = slab_used_cnt();
+
+    uint32_t i;
+    for(i = 0; i < 128; i++) {
+        bufs[i] = lv_mem_alloc(i + 1);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        lv_memset(bufs[i], (uint8_t)i, i + 1);
+    }
+    TEST_ASSERT_EQUAL(used_start + 128, slab_used_cnt());
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(16, mon.slab[0].size);
+    TEST_ASSERT_EQUAL(128, mon.slab[7].size);
+    TEST_ASSERT_GREATER_OR_EQUAL(mon_start.slab[7].alloc_cnt + 16, mon.slab[7].alloc_cnt);
+
+    /*Free every second then check the others are untouched*/
+    for(i = 0; i < 128; i += 2) lv_mem_free(bufs[i]);
+    for(i = 1; i < 128; i += 2) {
+        uint32_t j;
+        for(j = 0; j <= i; j++) TEST_ASSERT_EQUAL_UINT8(i, bufs[i][j]);
+        lv_mem_free(bufs[i]);
+    }
+
+    TEST_ASSERT_EQUAL(used_start, slab_used_cnt());
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(mon_start.slab_free_page_cnt, mon.slab_free_page_cnt);
+#endif
+}
+
+void test_mem_slab_realloc(void)
+{
+#if _LV_MEM_SLAB
+    uint8_t * p = lv_mem_alloc(10);
+    uint32_t i;
+    for(i = 0; i < 10; i++) p[i] = i;
+
+    /*In the same size class*/
+    TEST_ASSERT_EQUAL_PTR(p, lv_mem_realloc(p, 16));
+
+    /*To an other class then to the heap*/
+    p = lv_mem_realloc(p, 100);
+    for(i = 10; i < 100; i++) p[i] = i;
+    p = lv_mem_realloc(p, 1000);
+    for(i = 0; i < 100; i++) TEST_ASSERT_EQUAL_UINT8(i, p[i]);
+
+    /*Back to a slab*/
+    uint8_t * small = lv_mem_realloc(NULL, 20);
+    lv_memcpy(small, p, 20);
+    lv_mem_free(p);
+    small = lv_mem_realloc(small, 40);
+    for(i = 0; i < 20; i++) TEST_ASSERT_EQUAL_UINT8(i, small[i]);
+    lv_mem_free(small);
+#endif
+}
+
+void test_mem_slab_full_falls_back_to_the_heap(void)
+{
+#if _LV_MEM_SLAB
+    static void * bufs[LV_MEM_SLAB_SIZE / 128 + 16];
+    uint32_t n = sizeof(bufs) / sizeof(bufs[0]);
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        bufs[i] = lv_mem_alloc(128);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.slab_free_page_cnt);
+    TEST_ASSERT_GREATER_THAN(mon_start.slab[7].fallback_cnt, mon.slab[7].fallback_cnt);
+
+    for(i = 0; i < n; i++) lv_mem_free(bufs[i]);
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.slab_free_page_cnt, mon.slab_free_page_cnt);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+#endif
+}
+
+void test_mem_buf_arena(void)
+{
+    lv_mem_buf_free_all();
+
+    lv_mem_buf_monitor_t mon;
+    uint8_t * b1 = lv_mem_buf_get(100);
+    uint8_t * b2 = lv_mem_buf_get(200);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.arena_size);
+    TEST_ASSERT_EQUAL(2, mon.alloc_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(300, mon.high_water);
+    lv_mem_buf_release(b1);
+    lv_mem_buf_release(b2);
+
+    /*The arena grows at the end of the refresh and serves the next buffers*/
+    _lv_mem_buf_frame_end();
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_GREATER_OR_EQUAL(300, mon.arena_size);
+    TEST_ASSERT_LESS_OR_EQUAL(mon.high_water, mon.arena_size);
+    TEST_ASSERT_EQUAL(3, mon.alloc_cnt);
+
+    b1 = lv_mem_buf_get(100);
+    b2 = lv_mem_buf_get(200);
+    TEST_ASSERT_TRUE(b2 >= b1 + 100);
+    lv_memset_ff(b1, 100);
+    lv_memset_00(b2, 200);
+    TEST_ASSERT_EQUAL_HEX8(0xff, b1[99]);
+
+    /*Releasing the last buffer makes its space available again*/
+    lv_mem_buf_release(b2);
+    uint8_t * b3 = lv_mem_buf_get(150);
+    TEST_ASSERT_EQUAL_PTR(b2, b3);
+
+    /*A buffer released in the middle keeps its space until the ones above it are released too*/
+    lv_mem_buf_release(b1);
+    b1 = lv_mem_buf_get(16);
+    TEST_ASSERT_TRUE(b1 >= b3 + 150);
+    lv_mem_buf_release(b1);
+    lv_mem_buf_release(b3);
+
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(3, mon.alloc_cnt);
+
+    lv_mem_buf_free_all();
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.arena_size);
+}
+
+#if LV_MEM_BUF_SHRINK_FRAMES
+/*A frame needing one buffer of `size` bytes*/
+static void buf_frame(uint32_t size)
+{
+    lv_mem_buf_release(lv_mem_buf_get(size));
+    _lv_mem_buf_frame_end();
+}
+#endif
+
+void test_mem_buf_arena_shrink(void)
+{
+#if LV_MEM_BUF_SHRINK_FRAMES
+    lv_mem_buf_free_all();
+
+    lv_mem_buf_monitor_t mon;
+    buf_frame(1000);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, mon.arena_size);
+    uint32_t arena_size = mon.arena_size;
+
+    /*Smaller frames keep the arena for a while*/
+    uint32_t i;
+    for(i = 0; i < LV_MEM_BUF_SHRINK_FRAMES - 1; i++) {
+        buf_frame(i % 2 ? 100 : 200);
+        /*Nothing to draw*/
+        _lv_mem_buf_frame_end();
+    }
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(arena_size, mon.arena_size);
+
+    /*Then it shrinks to the largest of them*/
+    buf_frame(100);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_GREATER_OR_EQUAL(200, mon.arena_size);
+    TEST_ASSERT_LESS_THAN(arena_size, mon.arena_size);
+    arena_size = mon.arena_size;
+
+    /*A frame using the whole arena restarts the counting*/
+    for(i = 0; i < LV_MEM_BUF_SHRINK_FRAMES - 1; i++) buf_frame(100);
+    buf_frame(200);
+    for(i = 0; i < LV_MEM_BUF_SHRINK_FRAMES - 1; i++) buf_frame(100);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(arena_size, mon.arena_size);
+
+    lv_mem_buf_free_all();
+#endif
+}
+
+/*Redraw the screen a few times and return the number of buffers allocated from the heap*/
+static uint32_t redraw_allocs(lv_obj_t * scr, bool free_all)
+{
+    lv_mem_buf_monitor_t mon;
+    lv_mem_buf_monitor(&mon);
+    uint32_t alloc_start = mon.alloc_cnt;
+
+    uint32_t i;
+    for(i = 0; i < BUF_FRAMES; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+        /*It was done after each refresh before the arena*/
+        if(free_all) lv_mem_buf_free_all();
+    }
+
+    lv_mem_buf_monitor(&mon);
+    return mon.alloc_cnt - alloc_start;
+}
+
+/*Redraw a screen with rounded, shadowed and masked widgets*/
+void test_mem_buf_frames(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * btn = lv_btn_create(scr);
+        lv_obj_set_pos(btn, (i % 4) * 190 + 10, (i / 4) * 150 + 10);
+        lv_obj_set_size(btn, 170, 60);
+        lv_obj_set_style_radius(btn, 20, 0);
+        lv_obj_set_style_shadow_width(btn, 15, 0);
+        lv_label_set_text(lv_label_create(btn), "Button");
+        lv_obj_t * arc = lv_arc_create(scr);
+        lv_obj_set_pos(arc, (i % 4) * 190 + 60, (i / 4) * 150 + 80);
+        lv_obj_set_size(arc, 60, 60);
+    }
+
+    /*Warm up, then the arena serves all buffers*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, redraw_allocs(scr, false));
+    TEST_ASSERT_GREATER_THAN(0, redraw_allocs(scr, true));
+
+    lv_obj_clean(scr);
+}
+
+/*Create and delete a screen full of widgets, like when switching screens*/
+void test_mem_create_delete_churn(void)
+{
+    uint32_t r;
+    for(r = 0; r < CHURN_ROUNDS; r++) {
+        lv_obj_t * scr = lv_obj_create(NULL);
+        uint32_t i;
+        for(i = 0; i < CHURN_OBJS; i++) {
+            lv_obj_t * btn = lv_btn_create(scr);
+            lv_obj_set_style_bg_color(btn, lv_palette_main(i % 10), 0);
+            lv_obj_t * label = lv_label_create(btn);
+            lv_label_set_text_fmt(label, "Button %d", (int)i);
+            lv_slider_create(scr);
+        }
+        lv_obj_update_layout(scr);
+        lv_obj_del(scr);
+    }
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+
+    /*Only the allocator with the typical small sizes*/
+    static void * bufs[256];
+    uint32_t i;
+    for(r = 0; r < CHURN_ROUNDS * 20; r++) {
+        for(i = 0; i < 256; i++) {
+            bufs[i] = lv_mem_alloc(8 + (i * 37) % 120);
+            TEST_ASSERT_NOT_NULL(bufs[i]);
+        }
+        for(i = 0; i < 256; i++) lv_mem_free(bufs[(i * 7) % 256]);
+    }
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
 #endif
@@ -0,0 +1,219 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    lv_obj_retain_set_cache_size(LV_OBJ_RETAIN_CACHE_SIZE);
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_OBJ_RETAIN_CACHE_SIZE
+
+#define FB_W            800
+#define FB_H            480
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * panels[2];
+static lv_obj_t * value_label;
+
+static lv_obj_t * panel_create(lv_coord_t x, lv_coord_t y, lv_coord_t radius)
+{
+    lv_obj_t * panel = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(panel, x, y);
+    lv_obj_set_size(panel, 320, 280);
+    lv_obj_set_style_radius(panel, radius, 0);
+    lv_obj_set_style_bg_grad_color(panel, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_bg_grad_dir(panel, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_scrollbar_mode(panel, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * arc = lv_arc_create(panel);
+        lv_obj_set_size(arc, 100, 100);
+        lv_obj_set_pos(arc, (i % 2) * 150, (i / 2) * 125);
+        lv_arc_set_value(arc, 20 + i * 20);
+
+        lv_obj_t * label = lv_label_create(panel);
+        lv_label_set_text_fmt(label, "Ring %d", i);
+        lv_obj_align_to(label, arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
+    }
+
+    return panel;
+}
+
+/*Two static panels full of decorations and a changing label above them*/
+static void create_scene(void)
+{
+    /*A panel which covers its area and a rounded one with shadow to need an image with alpha channel*/
+    panels[0] = panel_create(40, 100, 0);
+    panels[1] = panel_create(440, 100, 30);
+    lv_obj_set_style_shadow_width(panels[1], 20, 0);
+    lv_obj_set_style_shadow_ofs_y(panels[1], 5, 0);
+
+    value_label = lv_label_create(lv_scr_act());
+    lv_label_set_text(value_label, "25:00");
+#if LV_FONT_MONTSERRAT_48
+    lv_obj_set_style_text_font(value_label, &lv_font_montserrat_48, 0);
+#endif
+    lv_obj_align(value_label, LV_ALIGN_TOP_MID, 0, 20);
+}
+
+static void panels_retain(bool en)
+{
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(en) lv_obj_add_flag(panels[i], LV_OBJ_FLAG_RETAIN_LAYER);
+        else lv_obj_clear_flag(panels[i], LV_OBJ_FLAG_RETAIN_LAYER);
+    }
+}
+
+static void refr_all(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*The largest difference of a color channel*/
+static uint32_t max_diff(const lv_color_t * ref, const lv_color_t * act)
+{
+    uint32_t max = 0;
+    uint32_t i;
+    for(i = 0; i < FB_W * FB_H; i++) {
+        uint32_t diff = LV_MAX(LV_ABS(LV_COLOR_GET_R(ref[i]) - LV_COLOR_GET_R(act[i])),
+                               LV_ABS(LV_COLOR_GET_B(ref[i]) - LV_COLOR_GET_B(act[i])));
+        diff = LV_MAX(diff, (uint32_t)LV_ABS(LV_COLOR_GET_G(ref[i]) - LV_COLOR_GET_G(act[i])));
+        if(diff > max) max = diff;
+    }
+    return max;
+}
+
+#endif
+
+/*The retained objects look the same as the normally drawn ones*/
+void test_obj_retain_golden(void)
+{
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    static lv_color_t ref[FB_W * FB_H];
+    create_scene();
+    TEST_ASSERT_EQUAL_SCREENSHOT("obj_retain_1.png");
+
+    /*The image of a covering object has no alpha channel and it's blended exactly*/
+    lv_obj_add_flag(panels[0], LV_OBJ_FLAG_RETAIN_LAYER);
+    TEST_ASSERT_EQUAL_SCREENSHOT("obj_retain_1.png");
+
+    /*Rendering into an image with alpha channel rounds a little differently*/
+    lv_memcpy(ref, test_fb, sizeof(ref));
+    panels_retain(true);
+    refr_all();
+    TEST_ASSERT_LESS_OR_EQUAL(3, max_diff(ref, test_fb));
+
+    /*Drawn from the cache*/
+    lv_memcpy(ref, test_fb, sizeof(ref));
+    refr_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref, test_fb, sizeof(ref));
+
+    lv_obj_retain_stats_t stats;
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stats.used);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.size, stats.used);
+#endif
+}
+
+/*Only a change in the retained object renders it again*/
+void test_obj_retain_invalidate(void)
+{
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    static lv_color_t ref[FB_W * FB_H];
+    create_scene();
+    panels_retain(true);
+    refr_all();
+
+    lv_obj_retain_stats_t start;
+    lv_obj_retain_get_stats(&start);
+
+    /*Changing an object out of the panels doesn't render them again*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_label_set_text_fmt(value_label, "24:%02d", 59 - i);
+        refr_all();
+    }
+
+    lv_obj_retain_stats_t stats;
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(start.render_cnt, stats.render_cnt);
+    TEST_ASSERT_EQUAL(start.hit_cnt + 10, stats.hit_cnt);
+
+    /*Changing a child renders only its panel again*/
+    lv_obj_t * arc = lv_obj_get_child(panels[1], 0);
+    lv_arc_set_value(arc, 90);
+    refr_all();
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(start.inv_cnt + 1, stats.inv_cnt);
+    TEST_ASSERT_EQUAL(start.render_cnt + 1, stats.render_cnt);
+    lv_memcpy(ref, test_fb, sizeof(ref));
+
+    /*And it looks the same as without caching*/
+    panels_retain(false);
+    refr_all();
+    TEST_ASSERT_LESS_OR_EQUAL(3, max_diff(ref, test_fb));
+
+    /*Removing the flag frees the images*/
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.used);
+#endif
+}
+
+/*The least recently drawn images are freed to keep the budget and the objects which don't fit are drawn normally*/
+void test_obj_retain_budget(void)
+{
+#if LV_OBJ_RETAIN_CACHE_SIZE
+    create_scene();
+    panels_retain(true);
+    refr_all();
+
+    lv_obj_retain_stats_t stats;
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    uint32_t used_both = stats.used;
+
+    /*Only one of them fits*/
+    lv_obj_retain_set_cache_size(used_both - 1);
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+
+    refr_all();
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(used_both - 1, stats.used);
+
+    /*None of them fits*/
+    lv_obj_retain_set_cache_size(1000);
+    refr_all();
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.used);
+    TEST_ASSERT_EQUAL_SCREENSHOT("obj_retain_1.png");
+
+    /*Deleting the object frees its image*/
+    lv_obj_retain_set_cache_size(LV_OBJ_RETAIN_CACHE_SIZE);
+    refr_all();
+    lv_obj_del(panels[0]);
+    lv_obj_retain_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+#endif
+}
+
+#endif
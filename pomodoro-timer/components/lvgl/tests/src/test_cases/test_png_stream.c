@@ -0,0 +1,301 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+#if LV_USE_PNG
+    lv_png_set_stream_min_px(LV_PNG_STREAM_MIN_PX);
+#endif
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+
+#include "../../src/extra/libs/png/lodepng.h"
+
+#define GEN_W   123
+#define GEN_H   77
+
+typedef struct {
+    LodePNGColorType type;
+    uint8_t depth;
+    uint8_t trns;
+} png_format_t;
+
+static const png_format_t formats[] = {
+    {LCT_GREY, 1, 0}, {LCT_GREY, 2, 0}, {LCT_GREY, 4, 1}, {LCT_GREY, 8, 1}, {LCT_GREY, 16, 1},
+    {LCT_RGB, 8, 0}, {LCT_RGB, 8, 1}, {LCT_RGB, 16, 1},
+    {LCT_PALETTE, 1, 0}, {LCT_PALETTE, 2, 0}, {LCT_PALETTE, 4, 1}, {LCT_PALETTE, 8, 1},
+    {LCT_GREY_ALPHA, 8, 0}, {LCT_GREY_ALPHA, 16, 0},
+    {LCT_RGBA, 8, 0}, {LCT_RGBA, 16, 0},
+};
+
+static const char * ref_imgs[] = {"dropdown_1.png", "dropdown_2.png", "scr1.png", "table_1.png"};
+
+static uint32_t get_peak_since_reset(uint32_t used_start)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.max_used - used_start;
+}
+
+static uint32_t get_used(void)
+{
+    lv_mem_monitor_reset_max();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.max_used;
+}
+
+/*Encode a noisy image in the given format. Flat areas are added to make the compressor use matches too.*/
+static uint8_t * encode(const png_format_t * f, uint8_t interlace, size_t * size)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.encoder.auto_convert = 0;
+    state.info_png.interlace_method = interlace;
+    state.info_raw.colortype = f->type;
+    state.info_raw.bitdepth = f->depth;
+    state.info_png.color.colortype = f->type;
+    state.info_png.color.bitdepth = f->depth;
+
+    uint32_t bits = lodepng_get_bpp(&state.info_raw);
+    uint32_t stride = (GEN_W * bits + 7) / 8;
+    uint8_t * raw = lv_mem_alloc(stride * GEN_H);
+    uint32_t seed = f->type * 100 + f->depth;
+    uint32_t i;
+    for(i = 0; i < stride * GEN_H; i++) {
+        seed = seed * 1103515245 + 12345;
+        raw[i] = (i / stride) % 8 < 4 ? (seed >> 16) & 0xff : (uint8_t)(i / stride);
+    }
+
+    if(f->type == LCT_PALETTE) {
+        for(i = 0; i < (1U << f->depth); i++) {
+            uint8_t a = f->trns ? (uint8_t)(i * 37) : 0xff;
+            lodepng_palette_add(&state.info_raw, i * 11, i * 23, 255 - i * 5, a);
+            lodepng_palette_add(&state.info_png.color, i * 11, i * 23, 255 - i * 5, a);
+        }
+    }
+    else if(f->trns) {
+        /*The first pixel is the transparent color*/
+        LodePNGColorMode * modes[2] = {&state.info_raw, &state.info_png.color};
+        uint32_t m;
+        for(m = 0; m < 2; m++) {
+            modes[m]->key_defined = 1;
+            if(f->depth == 16) {
+                modes[m]->key_r = (raw[0] << 8) | raw[1];
+                modes[m]->key_g = (raw[2] << 8) | raw[3];
+                modes[m]->key_b = (raw[4] << 8) | raw[5];
+            }
+            else if(f->depth == 8) {
+                modes[m]->key_r = raw[0];
+                modes[m]->key_g = raw[1];
+                modes[m]->key_b = raw[2];
+            }
+            else {
+                modes[m]->key_r = raw[0] >> (8 - f->depth);
+            }
+            if(f->type == LCT_GREY) {
+                modes[m]->key_g = modes[m]->key_r;
+                modes[m]->key_b = modes[m]->key_r;
+            }
+        }
+    }
+
+    uint8_t * png = NULL;
+    unsigned error = lodepng_encode(&png, size, raw, GEN_W, GEN_H, &state);
+    TEST_ASSERT_EQUAL_MESSAGE(0, error, lodepng_error_text(error));
+    lodepng_state_cleanup(&state);
+    lv_mem_free(raw);
+    return png;
+}
+
+/*Decode the whole image at once*/
+static uint8_t * decode_full(const void * src)
+{
+    lv_png_set_stream_min_px(0);
+
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, src, lv_color_black(), 0) != LV_RES_OK) return NULL;
+    TEST_ASSERT_NOT_NULL(dsc.img_data);
+
+    /*Keep only the pixels*/
+    uint32_t size = dsc.header.w * dsc.header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * px = lv_mem_alloc(size);
+    lv_memcpy(px, dsc.img_data, size);
+    lv_img_decoder_close(&dsc);
+    return px;
+}
+
+/*Decode the image line by line and compare it with `ref` if not NULL.
+ *Return the memory needed for it.*/
+static uint32_t decode_stream(const void * src, const uint8_t * ref)
+{
+    lv_png_set_stream_min_px(1);
+    uint32_t used = get_used();
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+
+    uint32_t line_size = dsc.header.w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * line = lv_mem_alloc(line_size);
+    lv_coord_t y;
+    for(y = 0; y < dsc.header.h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, dsc.header.w, line));
+        if(ref) TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + y * line_size, line, line_size);
+    }
+
+    uint32_t peak = get_peak_since_reset(used);
+
+    /*Reading a line above starts again from the beginning*/
+    lv_coord_t x = dsc.header.w / 3;
+    y = dsc.header.h / 2;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, x, y, dsc.header.w / 2, line));
+    if(ref) TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + y * line_size + x * LV_IMG_PX_SIZE_ALPHA_BYTE, line,
+                                             (dsc.header.w / 2) * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    lv_mem_free(line);
+    lv_img_decoder_close(&dsc);
+    return peak;
+}
+
+#endif
+
+void test_png_stream_formats(void)
+{
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+    uint32_t i;
+    for(i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        size_t size;
+        uint8_t * png = encode(&formats[i], 0, &size);
+        lv_img_dsc_t img_dsc = {
+            .header.cf = LV_IMG_CF_RAW_ALPHA,
+            .header.w = GEN_W,
+            .header.h = GEN_H,
+            .data_size = size,
+            .data = png,
+        };
+
+        uint8_t * ref = decode_full(&img_dsc);
+        TEST_ASSERT_NOT_NULL(ref);
+        decode_stream(&img_dsc, ref);
+
+        lv_mem_free(ref);
+        lv_mem_free(png);
+    }
+#endif
+}
+
+void test_png_stream_interlaced_is_decoded_at_once(void)
+{
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+    size_t size;
+    uint8_t * png = encode(&formats[5], 1, &size);
+    lv_img_dsc_t img_dsc = {
+        .header.cf = LV_IMG_CF_RAW_ALPHA,
+        .header.w = GEN_W,
+        .header.h = GEN_H,
+        .data_size = size,
+        .data = png,
+    };
+
+    lv_png_set_stream_min_px(1);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_NOT_NULL(dsc.img_data);
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(png);
+#endif
+}
+
+/*A chunk length which would make the position of the next chunk wrap around to the same chunk*/
+void test_png_stream_bad_chunk_len(void)
+{
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+    size_t size;
+    uint8_t * png = encode(&formats[5], 0, &size);
+    /*Insert a chunk after the signature and IHDR*/
+    static const uint8_t chunk[12] = {0xff, 0xff, 0xff, 0xf4, 'a', 'b', 'C', 'd'};
+    const uint32_t pos = 8 + 12 + 13;
+    uint8_t * bad = lv_mem_alloc(size + sizeof(chunk));
+    lv_memcpy(bad, png, pos);
+    lv_memcpy(bad + pos, chunk, sizeof(chunk));
+    lv_memcpy(bad + pos + sizeof(chunk), png + pos, size - pos);
+    lv_img_dsc_t img_dsc = {
+        .header.cf = LV_IMG_CF_RAW_ALPHA,
+        .header.w = GEN_W,
+        .header.h = GEN_H,
+        .data_size = size + sizeof(chunk),
+        .data = bad,
+    };
+
+    lv_png_set_stream_min_px(1);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_NOT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    lv_mem_free(bad);
+    lv_mem_free(png);
+#endif
+}
+
+/*Files in a file system, decoded line by line with the memory of a few lines*/
+void test_png_stream_file(void)
+{
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+    const char * wink = "A:../examples/libs/png/wink.png";
+    uint8_t * ref = decode_full(wink);
+    TEST_ASSERT_NOT_NULL(ref);
+    decode_stream(wink, ref);
+    lv_mem_free(ref);
+
+    /*The screenshots don't fit into the heap at once, but are decoded line by line with a few kB*/
+    uint32_t i;
+    for(i = 0; i < sizeof(ref_imgs) / sizeof(ref_imgs[0]); i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "A:ref_imgs/%s", ref_imgs[i]);
+        uint32_t peak = decode_stream(path, NULL);
+#if LV_MEM_CUSTOM == 0
+        TEST_ASSERT_LESS_THAN(48 * 1024, peak);
+#else
+        LV_UNUSED(peak);
+#endif
+    }
+#endif
+}
+
+/*Draw the streamed screenshots and compare them with themselves*/
+void test_png_stream_draw(void)
+{
+#if LV_USE_PNG && LV_COLOR_DEPTH == 32
+    lv_png_set_stream_min_px(1);
+    lv_obj_set_style_pad_all(lv_scr_act(), 0, 0);
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+
+    uint32_t i;
+    for(i = 0; i < sizeof(ref_imgs) / sizeof(ref_imgs[0]); i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "A:ref_imgs/%s", ref_imgs[i]);
+        lv_img_set_src(img, path);
+        lv_refr_now(NULL);
+
+        /*Large images might be opened in the background*/
+        lv_img_cache_stats_t stats;
+        lv_img_cache_get_stats(&stats);
+        while(stats.decoding_cnt) {
+            lv_tick_inc(1);
+            lv_timer_handler();
+            lv_img_cache_get_stats(&stats);
+        }
+
+        TEST_ASSERT_EQUAL_SCREENSHOT(ref_imgs[i]);
+    }
+#endif
+}
+
+#endif
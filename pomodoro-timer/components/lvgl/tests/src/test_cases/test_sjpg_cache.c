@@ -0,0 +1,209 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG && LV_COLOR_DEPTH == 32
+
+#define SMALL_PATH      "A:../examples/libs/sjpg/small_image.sjpg"
+#define HEADER_SIZE     22
+#define TALL_REPEAT     8       /*small_image.sjpg is 320x240, make it 320x1920*/
+#define SCROLL_STEP     40
+
+static uint8_t * tall_data;
+static lv_img_dsc_t tall_dsc;
+
+static uint8_t * load_file(const char * path, uint32_t * size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    uint8_t * data = lv_mem_alloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    uint32_t rn;
+    lv_fs_read(&f, data, *size, &rn);
+    lv_fs_close(&f);
+    TEST_ASSERT_EQUAL(*size, rn);
+    return data;
+}
+
+/*The frames of a split JPG are independent JPGs, so a tall image can be made by repeating them*/
+static void make_tall_sjpg(void)
+{
+    uint32_t size;
+    uint8_t * small = load_file(SMALL_PATH, &size);
+    uint32_t x_res = small[14] | (small[15] << 8);
+    uint32_t y_res = small[16] | (small[17] << 8);
+    uint32_t frame_cnt = small[18] | (small[19] << 8);
+    uint32_t info_size = frame_cnt * 2;
+    uint32_t frames_size = size - HEADER_SIZE - info_size;
+
+    uint32_t tall_size = HEADER_SIZE + (info_size + frames_size) * TALL_REPEAT;
+    tall_data = lv_mem_alloc(tall_size);
+    TEST_ASSERT_NOT_NULL(tall_data);
+
+    lv_memcpy(tall_data, small, HEADER_SIZE);
+    tall_data[16] = (uint8_t)(y_res * TALL_REPEAT);
+    tall_data[17] = (uint8_t)((y_res * TALL_REPEAT) >> 8);
+    tall_data[18] = (uint8_t)(frame_cnt * TALL_REPEAT);
+    tall_data[19] = (uint8_t)((frame_cnt * TALL_REPEAT) >> 8);
+
+    uint32_t i;
+    for(i = 0; i < TALL_REPEAT; i++) {
+        lv_memcpy(tall_data + HEADER_SIZE + i * info_size, small + HEADER_SIZE, info_size);
+        lv_memcpy(tall_data + HEADER_SIZE + info_size * TALL_REPEAT + i * frames_size,
+                  small + HEADER_SIZE + info_size, frames_size);
+    }
+    lv_mem_free(small);
+
+    tall_dsc.header.cf = LV_IMG_CF_RAW;
+    tall_dsc.header.w = x_res;
+    tall_dsc.header.h = y_res * TALL_REPEAT;
+    tall_dsc.data_size = tall_size;
+    tall_dsc.data = tall_data;
+}
+
+static void wait_decoding(void)
+{
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    while(stats.decoding_cnt) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+        lv_img_cache_get_stats(&stats);
+    }
+}
+
+static uint32_t get_frame_size(const void * src)
+{
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(src, &header));
+    return header.w * 16 * 3;
+}
+
+/*Read all the lines of the small image with only one frame kept. The tall image repeats it.*/
+static uint8_t * decode_ref(void)
+{
+    lv_split_jpeg_set_cache_size(0);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SMALL_PATH, lv_color_black(), 0));
+    uint32_t line_size = dsc.header.w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * ref = lv_mem_alloc(line_size * dsc.header.h);
+    TEST_ASSERT_NOT_NULL(ref);
+    lv_coord_t y;
+    for(y = 0; y < dsc.header.h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, dsc.header.w, ref + y * line_size));
+    }
+    lv_img_decoder_close(&dsc);
+    return ref;
+}
+
+static void check_lines(const void * src, uint32_t cache_frames)
+{
+    uint8_t * ref = decode_ref();
+    uint32_t ref_h = tall_dsc.header.h / TALL_REPEAT;
+
+    lv_split_jpeg_set_cache_size(get_frame_size(src) * cache_frames);
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    uint32_t line_size = dsc.header.w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * line = lv_mem_alloc(line_size);
+    TEST_ASSERT_NOT_NULL(line);
+
+    /*Down, up and in jumps to read from the cache, replace frames and use the prefetched ones*/
+    lv_coord_t y;
+    uint32_t pass;
+    for(pass = 0; pass < 3; pass++) {
+        for(y = 0; y < dsc.header.h; y++) {
+            lv_coord_t line_y = y;
+            if(pass == 1) line_y = dsc.header.h - 1 - y;
+            else if(pass == 2) line_y = (y * 37) % dsc.header.h;
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, line_y, dsc.header.w, line));
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + (line_y % ref_h) * line_size, line, line_size);
+        }
+    }
+
+    lv_mem_free(line);
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(ref);
+}
+
+/*Scroll the image down and up and return the number of decoded and prefetched frames*/
+static uint32_t scroll(uint32_t * prefetched)
+{
+    lv_split_jpeg_stats_t stats_start;
+    lv_split_jpeg_get_stats(&stats_start);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &tall_dsc);
+    lv_refr_now(NULL);
+    wait_decoding();
+
+    int32_t i;
+    int32_t steps = (tall_dsc.header.h - LV_VER_RES) / SCROLL_STEP;
+    for(i = 0; i < steps * 2; i++) {
+        lv_obj_scroll_by(lv_scr_act(), 0, i < steps ? -SCROLL_STEP : SCROLL_STEP, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+
+    lv_obj_del(img);
+    lv_img_cache_invalidate_src(&tall_dsc);
+
+    lv_split_jpeg_stats_t stats_end;
+    lv_split_jpeg_get_stats(&stats_end);
+    *prefetched = stats_end.prefetched_cnt - stats_start.prefetched_cnt;
+    return stats_end.decoded_cnt - stats_start.decoded_cnt;
+}
+
+#endif
+
+void setUp(void)
+{
+#if LV_USE_SJPG && LV_COLOR_DEPTH == 32
+    make_tall_sjpg();
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_USE_SJPG && LV_COLOR_DEPTH == 32
+    wait_decoding();
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_split_jpeg_set_cache_size(LV_SJPG_CACHE_SIZE);
+    lv_mem_free(tall_data);
+#endif
+}
+
+void test_sjpg_cache_lines(void)
+{
+#if LV_USE_SJPG && LV_COLOR_DEPTH == 32
+    check_lines(&tall_dsc, 1);
+    check_lines(&tall_dsc, 2);
+    check_lines(&tall_dsc, 10);
+    check_lines(SMALL_PATH, 4);
+#endif
+}
+
+void test_sjpg_cache_scroll(void)
+{
+#if LV_USE_SJPG && LV_COLOR_DEPTH == 32
+    uint32_t prefetched;
+    lv_split_jpeg_set_cache_size(0);
+    uint32_t decoded_no_cache = scroll(&prefetched);
+
+    /*The visible frames and a few more*/
+    lv_split_jpeg_set_cache_size(get_frame_size(&tall_dsc) * (LV_VER_RES / 16 + 4));
+    uint32_t decoded_cache = scroll(&prefetched);
+
+    /*Only the newly visible frames are decoded*/
+    TEST_ASSERT_LESS_THAN(decoded_no_cache / 4, decoded_cache + prefetched);
+#if _LV_SJPG_PREFETCH
+    TEST_ASSERT_GREATER_THAN(0, prefetched);
+#endif
+#endif
+}
+
+#endif
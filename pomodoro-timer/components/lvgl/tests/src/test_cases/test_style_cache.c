@@ -0,0 +1,137 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+
+#define DEMO_FRAMES     20
+
+static lv_style_t style;
+static lv_style_t style_pr;
+
+void setUp(void)
+{
+    lv_style_init(&style);
+    lv_style_init(&style_pr);
+#if LV_STYLE_CACHE_SIZE
+    lv_obj_style_reset_cache_stats();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style);
+    lv_style_reset(&style_pr);
+}
+
+void test_style_cache_hit(void)
+{
+#if LV_STYLE_CACHE_SIZE
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x112233), 0);
+
+    lv_obj_style_reset_cache_stats();
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    lv_obj_style_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+#endif
+}
+
+void test_style_cache_follows_changes(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Adding a style*/
+    lv_style_set_border_width(&style, 3);
+    lv_obj_add_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Changing a shared style without reporting it*/
+    lv_style_set_border_width(&style, 4);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Changing the state*/
+    lv_style_set_border_width(&style_pr, 5);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Local styles and other parts*/
+    lv_obj_set_style_border_width(obj, 6, 0);
+    TEST_ASSERT_EQUAL(6, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_SCROLLBAR));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BORDER_WIDTH, 0);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Removing the style*/
+    lv_obj_remove_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_keeps_other_objects(void)
+{
+#if LV_STYLE_CACHE_SIZE
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_t * obj1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+    lv_style_set_border_width(&style, 3);
+    lv_obj_add_style(obj1, &style, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj1, LV_PART_MAIN));
+    lv_obj_get_style_border_width(obj2, LV_PART_MAIN);
+
+    /*Changing the local style of the other object*/
+    lv_obj_style_reset_cache_stats();
+    lv_obj_set_style_border_width(obj2, 5, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj1, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_border_width(obj2, LV_PART_MAIN));
+    lv_obj_style_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+
+    /*Changing a style used only by the first object*/
+    lv_obj_style_reset_cache_stats();
+    lv_style_set_border_width(&style, 4);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj1, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_border_width(obj2, LV_PART_MAIN));
+    lv_obj_style_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+
+    /*A new object at the place of a deleted one*/
+    lv_obj_del(obj2);
+    obj2 = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj2);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj2, LV_PART_MAIN));
+#endif
+}
+
+void test_style_cache_demo_widgets(void)
+{
+#if LV_STYLE_CACHE_SIZE && LV_USE_DEMO_WIDGETS
+    lv_obj_style_cache_stats_t stats;
+    lv_demo_widgets();
+    lv_refr_now(NULL);
+
+    lv_obj_style_reset_cache_stats();
+    uint32_t i;
+    for(i = 0; i < DEMO_FRAMES; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    lv_obj_style_get_cache_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats.misses, stats.hits);
+#endif
+}
+
+#endif
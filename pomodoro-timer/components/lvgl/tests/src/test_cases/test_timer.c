@@ -0,0 +1,191 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define MANY_TIMERS     5000
+#define MANY_MS         2000
+
+static uint32_t call_log[16];
+static uint32_t call_cnt;
+static uint32_t wakeup_cnt;
+static lv_timer_t * many_timers[MANY_TIMERS];
+
+static void log_cb(lv_timer_t * timer)
+{
+    if(call_cnt < sizeof(call_log) / sizeof(call_log[0])) call_log[call_cnt] = (uint32_t)(lv_uintptr_t)timer->user_data;
+    call_cnt++;
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    log_cb(timer);
+    lv_timer_del(timer);
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    log_cb(timer);
+    lv_timer_set_repeat_count(lv_timer_create(log_cb, 0, (void *)100), 1);
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    (*(uint32_t *)timer->user_data)++;
+}
+
+static void wakeup_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    wakeup_cnt++;
+}
+
+static lv_timer_t * find_timer(lv_timer_cb_t cb)
+{
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer && timer->timer_cb != cb) timer = lv_timer_get_next(timer);
+    return timer;
+}
+
+/*Move the time forward and run the timers*/
+static uint32_t step(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    return lv_timer_handler();
+}
+
+void setUp(void)
+{
+    /*Run the timers of the display and the input devices to know their deadlines*/
+    step(0);
+    call_cnt = 0;
+    wakeup_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_timer_set_wakeup_cb(NULL, NULL);
+}
+
+void test_timer_runs_in_order_of_deadlines(void)
+{
+    lv_timer_t * t3 = lv_timer_create(log_cb, 3000, (void *)3);
+    lv_timer_t * t1 = lv_timer_create(log_cb, 1000, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(log_cb, 2000, (void *)2);
+
+    step(1000);
+    step(1000);
+    step(1000);
+    /*On equal deadlines the timers which have not run yet go first*/
+    TEST_ASSERT_EQUAL(5, call_cnt);
+    TEST_ASSERT_EQUAL(1, call_log[0]);
+    TEST_ASSERT_EQUAL(2, call_log[1]);
+    TEST_ASSERT_EQUAL(1, call_log[2]);
+    TEST_ASSERT_EQUAL(3, call_log[3]);
+    TEST_ASSERT_EQUAL(1, call_log[4]);
+
+    /*Run only once per call even if late*/
+    call_cnt = 0;
+    step(10000);
+    TEST_ASSERT_EQUAL(3, call_cnt);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    lv_timer_del(t3);
+}
+
+void test_timer_pause_ready_period_and_repeat(void)
+{
+    lv_timer_t * t = lv_timer_create(log_cb, 1000, (void *)1);
+
+    lv_timer_pause(t);
+    step(2000);
+    TEST_ASSERT_EQUAL(0, call_cnt);
+
+    lv_timer_resume(t);
+    lv_timer_ready(t);
+    step(0);
+    TEST_ASSERT_EQUAL(1, call_cnt);
+
+    lv_timer_set_period(t, 5000);
+    step(1000);
+    TEST_ASSERT_EQUAL(1, call_cnt);
+    step(4000);
+    TEST_ASSERT_EQUAL(2, call_cnt);
+
+    lv_timer_set_repeat_count(t, 2);
+    step(5000);
+    step(5000);
+    step(5000);
+    TEST_ASSERT_EQUAL(4, call_cnt);
+    TEST_ASSERT_NULL(find_timer(log_cb));
+}
+
+void test_timer_created_and_deleted_in_callbacks(void)
+{
+    lv_timer_create(del_self_cb, 100, (void *)1);
+    lv_timer_create(create_cb, 100, (void *)2);
+    lv_timer_t * t = lv_timer_create(log_cb, 0, (void *)3);
+
+    /*The 0 period timer runs once per call, the one created in the callback still runs in the same call*/
+    step(100);
+    TEST_ASSERT_EQUAL(4, call_cnt);
+    step(0);
+    TEST_ASSERT_EQUAL(5, call_cnt);
+    TEST_ASSERT_EQUAL(3, call_log[4]);
+
+    TEST_ASSERT_NULL(find_timer(del_self_cb));
+    lv_timer_del(t);
+    lv_timer_del(find_timer(create_cb));
+    TEST_ASSERT_NULL(find_timer(log_cb));
+}
+
+void test_timer_time_till_next_and_wakeup(void)
+{
+    lv_timer_t * t = lv_timer_create(log_cb, 1000, (void *)1);
+    uint32_t sleep_ms = step(0);
+    TEST_ASSERT_LESS_OR_EQUAL(1000, sleep_ms);
+    TEST_ASSERT_EQUAL(sleep_ms, lv_timer_get_time_till_next());
+
+    lv_timer_set_wakeup_cb(wakeup_cb, NULL);
+    step(0);
+
+    /*Later deadlines don't need to wake up the sleeping task*/
+    lv_timer_t * t2 = lv_timer_create(log_cb, 60000, (void *)2);
+    TEST_ASSERT_EQUAL(0, wakeup_cnt);
+
+    /*Earlier ones do, but only once*/
+    lv_timer_ready(t2);
+    TEST_ASSERT_EQUAL(1, wakeup_cnt);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+    lv_timer_ready(t);
+    TEST_ASSERT_EQUAL(1, wakeup_cnt);
+
+    step(0);
+    TEST_ASSERT_EQUAL(2, call_cnt);
+
+    lv_timer_del(t);
+    lv_timer_del(t2);
+}
+
+void test_timer_many_timers(void)
+{
+    uint32_t calls = 0;
+    uint32_t i;
+    for(i = 0; i < MANY_TIMERS; i++) {
+        many_timers[i] = lv_timer_create(count_cb, 100 + (i * 7919) % 10000, &calls);
+    }
+
+    for(i = 0; i < MANY_MS; i++) {
+        step(1);
+    }
+
+    uint32_t expected = 0;
+    for(i = 0; i < MANY_TIMERS; i++) {
+        expected += MANY_MS / many_timers[i]->period;
+        lv_timer_del(many_timers[i]);
+    }
+    TEST_ASSERT_EQUAL(expected, calls);
+}
+
+#endif
@@ -0,0 +1,62 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * label;
+#if LV_USE_TXT_ATLAS && LV_FONT_MONTSERRAT_48
+static lv_font_t * atlas;
+#endif
+
+void setUp(void)
+{
+#if LV_USE_TXT_ATLAS && LV_FONT_MONTSERRAT_48
+    atlas = lv_txt_atlas_create(&lv_font_montserrat_48, "0123456789:");
+#endif
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_pos(label, 13, 17);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_TXT_ATLAS && LV_FONT_MONTSERRAT_48
+    lv_txt_atlas_del(atlas);
+#endif
+}
+
+void test_txt_atlas_size(void)
+{
+#if LV_USE_TXT_ATLAS && LV_FONT_MONTSERRAT_48
+    TEST_ASSERT_NOT_NULL(atlas);
+    TEST_ASSERT_GREATER_THAN(0, lv_txt_atlas_get_size(atlas));
+    TEST_ASSERT_EQUAL(lv_font_montserrat_48.line_height, lv_font_get_line_height(atlas));
+    TEST_ASSERT_TRUE(lv_txt_atlas_is_atlas(atlas));
+    TEST_ASSERT_FALSE(lv_txt_atlas_is_atlas(&lv_font_montserrat_48));
+#endif
+}
+
+void test_txt_atlas_renders_like_the_source_font(void)
+{
+#if LV_USE_TXT_ATLAS && LV_FONT_MONTSERRAT_48
+    static lv_color_t ref_fb[800 * 480];
+    const char * txt = "12:34 Clock";  /*Letters out of the atlas come from the fallback font*/
+
+    lv_label_set_text(label, txt);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_obj_invalidate(lv_scr_act());    /*Flush the whole screen to `test_fb`*/
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_coord_t ref_w = lv_obj_get_width(label);
+
+    lv_obj_set_style_text_font(label, atlas, 0);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(ref_w, lv_obj_get_width(label));
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#endif
+}
+
+#endif